@@ -114,6 +114,7 @@
 #include <App/MaterialPy.h>
 #include <Base/GeometryPyCXX.h>
 #include "Link.h"
+#include "RecomputeProfiler.h"
 
 // If you stumble here, run the target "BuildExtractRevision" on Windows systems
 // or the Python script "SubWCRev.py" on Linux based systems which builds
@@ -372,6 +373,7 @@ void Application::renameDocument(const char *OldName, const char *NewName)
         temp = pos->second;
         DocMap.erase(pos);
         DocMap[NewName] = temp;
+        ObjectIdentifier::invalidateResolveCache();
         signalRenameDocument(*temp);
     }
     else {
@@ -410,6 +412,7 @@ Document* Application::newDocument(const char * Name, const char * UserName, boo
     // add the document to the internal list
     DocMap[name] = newDoc.release(); // now owned by the Application
     _pActiveDoc = DocMap[name];
+    ObjectIdentifier::invalidateResolveCache();
 
 
     // connect the signals to the application for the new document
@@ -431,6 +434,8 @@ Document* Application::newDocument(const char * Name, const char * UserName, boo
     _pActiveDoc->signalAbortTransaction.connect(boost::bind(&App::Application::slotAbortTransaction, this, _1));
     _pActiveDoc->signalStartSave.connect(boost::bind(&App::Application::slotStartSaveDocument, this, _1, _2));
     _pActiveDoc->signalFinishSave.connect(boost::bind(&App::Application::slotFinishSaveDocument, this, _1, _2));
+    _pActiveDoc->signalFinishSaveStatus.connect(
+            boost::bind(&App::Application::slotFinishSaveDocumentStatus, this, _1, _2, _3, _4));
     _pActiveDoc->signalChangePropertyEditor.connect(
             boost::bind(&App::Application::slotChangePropertyEditor, this, _1, _2));
 
@@ -466,6 +471,7 @@ bool Application::closeDocument(const char* name)
         setActiveDocument((Document*)0);
     std::unique_ptr<Document> delDoc (pos->second);
     DocMap.erase( pos );
+    ObjectIdentifier::invalidateResolveCache();
 
     _objCount = -1;
 
@@ -1020,24 +1026,19 @@ void Application::RemoveParameterSet(const char* sName)
 
 Base::Reference<ParameterGrp>  Application::GetParameterGroupByPath(const char* sName)
 {
-    std::string cName = sName,cTemp;
-
-    std::string::size_type pos = cName.find(':');
+    const char *pos = strchr(sName,':');
 
     // is there a path separator ?
-    if (pos == std::string::npos) {
+    if (!pos) {
         throw Base::ValueError("Application::GetParameterGroupByPath() no parameter set name specified");
     }
-    // assigning the parameter set name
-    cTemp.assign(cName,0,pos);
-    cName.erase(0,pos+1);
 
     // test if name is valid
-    std::map<std::string,ParameterManager *>::iterator It = mpcPramManager.find(cTemp.c_str());
+    std::map<std::string,ParameterManager *>::iterator It = mpcPramManager.find(std::string(sName,pos-sName));
     if (It == mpcPramManager.end())
         throw Base::ValueError("Application::GetParameterGroupByPath() unknown parameter set name specified");
 
-    return It->second->GetGroup(cName.c_str());
+    return It->second->GetGroup(pos+1);
 }
 
 void Application::addImportType(const char* Type, const char* ModuleName)
@@ -1360,6 +1361,12 @@ void Application::slotFinishSaveDocument(const App::Document& doc, const std::st
     this->signalFinishSaveDocument(doc, filename);
 }
 
+void Application::slotFinishSaveDocumentStatus(const App::Document& doc,
+        const std::string& filename, bool success, const std::string& message)
+{
+    this->signalFinishSaveDocumentStatus(doc, filename, success, message);
+}
+
 void Application::slotChangePropertyEditor(const App::Document &doc, const App::Property &prop)
 {
     this->signalChangePropertyEditor(doc,prop);
@@ -1376,6 +1383,8 @@ char ** Application::_argv;
 
 void Application::destruct(void)
 {
+    RecomputeProfiler::instance().saveTrace();
+
     // saving system parameter
     Console().Log("Saving system parameter...\n");
     _pcSysParamMngr->SaveDocument();
@@ -2371,6 +2380,7 @@ void Application::ParseOptions(int ac, char ** av)
     ("module-path,M", value< vector<string> >()->composing(),"Additional module paths")
     ("python-path,P", value< vector<string> >()->composing(),"Additional python paths")
     ("single-instance", "Allow to run a single instance of the application")
+    ("recompute-trace", value<string>(), "Write the timing of all document recomputations to a file in Chrome trace event format")
     ;
 
 
@@ -2556,6 +2566,11 @@ void Application::ParseOptions(int ac, char ** av)
         mConfig["SaveFile"] = file;
     }
 
+    if (vm.count("recompute-trace")) {
+        mConfig["RecomputeTrace"] = vm["recompute-trace"].as<string>();
+        RecomputeProfiler::instance().setTraceFile(mConfig["RecomputeTrace"]);
+    }
+
     if (vm.count("hidden")) {
         mConfig["StartHidden"] = "1";
     }
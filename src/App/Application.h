@@ -193,6 +193,9 @@ public:
     boost::signals2::signal<void (const Document&, const std::string&)> signalStartSaveDocument;
     /// signal on saved Document
     boost::signals2::signal<void (const Document&, const std::string&)> signalFinishSaveDocument;
+    /// signal on finishing (including background) saving a document, with status and error message
+    boost::signals2::signal<void (const Document&, const std::string&,
+                                  bool, const std::string&)> signalFinishSaveDocumentStatus;
     /** Signal finishing save the document as a directory
      *
      * Available arguments are 1) this document, 2) path, 3) a vector of
@@ -428,6 +431,7 @@ protected:
     void slotAbortTransaction(const App::Document&);
     void slotStartSaveDocument(const App::Document&, const std::string&);
     void slotFinishSaveDocument(const App::Document&, const std::string&);
+    void slotFinishSaveDocumentStatus(const App::Document&, const std::string&, bool, const std::string&);
     void slotChangePropertyEditor(const App::Document&, const App::Property &);
     //@}
 
@@ -507,6 +511,8 @@ private:
 
     static PyObject *sCheckAbort(PyObject *self,PyObject *args);
 
+    static PyObject *sSetRecomputeProfiler(PyObject *self,PyObject *args);
+
     static PyMethodDef    Methods[]; 
 
     friend class ApplicationObserver;
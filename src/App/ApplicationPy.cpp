@@ -36,6 +36,7 @@
 #include "DocumentPy.h"
 #include "DocumentObserverPython.h"
 #include "DocumentObjectPy.h"
+#include "RecomputeProfiler.h"
 
 // FreeCAD Base header
 #include <Base/Interpreter.h>
@@ -181,6 +182,11 @@ PyMethodDef Application::Methods[] = {
      "There is an active sequencer during document restore and recomputation. User may\n"
      "abort the operation by pressing the ESC key. Once detected, this function will\n"
      "trigger a BaseExceptionFreeCADAbort exception."},
+    {"setRecomputeProfiler", (PyCFunction) Application::sSetRecomputeProfiler, METH_VARARGS,
+     "setRecomputeProfiler(enable=True) -> Bool -- enable or disable the recompute profiler.\n\n"
+     "Once enabled, the timing of the last recompute of each document can be queried\n"
+     "with Document.recomputeProfile(). Disabling it discards the collected timing.\n"
+     "Returns the previous state."},
     {NULL, NULL, 0, NULL}		/* Sentinel */
 };
 
@@ -937,3 +943,15 @@ PyObject *Application::sCheckAbort(PyObject * /*self*/, PyObject *args)
         Py_Return;
     }PY_CATCH
 }
+
+PyObject *Application::sSetRecomputeProfiler(PyObject * /*self*/, PyObject *args)
+{
+    PyObject *enable = Py_True;
+    if (!PyArg_ParseTuple(args, "|O", &enable))
+        return 0;
+
+    PY_TRY {
+        bool enabled = RecomputeProfiler::instance().setEnabled(PyObject_IsTrue(enable));
+        return Py::new_reference_to(Py::Boolean(enabled));
+    }PY_CATCH
+}
@@ -27,10 +27,11 @@
 # include <cstdlib>
 #endif
 
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
 #include <boost/algorithm/string/predicate.hpp>
-#include <boost/bimap.hpp>
-#include <boost/bimap/multiset_of.hpp>
-#include <boost/bimap/unordered_set_of.hpp>
 #include <Base/Writer.h>
 #include <Base/Reader.h>
 #include <Base/Exception.h>
@@ -42,12 +43,159 @@ FC_LOG_LEVEL_INIT("ComplexGeoData", true,true);
 using namespace Data;
 
 namespace Data {
-typedef boost::bimap<
-            boost::bimaps::set_of<std::string>,
-            boost::bimaps::multiset_of<std::string>,
-            boost::bimaps::with_info<std::vector<App::StringIDRef> > > ElementMapBase;
-class ElementMap: public ElementMapBase {};
-}
+
+/** Storage of the mapping between mapped names and element names
+ *
+ * Mapped names are usually long and share long common prefixes, which makes
+ * them expensive to compare. They are therefore kept in a hash table, and
+ * only sorted on demand for those few operations that require a stable order
+ * or a prefix search.
+ * Each element name (e.g. Face1) is stored only once, and refers to all its
+ * mapped names in the order of insertion.
+ *
+ * The map is shared among copies of ComplexGeoData, and is cloned before
+ * modification (copy on write).
+ */
+class ElementMap {
+public:
+    struct MappedInfo;
+    typedef std::pair<const std::string, MappedInfo> MappedEntry;
+    typedef std::map<std::string, std::vector<const MappedEntry*> > ElementIndex;
+    struct MappedInfo {
+        ElementIndex::iterator element;
+        std::vector<App::StringIDRef> sids;
+    };
+    struct EntryLess {
+        bool operator()(const MappedEntry *a, const MappedEntry *b) const {
+            return a->first < b->first;
+        }
+        bool operator()(const MappedEntry *a, const std::string &b) const {
+            return a->first < b;
+        }
+    };
+
+    ElementMap() {}
+
+    ElementMap(const ElementMap &other) {
+        mappedNames.reserve(other.mappedNames.size());
+        for(auto &v : other.elementNames) {
+            for(auto entry : v.second)
+                insert(entry->first, v.first, entry->second.sids);
+        }
+    }
+
+    ElementMap &operator=(const ElementMap &) = delete;
+
+    std::size_t size() const {
+        return mappedNames.size();
+    }
+
+    bool empty() const {
+        return mappedNames.empty();
+    }
+
+    const MappedEntry *find(const std::string &mapped) const {
+        auto it = mappedNames.find(mapped);
+        if(it == mappedNames.end())
+            return 0;
+        return &(*it);
+    }
+
+    const std::vector<const MappedEntry*> *findElement(const std::string &element) const {
+        auto it = elementNames.find(element);
+        if(it == elementNames.end())
+            return 0;
+        return &it->second;
+    }
+
+    static const std::string &elementName(const MappedEntry *entry) {
+        return entry->second.element->first;
+    }
+
+    /** Insert a new mapped name
+     * @return Return the existing entry and false if the mapped name
+     * already exists, or else the new entry and true.
+     */
+    std::pair<const MappedEntry*, bool> insert(const std::string &mapped,
+            const std::string &element, const std::vector<App::StringIDRef> &sids)
+    {
+        auto res = mappedNames.insert(std::make_pair(mapped, MappedInfo()));
+        if(!res.second)
+            return std::make_pair(&(*res.first), false);
+        auto &info = res.first->second;
+        info.element = elementNames.insert(
+                std::make_pair(element, std::vector<const MappedEntry*>())).first;
+        info.element->second.push_back(&(*res.first));
+        info.sids = sids;
+        sortedNames.clear();
+        return std::make_pair(&(*res.first), true);
+    }
+
+    void erase(const MappedEntry *entry) {
+        auto element = entry->second.element;
+        auto &entries = element->second;
+        entries.erase(std::find(entries.begin(), entries.end(), entry));
+        if(entries.empty())
+            elementNames.erase(element);
+        sortedNames.clear();
+        mappedNames.erase(entry->first);
+    }
+
+    void eraseElement(const std::string &element) {
+        auto it = elementNames.find(element);
+        if(it == elementNames.end())
+            return;
+        for(auto entry : it->second)
+            mappedNames.erase(entry->first);
+        elementNames.erase(it);
+        sortedNames.clear();
+    }
+
+    /// Return all entries sorted by their mapped names
+    std::vector<const MappedEntry*> sortedEntries() const {
+        std::vector<const MappedEntry*> entries;
+        entries.reserve(mappedNames.size());
+        for(auto &v : mappedNames)
+            entries.push_back(&v);
+        std::sort(entries.begin(), entries.end(), EntryLess());
+        return entries;
+    }
+
+    /** Return the entries with mapped names starting with the given prefix, in sorted order
+     *
+     * Prefix searches are usually repeated on a map that no longer changes,
+     * so the sorted entries are kept until the next modification.
+     */
+    std::vector<const MappedEntry*> findPrefix(const std::string &prefix) const {
+        std::vector<const MappedEntry*> entries;
+        // The map may be shared by threads reading it, see class description
+        std::lock_guard<std::mutex> lock(sortedMutex);
+        if(sortedNames.size() != mappedNames.size())
+            sortedNames = sortedEntries();
+        for(auto it = std::lower_bound(sortedNames.begin(), sortedNames.end(), prefix, EntryLess());
+                it != sortedNames.end(); ++it)
+        {
+            if((*it)->first.compare(0, prefix.size(), prefix) != 0)
+                break;
+            entries.push_back(*it);
+        }
+        return entries;
+    }
+
+    /// Return all element names in order, with their mapped names in insertion order
+    const ElementIndex &elements() const {
+        return elementNames;
+    }
+
+private:
+    std::unordered_map<std::string, MappedInfo> mappedNames;
+    ElementIndex elementNames;
+    // Sorted entries for prefix search, cleared on modification
+    mutable std::vector<const MappedEntry*> sortedNames;
+    mutable std::mutex sortedMutex;
+};
+
+} // namespace Data
 
 TYPESYSTEM_SOURCE_ABSTRACT(Data::Segment , Base::BaseClass);
 
@@ -251,6 +399,14 @@ const char *ComplexGeoData::findElementName(const char *subname) {
     return element;
 }
 
+ElementMap &ComplexGeoData::mutableElementMap() {
+    if(!_ElementMap)
+        _ElementMap = std::make_shared<ElementMap>();
+    else if(_ElementMap.use_count() > 1)
+        _ElementMap = std::make_shared<ElementMap>(*_ElementMap);
+    return *_ElementMap;
+}
+
 size_t ComplexGeoData::getElementMapSize() const {
     return _ElementMap?_ElementMap->size():0;
 }
@@ -268,11 +424,12 @@ const char *ComplexGeoData::getElementName(const char *name, int direction,
     }
 
     if(direction==1) {
-        auto it = _ElementMap->right.find(name);
-        if(it == _ElementMap->right.end())
+        auto entries = _ElementMap->findElement(name);
+        if(!entries)
             return name;
-        if(sid) sid->insert(sid->end(),it->info.begin(),it->info.end());
-        return it->second.c_str();
+        auto entry = entries->front();
+        if(sid) sid->insert(sid->end(),entry->second.sids.begin(),entry->second.sids.end());
+        return entry->first.c_str();
     }
     const char *txt = isMappedElement(name);
     if(!txt) {
@@ -287,25 +444,22 @@ const char *ComplexGeoData::getElementName(const char *name, int direction,
         _txt = std::string(txt,dot-txt);
         txt = _txt.c_str();
     }
-    auto it = _ElementMap->left.find(txt);
-    if(it == _ElementMap->left.end())
+    auto entry = _ElementMap->find(txt);
+    if(!entry)
         return name;
-    if(sid) sid->insert(sid->end(),it->info.begin(),it->info.end());
-    return it->second.c_str();
+    if(sid) sid->insert(sid->end(),entry->second.sids.begin(),entry->second.sids.end());
+    return ElementMap::elementName(entry).c_str();
 }
 
 std::vector<std::pair<std::string, std::vector<App::StringIDRef> > >
 ComplexGeoData::getElementMappedNames(const char *element, bool needUnmapped) const {
     std::vector<std::pair<std::string, std::vector<App::StringIDRef> > > names;
     if(_ElementMap) {
-        auto ret = _ElementMap->right.equal_range(element);
-        size_t count=0;
-        for(auto it=ret.first;it!=ret.second;++it)
-            ++count;
-        if(count) {
-            names.reserve(count);
-            for(auto it=ret.first;it!=ret.second;++it)
-                names.emplace_back(it->second,it->info);
+        auto entries = _ElementMap->findElement(element);
+        if(entries) {
+            names.reserve(entries->size());
+            for(auto entry : *entries)
+                names.emplace_back(entry->first,entry->second.sids);
             return names;
         }
     }
@@ -322,18 +476,16 @@ ComplexGeoData::getElementNamesWithPrefix(const char *prefix) const {
     const auto &p = elementMapPrefix();
     if(boost::starts_with(prefix,p))
         prefix += p.size();
-    for(auto it=_ElementMap->left.lower_bound(prefix);it!=_ElementMap->left.end();++it) {
-        if(boost::starts_with(it->first,prefix))
-            names.emplace_back(it->first,it->second);
-    }
+    for(auto entry : _ElementMap->findPrefix(prefix))
+        names.emplace_back(entry->first,ElementMap::elementName(entry));
     return names;
 }
 
 std::map<std::string, std::string> ComplexGeoData::getElementMap() const {
     std::map<std::string, std::string> ret;
     if(!_ElementMap) return ret;
-    for(auto &v : _ElementMap->left)
-        ret.emplace_hint(ret.cend(),v.first,v.second);
+    for(auto entry : _ElementMap->sortedEntries())
+        ret.emplace_hint(ret.cend(),entry->first,ElementMap::elementName(entry));
     return ret;
 }
 
@@ -354,18 +506,26 @@ void ComplexGeoData::copyElementMap(const ComplexGeoData &data, const char *post
     if(!Hasher)
         Hasher = data.Hasher;
 
-    for(const auto &v : data._ElementMap->left) {
-        auto name = v.first.c_str();
+    if(!postfix && Hasher==data.Hasher) {
+        // Nothing to change, just share the map. It will be cloned on
+        // modification.
+        _ElementMap = data._ElementMap;
+        return;
+    }
+
+    for(auto entry : data._ElementMap->sortedEntries()) {
+        auto name = entry->first.c_str();
+        auto element = ElementMap::elementName(entry).c_str();
         if(Hasher==data.Hasher || !data.Hasher) {
-            setElementName(v.second.c_str(), name, postfix, &v.info);
+            setElementName(element, name, postfix, &entry->second.sids);
             continue;
         }
         if(postfix)
-            setElementName(v.second.c_str(),name,postfix);
+            setElementName(element,name,postfix);
         else {
             // In case we have different hasher, but no additional postfix. 
             // Copy the element name as it is without hashing.
-            setElementName(v.second.c_str(),name,0,false,true);
+            setElementName(element,name,0,false,true);
         }
     }
 }
@@ -440,8 +600,8 @@ const char *ComplexGeoData::setElementName(const char *element, const char *name
     if(!element || !element[0])
         throw Base::ValueError("Invalid input");
     if(!name || !name[0])  {
-        if(_ElementMap)
-            _ElementMap->right.erase(element);
+        if(_ElementMap && _ElementMap->findElement(element))
+            mutableElementMap().eraseElement(element);
         return element;
     }
 
@@ -460,7 +620,7 @@ const char *ComplexGeoData::setElementName(const char *element, const char *name
     const char *mapped = isMappedElement(name);
     if(mapped)
         name = mapped;
-    if(!_ElementMap) _ElementMap = std::make_shared<ElementMap>();
+    auto &elementMap = mutableElementMap();
     std::string _name;
     if((!sid||sid->empty()) && Hasher && !nohash) {
         sid = &_sid;
@@ -476,19 +636,20 @@ const char *ComplexGeoData::setElementName(const char *element, const char *name
     std::ostringstream ss;
     std::string retry_name;
     while(1) {
-        auto ret = _ElementMap->left.insert(ElementMap::left_map::value_type(mapped,element,*sid));
-        if(ret.second || ret.first->second==element) {
+        auto ret = elementMap.insert(mapped,element,*sid);
+        if(ret.second || ElementMap::elementName(ret.first)==element) {
             FC_TRACE(element << " -> " << name);
             return ret.first->first.c_str();
         }
         if(overwrite) {
             overwrite = false;
-            _ElementMap->left.erase(ret.first);
+            elementMap.erase(ret.first);
             continue;
         }
         if(sid!=&_sid)
             _sid.insert(_sid.end(),sid->begin(),sid->end());
-        retry_name = renameDuplicateElement(retry++,element,ret.first->second.c_str(),name,_sid);
+        retry_name = renameDuplicateElement(retry++,element,
+                ElementMap::elementName(ret.first).c_str(),name,_sid);
         if(retry_name.empty())
             return ret.first->first.c_str();
         mapped = retry_name.c_str();
@@ -696,19 +857,20 @@ void ComplexGeoData::Save(Base::Writer &writer) const {
             << "\"/>\n";
         return;
     }
-    writer.Stream() << " count=\"" << _ElementMap->left.size() << "\">\n";
+    writer.Stream() << " count=\"" << _ElementMap->size() << "\">\n";
     if(writer.getFileVersion() > 1) {
         saveStream(writer.beginCharStream(false) << '\n');
         writer.endCharStream() << '\n';
     } else {
-        for(auto &v : _ElementMap->left) {
+        for(auto entry : _ElementMap->sortedEntries()) {
             // We are omitting indentation here to save some space in case of long list of elements
-            writer.Stream() << "<Element key=\"" << encodeAttribute(v.first) 
-                            << "\" value=\"" << encodeAttribute(v.second);
-            if(v.info.size()) {
-                writer.Stream() << "\" sid=\"" << v.info.front()->value();
-                for(size_t i=1;i<v.info.size();++i)
-                    writer.Stream() << '.' << v.info[i]->value();
+            writer.Stream() << "<Element key=\"" << encodeAttribute(entry->first) 
+                            << "\" value=\"" << encodeAttribute(ElementMap::elementName(entry));
+            const auto &sids = entry->second.sids;
+            if(sids.size()) {
+                writer.Stream() << "\" sid=\"" << sids.front()->value();
+                for(size_t i=1;i<sids.size();++i)
+                    writer.Stream() << '.' << sids[i]->value();
             }
             writer.Stream() << "\"/>\n";
         }
@@ -717,11 +879,14 @@ void ComplexGeoData::Save(Base::Writer &writer) const {
 }
 
 void ComplexGeoData::saveStream(std::ostream &s)  const {
-    for(auto &v : _ElementMap->right) {
-        s << v.first << '\t' << v.second << ' ' << v.info.size();
-        for(auto &sid : v.info)
-            s << ' ' << sid->value();
-        s << '\n';
+    for(auto &v : _ElementMap->elements()) {
+        for(auto entry : v.second) {
+            const auto &sids = entry->second.sids;
+            s << v.first << '\t' << entry->first << ' ' << sids.size();
+            for(auto &sid : sids)
+                s << ' ' << sid->value();
+            s << '\n';
+        }
     }
 }
 
@@ -815,7 +980,7 @@ void ComplexGeoData::restoreStream(std::istream &s, std::size_t count) {
 }
 
 void ComplexGeoData::SaveDocFile(Base::Writer &writer) const {
-    writer.Stream() << _ElementMap->left.size() << '\n';
+    writer.Stream() << _ElementMap->size() << '\n';
     saveStream(writer.Stream());
 }
 
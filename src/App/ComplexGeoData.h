@@ -328,6 +328,13 @@ protected:
     void saveStream(std::ostream &s) const;
     void restoreStream(std::istream &s, std::size_t count);
 
+    /** Return the element map for modification
+     *
+     * The element map may be shared with other geometry data (e.g. through
+     * copyElementMap()). In which case, it is cloned before return.
+     */
+    ElementMap &mutableElementMap();
+
     /// from local to outside
     inline Base::Vector3d transformToOutside(const Base::Vector3f& vec) const
     {
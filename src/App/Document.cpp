@@ -59,6 +59,11 @@ recompute path. Also enables more complicated dependencies beyond trees.
 # include <random>
 #endif
 
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <tuple>
+
 #include <boost/algorithm/string.hpp>
 
 #include <boost/graph/adjacency_list.hpp>
@@ -75,6 +80,7 @@ recompute path. Also enables more complicated dependencies beyond trees.
 #endif //USE_OLD_DAG
 
 #include <boost/bind.hpp>
+#include <boost/functional/hash.hpp>
 #include <boost/regex.hpp>
 #include <unordered_set>
 #include <unordered_map>
@@ -83,6 +89,9 @@ recompute path. Also enables more complicated dependencies beyond trees.
 #include <QMap>
 #include <QCoreApplication>
 #include <QCryptographicHash>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QEvent>
 
 #include "Document.h"
 #include "Application.h"
@@ -119,6 +128,7 @@ recompute path. Also enables more complicated dependencies beyond trees.
 #include "OriginGroupExtension.h"
 #include "Link.h"
 #include "GeoFeature.h"
+#include "RecomputeProfiler.h"
 
 FC_LOG_LEVEL_INIT("App", true, true, true);
 
@@ -157,6 +167,38 @@ typedef boost::bimap<StringHasherRef,int> HasherMap;
 static bool _IsRestoring;
 static bool _IsRelabeling;
 
+struct DocumentSaveTask;
+
+// Key of the sub-object cache
+struct SubObjectKey {
+    const DocumentObject *obj;
+    std::string subname;
+    bool transform;
+
+    bool operator==(const SubObjectKey &other) const {
+        return obj == other.obj
+            && transform == other.transform
+            && subname == other.subname;
+    }
+};
+
+struct SubObjectKeyHasher {
+    std::size_t operator()(const SubObjectKey &key) const {
+        std::size_t seed = std::hash<std::string>()(key.subname);
+        boost::hash_combine(seed, key.obj);
+        boost::hash_combine(seed, key.transform);
+        return seed;
+    }
+};
+
+// Resolved sub-object with its transformation relative to the parent object
+struct SubObjectCacheEntry {
+    DocumentObject *sobj;
+    Base::Matrix4D mat;
+    // offset of the trailing element name in the subname
+    std::size_t elementOffset;
+};
+
 // Pimpl class
 struct DocumentP
 {
@@ -175,8 +217,9 @@ struct DocumentP
     bool committing;
     std::bitset<32> StatusBits;
     int iUndoMode;
-    unsigned int UndoMemSize;
+    std::size_t UndoMemSize;
     unsigned int UndoMaxStackSize;
+    unsigned int UndoCompressThreshold;
     mutable HasherMap hashers;
 #ifdef USE_OLD_DAG
     DependencyList DepList;
@@ -189,6 +232,25 @@ struct DocumentP
     // restored files
     std::set<std::string> files;
 
+    // set while a batch of objects are being recomputed concurrently
+    bool concurrentRecompute;
+    std::mutex concurrentMutex;
+    // object change signals deferred during concurrent recompute. The boolean
+    // member indicates whether it is a before change signal
+    std::vector<std::tuple<const DocumentObject*, const Property*, bool> > pendingChangeSignals;
+
+    // cache of DocumentObject::getSubObjectCached()
+    std::unordered_map<SubObjectKey, SubObjectCacheEntry, SubObjectKeyHasher> subObjectCache;
+    unsigned long subObjectGeneration = 0;
+    std::mutex subObjectMutex;
+
+    // background saving in progress
+    std::shared_ptr<DocumentSaveTask> saveTask;
+    // id of the last background saving, to identify its notification
+    unsigned long saveTaskId = 0;
+    // receives the finishing notification of the background saving
+    std::unique_ptr<QObject> saveNotifier;
+
     DocumentP() {
         static std::random_device _RD;
         static std::mt19937 _RGEN(_RD());
@@ -203,12 +265,14 @@ struct DocumentP
         rollback = false;
         undoing = false;
         committing = false;
+        concurrentRecompute = false;
         StatusBits.set((size_t)Document::Closable, true);
         StatusBits.set((size_t)Document::KeepTrailingDigits, true);
         StatusBits.set((size_t)Document::Restoring, false);
         iUndoMode = 0;
         UndoMemSize = 0;
         UndoMaxStackSize = 20;
+        UndoCompressThreshold = 0;
     }
 
     void addRecomputeLog(const char *why, App::DocumentObject *obj) {
@@ -249,6 +313,8 @@ struct DocumentP
     topologicalSort(const std::vector<App::DocumentObject*>& objects) const;
     std::vector<App::DocumentObject*>
     static partialTopologicalSort(const std::vector<App::DocumentObject*>& objects);
+    bool getTouchedDependencyList(const Document *doc,
+            std::vector<App::DocumentObject*> &ret) const;
 };
 
 } // namespace App
@@ -953,6 +1019,7 @@ bool Document::undo(int id)
         mUndoTransactions.back()->apply(*this,false);
 
         // save the redo
+        d->activeUndoTransaction->compress(d->UndoCompressThreshold);
         mRedoMap[d->activeUndoTransaction->getID()] = d->activeUndoTransaction;
         mRedoTransactions.push_back(d->activeUndoTransaction);
         d->activeUndoTransaction = 0;
@@ -992,6 +1059,7 @@ bool Document::redo(int id)
         Base::FlagToggler<bool> flag(d->undoing);
         mRedoTransactions.back()->apply(*this,true);
 
+        d->activeUndoTransaction->compress(d->UndoCompressThreshold);
         mUndoMap[d->activeUndoTransaction->getID()] = d->activeUndoTransaction;
         mUndoTransactions.push_back(d->activeUndoTransaction);
         d->activeUndoTransaction = 0;
@@ -1185,10 +1253,15 @@ void Document::_commitTransaction(bool notify)
         Base::FlagToggler<> flag(d->committing);
         Application::TransactionSignaller signaller(false,true);
         int id = d->activeUndoTransaction->getID();
+        d->activeUndoTransaction->compress(d->UndoCompressThreshold);
         mUndoTransactions.push_back(d->activeUndoTransaction);
         d->activeUndoTransaction = 0;
-        // check the stack for the limits
-        if(mUndoTransactions.size() > d->UndoMaxStackSize){
+        // check the stack for the limits, and discard the oldest transactions
+        // first, but always keep the last one
+        while(mUndoTransactions.size() > d->UndoMaxStackSize
+                || (d->UndoMemSize && mUndoTransactions.size() > 1
+                    && getUndoMemSize() > d->UndoMemSize))
+        {
             mUndoMap.erase(mUndoTransactions.front()->getID());
             delete mUndoTransactions.front();
             mUndoTransactions.pop_front();
@@ -1356,16 +1429,36 @@ int Document::getUndoMode(void) const
     return d->iUndoMode;
 }
 
-unsigned int Document::getUndoMemSize (void) const
+std::size_t Document::getUndoMemSize (void) const
 {
-    return d->UndoMemSize;
+    std::size_t size = 0;
+    for(auto transaction : mUndoTransactions)
+        size += transaction->getTotalMemSize();
+    for(auto transaction : mRedoTransactions)
+        size += transaction->getTotalMemSize();
+    return size;
 }
 
-void Document::setUndoLimit(unsigned int UndoMemSize)
+void Document::setUndoLimit(std::size_t UndoMemSize)
 {
     d->UndoMemSize = UndoMemSize;
 }
 
+std::size_t Document::getUndoLimit(void) const
+{
+    return d->UndoMemSize;
+}
+
+void Document::setUndoCompressThreshold(unsigned int threshold)
+{
+    d->UndoCompressThreshold = threshold;
+}
+
+unsigned int Document::getUndoCompressThreshold(void) const
+{
+    return d->UndoCompressThreshold;
+}
+
 void Document::setMaxUndoStackSize(unsigned int UndoMaxStackSize)
 {
      d->UndoMaxStackSize = UndoMaxStackSize;
@@ -1389,6 +1482,7 @@ void Document::onChanged(const Property* prop)
 
     // the Name property is a label for display purposes
     if (prop == &Label) {
+        ObjectIdentifier::invalidateResolveCache();
         Base::FlagToggler<> flag(_IsRelabeling);
         App::GetApplication().signalRelabelDocument(*this);
     } else if(prop == &ShowHidden) {
@@ -1435,6 +1529,18 @@ void Document::onChanged(const Property* prop)
 
 void Document::onBeforeChangeProperty(const TransactionalObject *Who, const Property *What)
 {
+    if(d->concurrentRecompute) {
+        // We are called from a worker thread, see _recomputeFeatures(). Only
+        // record the change in the transaction already opened by the main
+        // thread, and defer the signal.
+        std::lock_guard<std::mutex> lock(d->concurrentMutex);
+        if(Who->isDerivedFrom(App::DocumentObject::getClassTypeId()))
+            d->pendingChangeSignals.emplace_back(
+                    static_cast<const App::DocumentObject*>(Who), What, true);
+        if(!d->rollback && !_IsRelabeling && d->activeUndoTransaction)
+            d->activeUndoTransaction->addObjectChange(Who,What);
+        return;
+    }
     if(Who->isDerivedFrom(App::DocumentObject::getClassTypeId()))
         signalBeforeChangeObject(*static_cast<const App::DocumentObject*>(Who), *What);
     if(!d->rollback && !_IsRelabeling) {
@@ -1446,9 +1552,19 @@ void Document::onBeforeChangeProperty(const TransactionalObject *Who, const Prop
 
 void Document::onChangedProperty(const DocumentObject *Who, const Property *What)
 {
+    if(d->concurrentRecompute) {
+        std::lock_guard<std::mutex> lock(d->concurrentMutex);
+        d->pendingChangeSignals.emplace_back(Who, What, false);
+        return;
+    }
     signalChangedObject(*Who, *What);
 }
 
+bool Document::_isRecomputingConcurrently() const
+{
+    return d->concurrentRecompute;
+}
+
 void Document::setTransactionMode(int iMode)
 {
     d->iTransactionMode = iMode;
@@ -1586,6 +1702,13 @@ Document::~Document()
     Console().Log("-App::Document: %s %p\n",getName(), this);
 #endif
 
+    // Make sure any background saving is done, without signaling as the
+    // document is being destroyed
+    try {
+        finishBackgroundSave(false);
+    } catch (...) {
+    }
+
     try {
         clearUndos();
     }
@@ -1596,6 +1719,8 @@ Document::~Document()
     Console().Log("-Delete Features of %s \n",getName());
 #endif
 
+    RecomputeProfiler::instance().removeDocument(this);
+
     d->objectArray.clear();
     for (auto it = d->objectMap.begin(); it != d->objectMap.end(); ++it) {
         it->second->setStatus(ObjectStatus::Destroy, true);
@@ -2343,6 +2468,11 @@ bool Document::saveCopy(const char* _file) const
 
 // Save the document under the name it has been opened
 bool Document::save (void)
+{
+    return save(false);
+}
+
+bool Document::save (bool background)
 {
     if(testStatus(Document::PartialDoc)) {
         FC_ERR("Partial loaded document '" << Label.getValue() << "' cannot be saved");
@@ -2369,14 +2499,230 @@ bool Document::save (void)
             LastModifiedBy.setValue(Author.c_str());
         }
 
-        return saveToFile(FileName.getValue());
+        return saveToFile(FileName.getValue(), background);
     }
 
     return false;
 }
 
-bool Document::saveToFile(const char* filename) const
+namespace App {
+
+// State of a background saving shared with the worker thread
+struct DocumentSaveTask
+{
+    unsigned long id = 0;
+    std::string filename;
+    Base::FileInfo tmp;
+    bool policy = false;
+    // Must be declared before the writer, because the writer holds a
+    // reference to the stream
+    Base::ofstream file;
+    std::unique_ptr<Base::ParallelZipWriter> writer;
+
+    // below members are protected by mutex
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool done = false;
+    bool success = false;
+    std::string message;
+};
+
+class DocumentSaveEvent : public QEvent
 {
+public:
+    DocumentSaveEvent(unsigned long id)
+        :QEvent(eventType()), id(id)
+    {}
+
+    static QEvent::Type eventType() {
+        static int _Type = QEvent::registerEventType();
+        return static_cast<QEvent::Type>(_Type);
+    }
+
+    // id of the finished task
+    unsigned long id;
+};
+
+// Receives the posted event in the main thread once the worker thread is
+// done with the saving. There is no need for moc as it only overrides
+// QObject::event().
+class DocumentSaveNotifier : public QObject
+{
+public:
+    DocumentSaveNotifier(const Document *doc)
+        :doc(doc)
+    {}
+
+    virtual bool event(QEvent *e) override {
+        if(e->type() != DocumentSaveEvent::eventType())
+            return QObject::event(e);
+        // The task may have already been finished by waitForBackgroundSave()
+        auto id = static_cast<DocumentSaveEvent*>(e)->id;
+        if(doc->d->saveTask && doc->d->saveTask->id == id)
+            doc->finishBackgroundSave();
+        return true;
+    }
+
+private:
+    const Document *doc;
+};
+
+class DocumentSaveRunnable : public QRunnable
+{
+public:
+    DocumentSaveRunnable(const std::shared_ptr<DocumentSaveTask> &task, QObject *notifier)
+        :task(task), notifier(notifier)
+    {}
+
+    virtual void run() {
+        bool success = false;
+        std::string message;
+        try {
+            task->writer->close();
+            if(task->writer->hasErrors())
+                message = "Failed to write all data to file " + task->tmp.filePath();
+            else
+                success = true;
+            task->writer.reset();
+            task->file.close();
+            if(success && task->file.fail()) {
+                success = false;
+                message = "Failed to close file " + task->tmp.filePath();
+            }
+        } catch (const Base::Exception &e) {
+            message = e.what();
+        } catch (const std::exception &e) {
+            message = e.what();
+        } catch (...) {
+            message = "Unknown exception";
+        }
+
+        std::lock_guard<std::mutex> lock(task->mutex);
+        task->done = true;
+        task->success = success;
+        task->message = std::move(message);
+        task->cond.notify_all();
+        // Post while holding the lock, so that the notifier cannot be
+        // destroyed before the event is posted.
+        QCoreApplication::postEvent(notifier, new DocumentSaveEvent(task->id));
+    }
+
+private:
+    std::shared_ptr<DocumentSaveTask> task;
+    QObject *notifier;
+};
+
+} // namespace App
+
+// Rename the newly saved temporary file to the actual file name, and handle
+// the backup files of the existing one
+static void replaceDocumentFile(Base::FileInfo &tmp, const char *filename)
+{
+    Base::FileInfo fi(filename);
+    if (fi.exists()) {
+        bool backup = App::GetApplication().GetParameterGroupByPath
+            ("User parameter:BaseApp/Preferences/Document")->GetBool("CreateBackupFiles",true);
+        int count_bak = App::GetApplication().GetParameterGroupByPath
+            ("User parameter:BaseApp/Preferences/Document")->GetInt("CountBackupFiles",1);
+        if (backup) {
+            int nSuff = 0;
+            std::string fn = fi.fileName();
+            Base::FileInfo di(fi.dirPath());
+            std::vector<Base::FileInfo> backup;
+            std::vector<Base::FileInfo> files = di.getDirectoryContent();
+            for (std::vector<Base::FileInfo>::iterator it = files.begin(); it != files.end(); ++it) {
+                std::string file = it->fileName();
+                if (file.substr(0,fn.length()) == fn) {
+                    // starts with the same file name
+                    std::string suf(file.substr(fn.length()));
+                    if (suf.size() > 0) {
+                        std::string::size_type nPos = suf.find_first_not_of("0123456789");
+                        if (nPos==std::string::npos) {
+                            // store all backup files
+                            backup.push_back(*it);
+                            nSuff = std::max<int>(nSuff, std::atol(suf.c_str()));
+                        }
+                    }
+                }
+            }
+
+            if (!backup.empty() && (int)backup.size() >= count_bak) {
+                // delete the oldest backup file we found
+                Base::FileInfo del = backup.front();
+                for (std::vector<Base::FileInfo>::iterator it = backup.begin(); it != backup.end(); ++it) {
+                    if (it->lastModified() < del.lastModified())
+                        del = *it;
+                }
+
+                del.deleteFile();
+                fn = del.filePath();
+            }
+            else {
+                // create a new backup file
+                std::stringstream str;
+                str << fi.filePath() << (nSuff + 1);
+                fn = str.str();
+            }
+
+            if (fi.renameFile(fn.c_str()) == false)
+                Base::Console().Warning("Cannot rename project file to backup file\n");
+        }
+        else if (fi.isDir()) {
+            fi.deleteDirectoryRecursive();
+        } else {
+            fi.deleteFile();
+        }
+    }
+    if (tmp.renameFile(filename) == false) {
+        Base::Console().Warning("Cannot rename file from '%s' to '%s'\n",
+                                tmp.filePath().c_str(), filename);
+    }
+}
+
+bool Document::isSavingInBackground() const
+{
+    return !!d->saveTask;
+}
+
+bool Document::waitForBackgroundSave() const
+{
+    return finishBackgroundSave();
+}
+
+bool Document::finishBackgroundSave(bool notify) const
+{
+    auto task = d->saveTask;
+    if(!task)
+        return true;
+    {
+        std::unique_lock<std::mutex> lock(task->mutex);
+        task->cond.wait(lock, [&task]{return task->done;});
+    }
+    d->saveTask.reset();
+
+    if(task->success) {
+        if(task->policy)
+            replaceDocumentFile(task->tmp, task->filename.c_str());
+    } else {
+        FC_ERR("Failed to save document '" << getName() << "' to "
+                << task->filename << ": " << task->message);
+        if(task->policy)
+            task->tmp.deleteFile();
+    }
+
+    if(notify) {
+        if(task->success)
+            signalFinishSave(*this, task->filename);
+        signalFinishSaveStatus(*this, task->filename, task->success, task->message);
+    }
+    return task->success;
+}
+
+bool Document::saveToFile(const char* filename, bool background) const
+{
+    // Only one saving at a time
+    waitForBackgroundSave();
+
     signalStartSave(*this, filename);
 
     auto hGrp = App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Document");
@@ -2386,11 +2732,26 @@ bool Document::saveToFile(const char* filename) const
     bool archive = !Base::FileInfo(filename).isDir();
     bool policy = archive?hGrp->GetBool("BackupPolicy",true):false;
 
+    // Background saving requires an event loop to report back in the main
+    // thread. Saving into a directory is done in place and is therefore not
+    // supported either.
+    if(background && (!archive || !QCoreApplication::instance()))
+        background = false;
+
     // make a tmp. file where to save the project data first and then rename to
     // the actual file name. This may be useful if overwriting an existing file
     // fails so that the data of the work up to now isn't lost.
+    // Always do so when saving in background, so that the existing file stays
+    // valid until the writing succeeds.
+    if(background)
+        policy = true;
     std::string uuid = Base::Uuid::createUuid();
     std::string fn = filename;
+
+    // Any lazily restored data still residing in the file must be read in
+    // before overwriting it.
+    Base::DeferredDocFile::restoreAll(filename);
+
     if (policy) {
         fn += ".";
         fn += uuid;
@@ -2399,18 +2760,58 @@ bool Document::saveToFile(const char* filename) const
 
     std::vector<std::string> fileNames;
 
+    // Removes the temporary file of background saving if anything goes
+    // wrong before handing it over to the worker thread
+    struct SaveTaskGuard {
+        std::shared_ptr<DocumentSaveTask> task;
+        ~SaveTaskGuard() {
+            if(task) {
+                task->writer.reset();
+                task->file.close();
+                task->tmp.deleteFile();
+            }
+        }
+    };
+
+    std::shared_ptr<DocumentSaveTask> task;
+    SaveTaskGuard taskGuard;
+    if(background) {
+        task = std::make_shared<DocumentSaveTask>();
+        task->id = ++d->saveTaskId;
+        task->filename = filename;
+        task->tmp = tmp;
+        task->policy = policy;
+        taskGuard.task = task;
+    }
+
     // open extra scope to close ZipWriter properly
     {
-        Base::ofstream file;
+        Base::ofstream _file;
+        Base::ofstream &file = task ? task->file : _file;
         std::unique_ptr<Base::Writer> _writer;
         if(archive) {
             file.open(tmp, std::ios::out | std::ios::binary);
             if (!file.is_open())
                 throw Base::FileException("Failed to open file", tmp);
-            auto zipwriter = new Base::ZipWriter(file);
-            _writer.reset(zipwriter);
-            zipwriter->setComment("FreeCAD Document");
-            zipwriter->setLevel(compression);
+            // The parallel writer is also used for storing without
+            // compression, because zipios always deflates.
+            bool parallel = hGrp->GetBool("ParallelSave", false);
+            if(task || parallel || compression == Z_NO_COMPRESSION) {
+                auto zipwriter = new Base::ParallelZipWriter(file,
+                        parallel ? hGrp->GetInt("SaveThreads", 0) : 1);
+                _writer.reset(zipwriter);
+                zipwriter->setComment("FreeCAD Document");
+                zipwriter->setLevel(compression);
+                // Only take a snapshot of the document here. Serialization
+                // of thread safe objects and compression are done on close().
+                if(task)
+                    zipwriter->setSnapshot(true);
+            } else {
+                auto zipwriter = new Base::ZipWriter(file);
+                _writer.reset(zipwriter);
+                zipwriter->setComment("FreeCAD Document");
+                zipwriter->setLevel(compression);
+            }
         } else {
             _writer.reset(new Base::FileWriter(tmp.filePath().c_str()));
         }
@@ -2420,6 +2821,11 @@ bool Document::saveToFile(const char* filename) const
             writer.setFileVersion(2);
             writer.setForceXML(ForceXML.getValue());
             writer.setSplitXML(SplitXML.getValue());
+        } else if(hGrp->GetBool("BinaryPropertyStream", false)) {
+            // Store the data of properties supporting it into a single
+            // binary file entry instead of XML or a file per property. Note
+            // that older versions cannot read such a document.
+            writer.setBinaryStream(true);
         }
 
         writer.putNextEntry("Document.xml");
@@ -2442,6 +2848,30 @@ bool Document::saveToFile(const char* filename) const
         // write additional files
         writer.writeFiles();
 
+        // must be the last one, as records may be added while writing the
+        // other files, e.g. GuiDocument.xml
+        writer.writeBinaryStream();
+
+        if(task) {
+            if (writer.hasErrors())
+                throw Base::FileException("Failed to write all data to file", tmp);
+
+            GetApplication().signalSaveDocument(*this);
+
+            task->writer.reset(static_cast<Base::ParallelZipWriter*>(_writer.release()));
+            if(!d->saveNotifier)
+                d->saveNotifier.reset(new DocumentSaveNotifier(this));
+            d->saveTask = task;
+            QThreadPool::globalInstance()->start(
+                    new DocumentSaveRunnable(task, d->saveNotifier.get()));
+            taskGuard.task.reset();
+            return true;
+        }
+
+        auto parallelWriter = dynamic_cast<Base::ParallelZipWriter*>(&writer);
+        if (parallelWriter)
+            parallelWriter->close();
+
         if (writer.hasErrors()) {
             throw Base::FileException("Failed to write all data to file", tmp);
         }
@@ -2454,68 +2884,11 @@ bool Document::saveToFile(const char* filename) const
 
     if (policy) {
         // if saving the project data succeeded rename to the actual file name
-        Base::FileInfo fi(filename);
-        if (fi.exists()) {
-            bool backup = App::GetApplication().GetParameterGroupByPath
-                ("User parameter:BaseApp/Preferences/Document")->GetBool("CreateBackupFiles",true);
-            int count_bak = App::GetApplication().GetParameterGroupByPath
-                ("User parameter:BaseApp/Preferences/Document")->GetInt("CountBackupFiles",1);
-            if (backup) {
-                int nSuff = 0;
-                std::string fn = fi.fileName();
-                Base::FileInfo di(fi.dirPath());
-                std::vector<Base::FileInfo> backup;
-                std::vector<Base::FileInfo> files = di.getDirectoryContent();
-                for (std::vector<Base::FileInfo>::iterator it = files.begin(); it != files.end(); ++it) {
-                    std::string file = it->fileName();
-                    if (file.substr(0,fn.length()) == fn) {
-                        // starts with the same file name
-                        std::string suf(file.substr(fn.length()));
-                        if (suf.size() > 0) {
-                            std::string::size_type nPos = suf.find_first_not_of("0123456789");
-                            if (nPos==std::string::npos) {
-                                // store all backup files
-                                backup.push_back(*it);
-                                nSuff = std::max<int>(nSuff, std::atol(suf.c_str()));
-                            }
-                        }
-                    }
-                }
-
-                if (!backup.empty() && (int)backup.size() >= count_bak) {
-                    // delete the oldest backup file we found
-                    Base::FileInfo del = backup.front();
-                    for (std::vector<Base::FileInfo>::iterator it = backup.begin(); it != backup.end(); ++it) {
-                        if (it->lastModified() < del.lastModified())
-                            del = *it;
-                    }
-
-                    del.deleteFile();
-                    fn = del.filePath();
-                }
-                else {
-                    // create a new backup file
-                    std::stringstream str;
-                    str << fi.filePath() << (nSuff + 1);
-                    fn = str.str();
-                }
-
-                if (fi.renameFile(fn.c_str()) == false)
-                    Base::Console().Warning("Cannot rename project file to backup file\n");
-            }
-            else if (fi.isDir()) {
-                fi.deleteDirectoryRecursive();
-            } else {
-                fi.deleteFile();
-            }
-        }
-        if (tmp.renameFile(filename) == false) {
-            Base::Console().Warning("Cannot rename file from '%s' to '%s'\n",
-                                    fn.c_str(), filename);
-        }
+        replaceDocumentFile(tmp, filename);
     }
 
     signalFinishSave(*this, filename);
+    signalFinishSaveStatus(*this, filename, true, std::string());
 
     if(!archive) {
         std::vector<std::pair<std::string,int> > files;
@@ -2571,6 +2944,7 @@ void Document::restore (const char *filename,
             delete(v.second);
         }
         d->objectMap.clear();
+        ObjectIdentifier::invalidateResolveCache();
         d->objectIdMap.clear();
         GetApplication().signalNewDocument(*this,false);
     }
@@ -2582,6 +2956,7 @@ void Document::restore (const char *filename,
     d->clearRecomputeLog();
     d->objectArray.clear();
     d->objectMap.clear();
+    ObjectIdentifier::invalidateResolveCache();
     d->objectIdMap.clear();
     d->lastObjectId = 0;
 
@@ -2620,6 +2995,11 @@ void Document::restore (const char *filename,
     if (!reader.isValid())
         throw Base::FileException("Error reading project file", filename);
 
+    // Let heavy data (e.g. shapes, meshes) be read from the file on first access
+    auto hGrp = App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Document");
+    if(hGrp->GetBool("LazyRestore", false))
+        reader.setStatus(Base::XMLReader::LazyRestore, true);
+
     GetApplication().signalStartRestoreDocument(*this);
     setStatus(Document::Restoring, true);
 
@@ -3329,6 +3709,8 @@ int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool forc
     FC_TIME_INIT(t);
 
     Base::ObjectStatusLocker<Document::Status, Document> exe(Document::Recomputing, this);
+    RecomputeProfiler::instance().beginRecompute(this);
+    RecomputeProfiler::Scope profile(this, "Document", "recompute");
     signalBeforeRecompute(*this);
 
 #if 0
@@ -3350,7 +3732,16 @@ int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool forc
     }
     std::reverse(topoSortedObjects.begin(),topoSortedObjects.end());
 #else
-    auto topoSortedObjects = getDependencyList(objs.empty()?d->objectArray:objs,DepSort|options);
+    // The in and out lists of each object are updated incrementally by the
+    // link properties, so there is no need to build the dependency graph of
+    // the whole document just to find the few touched objects. Fall back to
+    // the full graph if there are external links, or dependency cycles, or if
+    // the caller asks to check for cycles, which may be outside the touched
+    // objects.
+    std::vector<App::DocumentObject*> topoSortedObjects;
+    if(!objs.empty() || (options & DepNoCycle) || PropertyXLink::hasXLink(this)
+            || !d->getTouchedDependencyList(this,topoSortedObjects))
+        topoSortedObjects = getDependencyList(objs.empty()?d->objectArray:objs,DepSort|options);
 #endif
     for(auto obj : topoSortedObjects)
         obj->setStatus(ObjectStatus::PendingRecompute,true);
@@ -3359,9 +3750,57 @@ int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool forc
             "User parameter:BaseApp/Preferences/Document");
     bool canAbort = hGrp->GetBool("CanAbortRecompute",true);
 
+    // Opt-in concurrent recompute. Objects are stable sorted by their level
+    // in the dependency graph, i.e. the length of the longest dependency path
+    // below them. Objects of the same level are independent of each other,
+    // and any consecutive thread safe ones can be recomputed concurrently.
+    std::vector<int> levels;
+    if(hGrp->GetBool("ParallelRecompute",false) && topoSortedObjects.size()>1) {
+        std::unordered_map<App::DocumentObject*,int> levelMap;
+        for(auto obj : topoSortedObjects) {
+            int &level = levelMap[obj];
+            for(auto dep : obj->getOutList()) {
+                auto it = levelMap.find(dep);
+                if(it!=levelMap.end() && it->first!=obj && it->second>=level)
+                    level = it->second+1;
+            }
+        }
+        std::stable_sort(topoSortedObjects.begin(),topoSortedObjects.end(),
+            [&levelMap](App::DocumentObject *a, App::DocumentObject *b) {
+                return levelMap[a] < levelMap[b];
+            });
+        levels.reserve(topoSortedObjects.size());
+        for(auto obj : topoSortedObjects)
+            levels.push_back(levelMap[obj]);
+    }
+
     std::set<App::DocumentObject *> filter;
     size_t idx = 0;
 
+    // Handles the result of a feature recompute. Returns true if the
+    // recompute shall be aborted.
+    auto onFeatureRecomputed = [&](App::DocumentObject *obj, bool doRecompute, int res) {
+        if(res) {
+            if(hasError)
+                *hasError = true;
+            if(res < 0)
+                return true;
+            // if something happened filter all object in its
+            // inListRecursive from the queue then proceed
+            obj->getInListEx(filter,true);
+            filter.insert(obj);
+            return false;
+        }
+        if(obj->isTouched() || doRecompute) {
+            signalRecomputedObject(*obj);
+            obj->purgeTouched();
+            // set all dependent object touched to force recompute
+            for (auto inObjIt : obj->getInList())
+                inObjIt->enforceRecompute();
+        }
+        return false;
+    };
+
     FC_TIME_INIT(t2);
 
     try {
@@ -3375,32 +3814,52 @@ int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool forc
                 auto obj = topoSortedObjects[idx];
                 if(!obj->getNameInDocument() || filter.find(obj)!=filter.end())
                     continue;
-                // ask the object if it should be recomputed
-                bool doRecompute = false;
-                if (obj->mustRecompute()) {
-                    doRecompute = true;
-                    ++objectCount;
-                    int res = _recomputeFeature(obj);
-                    if(res) {
-                        if(hasError)
-                            *hasError = true;
-                        if(res < 0) {
+
+                if(levels.size() && passes==0
+                        && obj->isRecomputeThreadSafe() && obj->mustRecompute())
+                {
+                    std::vector<App::DocumentObject*> batch;
+                    size_t end = idx;
+                    for(;end<topoSortedObjects.size() && levels[end]==levels[idx];++end) {
+                        auto o = topoSortedObjects[end];
+                        if(!o->getNameInDocument() || filter.find(o)!=filter.end()
+                                || !o->isRecomputeThreadSafe() || !o->mustRecompute())
+                            break;
+                        batch.push_back(o);
+                    }
+                    if(batch.size() > 1) {
+                        FC_LOG("Concurrent recompute of " << batch.size() << " objects");
+                        objectCount += (int)batch.size();
+                        auto results = _recomputeFeatures(batch);
+                        bool abort = false;
+                        for(size_t i=0;i<batch.size();++i) {
+                            if(onFeatureRecomputed(batch[i],true,results[i]))
+                                abort = true;
+                        }
+                        if(abort) {
                             passes = 2;
                             break;
                         }
-                        // if something happened filter all object in its
-                        // inListRecursive from the queue then proceed
-                        obj->getInListEx(filter,true);
-                        filter.insert(obj);
+                        if(seq) {
+                            for(size_t i=1;i<batch.size();++i)
+                                seq->next(true);
+                        }
+                        idx = end - 1;
                         continue;
                     }
                 }
-                if(obj->isTouched() || doRecompute) {
-                    signalRecomputedObject(*obj);
-                    obj->purgeTouched();
-                    // set all dependent object touched to force recompute
-                    for (auto inObjIt : obj->getInList())
-                        inObjIt->enforceRecompute();
+
+                // ask the object if it should be recomputed
+                bool doRecompute = false;
+                int res = 0;
+                if (obj->mustRecompute()) {
+                    doRecompute = true;
+                    ++objectCount;
+                    res = _recomputeFeature(obj);
+                }
+                if(onFeatureRecomputed(obj,doRecompute,res)) {
+                    passes = 2;
+                    break;
                 }
             }
             // check if all objects are recomputed but still thouched 
@@ -3610,6 +4069,66 @@ std::vector<App::DocumentObject*> DocumentP::topologicalSort(const std::vector<A
     return ret;
 }
 
+/*!
+  Collects all touched objects of the document, and the objects depending on
+  them by following their InList, and returns them in topological order, i.e.
+  dependencies first. It only visits the affected part of the dependency graph.
+  Returns false if a dependency cycle is found.
+ */
+bool DocumentP::getTouchedDependencyList(const Document *doc,
+        std::vector<App::DocumentObject*> &ret) const
+{
+    std::unordered_set<App::DocumentObject*> objs;
+    std::deque<App::DocumentObject*> pending;
+    for (auto obj : objectArray) {
+        if ((obj->isTouched() || obj->mustRecompute()) && objs.insert(obj).second)
+            pending.push_back(obj);
+    }
+    while (pending.size()) {
+        auto obj = pending.front();
+        pending.pop_front();
+        for (auto parent : obj->getInList()) {
+            if (parent->getDocument() == doc && objs.insert(parent).second)
+                pending.push_back(parent);
+        }
+    }
+
+    // number of unique dependencies of each object within the collected objects
+    std::unordered_map<App::DocumentObject*, int> countMap;
+    for (auto obj : objs) {
+        auto out = obj->getOutList();
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+        int &count = countMap[obj];
+        for (auto dep : out) {
+            if (dep == obj)
+                return false;
+            if (objs.count(dep))
+                ++count;
+        }
+    }
+
+    ret.clear();
+    ret.reserve(objs.size());
+    // start with the objects in creation order to get a stable result
+    for (auto obj : objectArray) {
+        auto it = countMap.find(obj);
+        if (it != countMap.end() && it->second == 0)
+            ret.push_back(obj);
+    }
+    for (size_t i=0; i<ret.size(); ++i) {
+        auto in = ret[i]->getInList();
+        std::sort(in.begin(), in.end());
+        in.erase(std::unique(in.begin(), in.end()), in.end());
+        for (auto parent : in) {
+            auto it = countMap.find(parent);
+            if (it != countMap.end() && --it->second == 0)
+                ret.push_back(parent);
+        }
+    }
+    return ret.size() == objs.size();
+}
+
 std::vector<App::DocumentObject*> Document::topologicalSort() const
 {
     return d->topologicalSort(d->objectArray);
@@ -3623,16 +4142,139 @@ const char * Document::getErrorDescription(const App::DocumentObject*Obj) const
 // call the recompute of the Feature and handle the exceptions and errors.
 int Document::_recomputeFeature(DocumentObject* Feat)
 {
-    FC_LOG("Recomputing " << Feat->getFullName());
-
-    DocumentObjectExecReturn  *returnCode = 0;
-    try {
-        returnCode = Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteNonOutput);
+    RecomputeProfiler::Scope profile(Feat, "DocumentObject", "recompute");
+    return _recomputeFeature(Feat, [Feat]() {
+        DocumentObjectExecReturn *returnCode =
+            Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteNonOutput);
         if (returnCode == DocumentObject::StdReturn) {
+            RecomputeProfiler::Scope profile(Feat, "DocumentObject", "execute");
             returnCode = Feat->recompute();
             if(returnCode == DocumentObject::StdReturn)
                 returnCode = Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteOutput);
         }
+        return returnCode;
+    });
+}
+
+namespace {
+class RecomputeRunnable : public QRunnable
+{
+public:
+    RecomputeRunnable(const std::function<void()> &func)
+        :func(func)
+    {}
+
+    virtual void run() {
+        func();
+    }
+
+private:
+    std::function<void()> func;
+};
+}
+
+std::vector<int> Document::_recomputeFeatures(const std::vector<DocumentObject*> &Feats)
+{
+    struct Result {
+        int res = 0;
+        DocumentObjectExecReturn *returnCode = DocumentObject::StdReturn;
+        std::exception_ptr error;
+    };
+    std::vector<Result> results(Feats.size());
+
+    // Expressions may call into Python, so evaluate the input bindings here
+    // in the main thread
+    for(size_t i=0;i<Feats.size();++i) {
+        auto Feat = Feats[i];
+        results[i].res = _recomputeFeature(Feat, [Feat]() {
+            return Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteNonOutput);
+        });
+    }
+
+    {
+        QThreadPool pool;
+        int threads = (int)GetApplication().GetParameterGroupByPath(
+                "User parameter:BaseApp/Preferences/Document")->GetInt("RecomputeThreads",0);
+        if(threads > 0)
+            pool.setMaxThreadCount(threads);
+
+        // Open any pending auto transaction here, because the worker threads
+        // can only record changes in an existing one.
+        if(!d->rollback && !_IsRelabeling)
+            _checkTransaction(0,0,__LINE__);
+
+        Base::FlagToggler<> flag(d->concurrentRecompute);
+        for(size_t i=0;i<Feats.size();++i) {
+            Result &result = results[i];
+            if(result.res)
+                continue;
+            auto Feat = Feats[i];
+            pool.start(new RecomputeRunnable([Feat,&result]() {
+                try {
+                    RecomputeProfiler::Scope profile(Feat, "DocumentObject", "recompute");
+                    RecomputeProfiler::Scope profileExec(Feat, "DocumentObject", "execute");
+                    result.returnCode = Feat->recompute();
+                } catch (...) {
+                    result.error = std::current_exception();
+                }
+            }));
+        }
+        pool.waitForDone();
+    }
+
+    // Replay the deferred object change signals in recompute order
+    std::unordered_map<const DocumentObject*,size_t> order;
+    for(size_t i=0;i<Feats.size();++i)
+        order[Feats[i]] = i;
+    auto pending = std::move(d->pendingChangeSignals);
+    d->pendingChangeSignals.clear();
+    std::stable_sort(pending.begin(),pending.end(),
+        [&order](const std::tuple<const DocumentObject*, const Property*, bool> &a,
+                 const std::tuple<const DocumentObject*, const Property*, bool> &b)
+        {
+            return order[std::get<0>(a)] < order[std::get<0>(b)];
+        });
+    for(auto &v : pending) {
+        auto obj = const_cast<DocumentObject*>(std::get<0>(v));
+        auto prop = std::get<1>(v);
+        if(std::get<2>(v)) {
+            signalBeforeChangeObject(*obj, *prop);
+            obj->signalBeforeChange(*obj, *prop);
+        } else {
+            obj->_onEarlyChanged(prop);
+            signalChangedObject(*obj, *prop);
+            obj->signalChanged(*obj, *prop);
+        }
+    }
+
+    std::vector<int> res;
+    res.reserve(Feats.size());
+    for(size_t i=0;i<Feats.size();++i) {
+        Result &result = results[i];
+        auto Feat = Feats[i];
+        if(!result.res) {
+            result.res = _recomputeFeature(Feat, [Feat,&result]() {
+                if(result.error)
+                    std::rethrow_exception(result.error);
+                DocumentObjectExecReturn *returnCode = result.returnCode;
+                if(returnCode == DocumentObject::StdReturn)
+                    returnCode = Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteOutput);
+                return returnCode;
+            });
+        }
+        res.push_back(result.res);
+    }
+    return res;
+}
+
+int Document::_recomputeFeature(DocumentObject* Feat,
+        const std::function<DocumentObjectExecReturn*()> &exec)
+{
+    FC_LOG("Recomputing " << Feat->getFullName());
+
+    DocumentObjectExecReturn  *returnCode = 0;
+    try {
+        returnCode = exec();
     }
     catch(Base::AbortException &e){
         e.ReportException();
@@ -3739,6 +4381,7 @@ DocumentObject * Document::addObject(const char* sType, const char* pObjectName,
 
     // insert in the name map
     d->objectMap[ObjectName] = pcObject;
+    ObjectIdentifier::invalidateResolveCache();
     // generate object id and add to id map;
     pcObject->_Id = ++d->lastObjectId;
     d->objectIdMap[pcObject->_Id] = pcObject;
@@ -3840,6 +4483,7 @@ std::vector<DocumentObject *> Document::addObjects(const char* sType, const std:
 
         // insert in the name map
         d->objectMap[ObjectName] = pcObject;
+        ObjectIdentifier::invalidateResolveCache();
         // generate object id and add to id map;
         pcObject->_Id = ++d->lastObjectId;
         d->objectIdMap[pcObject->_Id] = pcObject;
@@ -3904,6 +4548,7 @@ void Document::addObject(DocumentObject* pcObject, const char* pObjectName)
 
     // insert in the name map
     d->objectMap[ObjectName] = pcObject;
+    ObjectIdentifier::invalidateResolveCache();
     // generate object id and add to id map;
     if(!pcObject->_Id) pcObject->_Id = ++d->lastObjectId;
     d->objectIdMap[pcObject->_Id] = pcObject;
@@ -3934,6 +4579,7 @@ void Document::_addObject(DocumentObject* pcObject, const char* pObjectName)
 {
     std::string ObjectName = getUniqueObjectName(pObjectName);
     d->objectMap[ObjectName] = pcObject;
+    ObjectIdentifier::invalidateResolveCache();
     // generate object id and add to id map;
     if(!pcObject->_Id) pcObject->_Id = ++d->lastObjectId;
     d->objectIdMap[pcObject->_Id] = pcObject;
@@ -4071,6 +4717,7 @@ void Document::removeObject(const char* sName)
     pos->second->setStatus(ObjectStatus::Remove, false); // Unset the bit to be on the safe side
     d->objectIdMap.erase(pos->second->_Id);
     d->objectMap.erase(pos);
+    ObjectIdentifier::invalidateResolveCache();
 }
 
 /// Remove an object out of the document (internal)
@@ -4133,6 +4780,7 @@ void Document::_removeObject(DocumentObject* pcObject)
     pcObject->setStatus(ObjectStatus::Remove, false); // Unset the bit to be on the safe side
     d->objectIdMap.erase(pcObject->_Id);
     d->objectMap.erase(pos);
+    ObjectIdentifier::invalidateResolveCache();
 
     for (std::vector<DocumentObject*>::iterator it = d->objectArray.begin(); it != d->objectArray.end(); ++it) {
         if (*it == pcObject) {
@@ -4361,6 +5009,56 @@ DocumentObject * Document::getObjectByID(long id) const
     return 0;
 }
 
+DocumentObject *Document::_getSubObjectCached(const DocumentObject *obj,
+        const char *subname, Base::Matrix4D *mat, bool transform, const char **element) const
+{
+    // Limit the memory used by the cache, in case of excessive different subnames
+    static const std::size_t _MaxCacheSize = 100000;
+
+    if(!subname)
+        subname = "";
+    SubObjectKey key{obj, subname, transform};
+
+    unsigned long generation;
+    {
+        std::lock_guard<std::mutex> lock(d->subObjectMutex);
+        generation = DocumentObject::getSubObjectCacheGeneration();
+        if(d->subObjectGeneration != generation) {
+            d->subObjectCache.clear();
+            d->subObjectGeneration = generation;
+        } else {
+            auto it = d->subObjectCache.find(key);
+            if(it != d->subObjectCache.end()) {
+                if(mat)
+                    *mat *= it->second.mat;
+                if(element)
+                    *element = subname + it->second.elementOffset;
+                return it->second.sobj;
+            }
+        }
+    }
+
+    // Resolve without holding the lock, because getSubObject() may be
+    // customized (e.g. by Python feature) to call back into the cache.
+    SubObjectCacheEntry entry;
+    entry.sobj = obj->getSubObject(subname,0,&entry.mat,transform);
+    entry.elementOffset = Data::ComplexGeoData::findElementName(subname) - subname;
+    if(mat)
+        *mat *= entry.mat;
+    if(element)
+        *element = subname + entry.elementOffset;
+
+    std::lock_guard<std::mutex> lock(d->subObjectMutex);
+    // Only cache the result if nothing has changed during resolving
+    if(d->subObjectGeneration == generation
+            && generation == DocumentObject::getSubObjectCacheGeneration()) {
+        if(d->subObjectCache.size() >= _MaxCacheSize)
+            d->subObjectCache.clear();
+        d->subObjectCache.emplace(std::move(key), entry);
+    }
+    return entry.sobj;
+}
+
 
 // Note: This method is only used in Tree.cpp slotChangeObject(), see explanation there
 bool Document::isIn(const DocumentObject *pFeat) const
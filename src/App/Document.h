@@ -45,6 +45,7 @@ class QByteArray;
 
 namespace Base {
     class Writer;
+    class Matrix4D;
 }
 
 namespace App
@@ -179,6 +180,10 @@ public:
     boost::signals2::signal<void (const App::Document&, const std::string&)> signalStartSave;
     //signal finishing a save action to a file
     boost::signals2::signal<void (const App::Document&, const std::string&)> signalFinishSave;
+    //signal finishing a save action to a file with the status of the action. The
+    //last two arguments are whether the saving succeeded, and the error message
+    boost::signals2::signal<void (const App::Document&, const std::string&,
+                                  bool, const std::string&)> signalFinishSaveStatus;
     boost::signals2::signal<void (const App::Document&)> signalBeforeRecompute;
     boost::signals2::signal<void (const App::Document&, const std::vector<App::DocumentObject*>&)> signalRecomputed;
     boost::signals2::signal<void (const App::DocumentObject&)> signalRecomputedObject;
@@ -199,6 +204,22 @@ public:
     //void saveAs (const char* Name);
     /// Save the document to the file in Property Path
     bool save (void);
+    /** Save the document to the file in Property Path
+     *
+     * @param background: if true, the document is saved in a worker thread
+     * using a snapshot of its current state, and the function returns before
+     * the file is written. Call waitForBackgroundSave() to wait for finishing,
+     * or connect to signalFinishSaveStatus to be notified. Falls back to
+     * normal saving if the document is saved into a directory, or there is no
+     * Qt event loop to report the result.
+     */
+    bool save (bool background);
+    /// Check if there is a background saving in progress
+    bool isSavingInBackground() const;
+    /** Wait for any background saving to finish
+     * @return False if the saving failed
+     */
+    bool waitForBackgroundSave() const;
     bool saveAs(const char* file);
     bool saveCopy(const char* file) const;
     /// Restore the document from the file in Property Path
@@ -398,10 +419,22 @@ public:
     /// Check if a transaction is open and its list is empty.
     /// If no transaction is open true is returned.
     bool isTransactionEmpty() const;
-    /// Set the Undo limit in Byte!
-    void setUndoLimit(unsigned int UndoMemSize=0);
+    /** Set the Undo limit in Byte!
+     *
+     * When exceeded, the oldest transactions are discarded on commit. Zero
+     * means no limit.
+     */
+    void setUndoLimit(std::size_t UndoMemSize=0);
+    /// Returns the Undo limit in Byte
+    std::size_t getUndoLimit(void) const;
     /// Returns the actual memory consumption of the Undo redo stuff.
-    unsigned int getUndoMemSize (void) const;
+    std::size_t getUndoMemSize (void) const;
+    /** Set the size in Byte above which a changed property value is compressed in the
+     * undo/redo stack. Zero to disable compression.
+     */
+    void setUndoCompressThreshold(unsigned int threshold);
+    /// Returns the threshold of compressing property values in the undo/redo stack
+    unsigned int getUndoCompressThreshold(void) const;
     /// Set the Undo limit as stack size
     void setMaxUndoStackSize(unsigned int UndoMaxStackSize=20);
     /// Set the Undo limit as stack size
@@ -538,6 +571,7 @@ public:
     friend class DocumentObject;
     friend class Transaction;
     friend class TransactionDocumentObject;
+    friend class DocumentSaveNotifier;
 
     /// Destruction
     virtual ~Document();
@@ -556,7 +590,8 @@ protected:
     void breakDependency(DocumentObject* pcObject, bool clear);
     std::vector<App::DocumentObject*> readObjects(Base::XMLReader& reader);
     void writeObjects(const std::vector<App::DocumentObject*>&, Base::Writer &writer) const;
-    bool saveToFile(const char* filename) const;
+    bool saveToFile(const char* filename, bool background=false) const;
+    bool finishBackgroundSave(bool notify=true) const;
 
     void onBeforeChange(const Property* prop);
     void onChanged(const Property* prop);
@@ -567,6 +602,9 @@ protected:
     /// helper which Recompute only this feature
     /// @return True if the recompute process of the Document shall be stopped, False if it shall be continued.
     int _recomputeFeature(DocumentObject* Feat);
+    /// helper which recomputes a batch of independent and thread safe features concurrently
+    /// @return The result of _recomputeFeature() for each of the given feature
+    std::vector<int> _recomputeFeatures(const std::vector<DocumentObject*> &Feats);
     void _clearRedos();
 
     /// refresh the internal dependency graph
@@ -592,6 +630,15 @@ protected:
     void _abortTransaction();
 
 private:
+    int _recomputeFeature(DocumentObject* Feat,
+            const std::function<DocumentObjectExecReturn*()> &exec);
+    /// Check if objects are being recomputed concurrently by _recomputeFeatures()
+    bool _isRecomputingConcurrently() const;
+
+    /// Called by DocumentObject::getSubObjectCached() to look up the sub-object cache
+    DocumentObject *_getSubObjectCached(const DocumentObject *obj, const char *subname,
+            Base::Matrix4D *mat, bool transform, const char **element) const;
+
     // # Data Member of the document +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
     std::list<Transaction*> mUndoTransactions;
     std::map<int,Transaction*> mUndoMap;
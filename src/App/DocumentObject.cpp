@@ -42,11 +42,16 @@
 #include "GeoFeatureGroupExtension.h"
 #include <App/DocumentObjectPy.h>
 #include <boost/bind.hpp>
+#include <atomic>
 
 FC_LOG_LEVEL_INIT("App",true,true)
 
 using namespace App;
 
+// Generation counter of the sub-object cache. Bumped by
+// DocumentObject::invalidateSubObjectCache()
+static std::atomic<unsigned long> _SubObjectGeneration(1);
+
 
 PROPERTY_SOURCE(App::DocumentObject, App::TransactionalObject)
 
@@ -681,15 +686,14 @@ void DocumentObject::onBeforeChange(const Property* prop)
     if (_pDoc)
         onBeforeChangeProperty(_pDoc, prop);
 
-    signalBeforeChange(*this,*prop);
+    // The signal is deferred to the main thread by the document when
+    // recomputing concurrently, see Document::_recomputeFeatures()
+    if (!_pDoc || !_pDoc->_isRecomputingConcurrently())
+        signalBeforeChange(*this,*prop);
 }
 
-/// get called by the container when a Property was changed
-void DocumentObject::onChanged(const Property* prop)
+void DocumentObject::_onEarlyChanged(const Property* prop)
 {
-    if(GetApplication().isClosingAll())
-        return;
-
     if(!GetApplication().isRestoring() && 
        prop && !prop->testStatus(Property::PartialTrigger) &&
        getDocument() && 
@@ -705,14 +709,38 @@ void DocumentObject::onChanged(const Property* prop)
 
     signalEarlyChanged(*this,*prop);
 
+    if (prop == &Label && _pDoc && oldLabel != Label.getStrValue()) {
+        ObjectIdentifier::invalidateResolveCache();
+        _pDoc->signalRelabelObject(*this);
+    }
+
+    // Invalidate cached sub-object resolution on placement or linkage
+    // change, or change of any other property marked as affecting
+    // getSubObject(), e.g. by Link.
+    if (prop->isDerivedFrom(PropertyPlacement::getClassTypeId())
+            || prop->isDerivedFrom(PropertyLinkBase::getClassTypeId())
+            || prop->testStatus(Property::AffectSubObject))
+        invalidateSubObjectCache();
+}
+
+/// get called by the container when a Property was changed
+void DocumentObject::onChanged(const Property* prop)
+{
+    if(GetApplication().isClosingAll())
+        return;
+
+    // When recomputing concurrently, this function is called from a worker
+    // thread. Signals, relabeling and cache invalidation are then deferred to
+    // the main thread, see Document::_recomputeFeatures()
+    bool deferred = _pDoc && _pDoc->_isRecomputingConcurrently();
+    if (!deferred)
+        _onEarlyChanged(prop);
+
     // Delay signaling view provider until the document object has handled the
     // change
     // if (_pDoc)
     //     _pDoc->onChangedProperty(this,prop);
 
-    if (prop == &Label && _pDoc && oldLabel != Label.getStrValue())
-        _pDoc->signalRelabelObject(*this);
-
     // set object touched if it is an input property
     if (!testStatus(ObjectStatus::NoTouch) 
             && !(prop->getType() & Prop_Output) 
@@ -734,7 +762,8 @@ void DocumentObject::onChanged(const Property* prop)
     if (_pDoc)
         _pDoc->onChangedProperty(this,prop);
 
-    signalChanged(*this,*prop);
+    if (!deferred)
+        signalChanged(*this,*prop);
 }
 
 void DocumentObject::clearOutListCache() const {
@@ -801,6 +830,30 @@ DocumentObject *DocumentObject::getSubObject(const char *subname,
     return ret;
 }
 
+DocumentObject *DocumentObject::getSubObjectCached(const char *subname,
+        Base::Matrix4D *mat, bool transform, const char **element) const
+{
+    if(!_pDoc || !getNameInDocument()) {
+        if(element)
+            *element = Data::ComplexGeoData::findElementName(subname);
+        return getSubObject(subname,0,mat,transform);
+    }
+    return _pDoc->_getSubObjectCached(this,subname,mat,transform,element);
+}
+
+void DocumentObject::invalidateSubObjectCache()
+{
+    ++_SubObjectGeneration;
+}
+
+unsigned long DocumentObject::getSubObjectCacheGeneration()
+{
+    // Sub-object resolution also depends on object names and labels, which
+    // are tracked by the resolve cache generation of ObjectIdentifier. Both
+    // counters only increase, so does their sum.
+    return _SubObjectGeneration + ObjectIdentifier::getResolveGeneration();
+}
+
 std::vector<DocumentObject*> DocumentObject::getSubObjectList(const char *subname) const {
     std::vector<DocumentObject*> res;
     res.push_back(const_cast<DocumentObject*>(this));
@@ -810,7 +863,7 @@ std::vector<DocumentObject*> DocumentObject::getSubObjectList(const char *subnam
     for(auto pos=sub.find('.');pos!=std::string::npos;pos=sub.find('.',pos+1)) {
         char c = sub[pos+1];
         sub[pos+1] = 0;
-        auto sobj = getSubObject(sub.c_str());
+        auto sobj = getSubObjectCached(sub.c_str());
         if(!sobj || !sobj->getNameInDocument())
             break;
         res.push_back(sobj);
@@ -1012,7 +1065,11 @@ DocumentObject *DocumentObject::resolve(const char *subname,
     if(parent) *parent = 0;
     if(subElement) *subElement = 0;
 
-    auto obj = getSubObject(subname,pyObj,pmat,transform,depth);
+    DocumentObject *obj;
+    if(pyObj || depth)
+        obj = getSubObject(subname,pyObj,pmat,transform,depth);
+    else
+        obj = getSubObjectCached(subname,pmat,transform);
     if(!obj || !subname || *subname==0)
         return self;
 
@@ -1057,7 +1114,7 @@ DocumentObject *DocumentObject::resolve(const char *subname,
             }
             if(dot==subname)
                 break;
-            auto sobj = getSubObject(std::string(subname,dot-subname+1).c_str());
+            auto sobj = getSubObjectCached(std::string(subname,dot-subname+1).c_str());
             if(sobj!=obj) {
                 if(parent) {
                     // Link/LinkGroup has special visiblility handling of plain
@@ -1068,7 +1125,7 @@ DocumentObject *DocumentObject::resolve(const char *subname,
                     }
                     for(auto ddot=dot-1;ddot!=subname;--ddot) {
                         if(*ddot != '.') continue;
-                        auto sobj = getSubObject(std::string(subname,ddot-subname+1).c_str());
+                        auto sobj = getSubObjectCached(std::string(subname,ddot-subname+1).c_str());
                         if(!sobj->hasExtension(GroupExtension::getExtensionClassTypeId(),false)) {
                             *parent = sobj;
                             break;
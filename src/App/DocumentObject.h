@@ -343,6 +343,30 @@ public:
     virtual DocumentObject *getSubObject(const char *subname, PyObject **pyObj=0, 
             Base::Matrix4D *mat=0, bool transform=true, int depth=0) const;
 
+    /** Cached version of getSubObject() for repeated resolution of the same subname
+     *
+     * @param subname: dot separated subname
+     * @param mat: optional input and output transformation matrix as in getSubObject()
+     * @param transform: whether to apply this object's own placement
+     * @param element: optional output of the trailing non-object element
+     * name, which is guaranteed to be within the buffer pointed to by 'subname'
+     *
+     * The resolved sub-object and its relative transformation are cached per
+     * document, and invalidated on any change of object placement, linkage,
+     * or property with status Property::AffectSubObject. Python features
+     * customizing getSubObject() invalidate the cache on any change.
+     *
+     * @sa getSubObject(), invalidateSubObjectCache()
+     */
+    DocumentObject *getSubObjectCached(const char *subname, Base::Matrix4D *mat=0,
+            bool transform=true, const char **element=0) const;
+
+    /// Invalidate all cached results of getSubObjectCached()
+    static void invalidateSubObjectCache();
+
+    /// Return the current generation of the sub-object cache
+    static unsigned long getSubObjectCacheGeneration();
+
     /// Return a list of objects referenced by a given subname including this object
     std::vector<DocumentObject*> getSubObjectList(const char *subname) const;
 
@@ -523,6 +547,18 @@ public:
      */
     virtual int canLoadPartial() const {return 0;}
 
+    /** Allow the object to be recomputed concurrently with other objects
+     *
+     * @return Returns true if execute() of this object can be called from a
+     * worker thread while other independent objects are being recomputed.
+     * The object must not call into Python, nor modify any object other than
+     * itself during execute().
+     *
+     * This is only used by Document::recompute() when the parameter
+     * 'ParallelRecompute' is enabled.
+     */
+    virtual bool isRecomputeThreadSafe() const {return false;}
+
     virtual void onUpdateElementReference(const Property *) {}
 
     /** Allow object to redirect a subname path
@@ -610,6 +646,11 @@ protected: // attributes
     // pointer to the document name string (for performance)
     const std::string *pcNameInDocument;
 
+private:
+    /// Emit the early change notification, called by onChanged() or by the
+    /// document after concurrent recompute
+    void _onEarlyChanged(const Property *prop);
+
 private:
     // accessed by App::Document to record and restore the correct view provider type
     std::string _pcViewProviderName;
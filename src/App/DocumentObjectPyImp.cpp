@@ -478,8 +478,12 @@ PyObject*  DocumentObjectPy::getSubObject(PyObject *args, PyObject *keywds)
             ret.emplace_back(mat);
             auto &info = ret.back();
             PyObject *pyObj = 0;
-            info.sobj = getDocumentObjectPtr()->getSubObject(
-                    sub.c_str(),retType!=0&&retType!=2?0:&pyObj,&info.mat,transform,depth);
+            if(retType!=0 && retType!=2 && !depth)
+                info.sobj = getDocumentObjectPtr()->getSubObjectCached(
+                        sub.c_str(),&info.mat,transform);
+            else
+                info.sobj = getDocumentObjectPtr()->getSubObject(
+                        sub.c_str(),retType!=0&&retType!=2?0:&pyObj,&info.mat,transform,depth);
             if(pyObj)
                 info.pyObj = Py::Object(pyObj,true);
             if(info.sobj) 
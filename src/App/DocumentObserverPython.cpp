@@ -509,6 +509,24 @@ void DocumentObserverPython::slotFinishSaveDocument(const App::Document& doc, co
     }
 }
 
+void DocumentObserverPython::slotFinishSaveDocumentStatus(const App::Document& doc,
+        const std::string& file, bool success, const std::string& message)
+{
+    Base::PyGILStateLocker lock;
+    try {
+        Py::Tuple args(4);
+        args.setItem(0, Py::Object(const_cast<App::Document&>(doc).getPyObject(), true));
+        args.setItem(1, Py::String(file));
+        args.setItem(2, Py::Boolean(success));
+        args.setItem(3, Py::String(message));
+        Base::pyCall(pyFinishSaveDocumentStatus.ptr(),args.ptr());
+    }
+    catch (Py::Exception&) {
+        Base::PyException e; // extract the Python error text
+        e.ReportException();
+    }
+}
+
 void DocumentObserverPython::slotDocumentFilesSaved(const App::Document& doc, 
         const std::string& file, const std::vector<std::pair<std::string,int> > &files)
 {
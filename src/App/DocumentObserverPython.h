@@ -105,6 +105,8 @@ private:
     void slotStartSaveDocument(const App::Document&, const std::string&);
     /** Called when an document has been saved*/
     void slotFinishSaveDocument(const App::Document&, const std::string&);
+    /** Called when a document has been saved or failed to save, including background saving*/
+    void slotFinishSaveDocumentStatus(const App::Document&, const std::string&, bool, const std::string&);
     /** Called to report the files saved/added/removed for a document */
     void slotDocumentFilesSaved(const App::Document&, const std::string&,
             const std::vector<std::pair<std::string,int> > &);
@@ -140,6 +142,7 @@ private:
     FC_PY_ELEMENT(CloseTransaction,_1) \
     FC_PY_ELEMENT(StartSaveDocument,_1,_2) \
     FC_PY_ELEMENT(FinishSaveDocument,_1,_2) \
+    FC_PY_ELEMENT(FinishSaveDocumentStatus,_1,_2,_3,_4) \
     FC_PY_ELEMENT(DocumentFilesSaved,_1,_2,_3) \
     FC_PY_ELEMENT(AppendDynamicProperty,_1) \
     FC_PY_ELEMENT(RemoveDynamicProperty,_1) \
@@ -33,6 +33,7 @@
 #include "DocumentObjectPy.h"
 #include "MergeDocuments.h"
 #include "PropertyLinks.h"
+#include "RecomputeProfiler.h"
 
 // inclusion of the generated files (generated By DocumentPy.xml)
 #include "DocumentPy.h"
@@ -53,16 +54,21 @@ std::string DocumentPy::representation(void) const
 
 PyObject*  DocumentPy::save(PyObject * args)
 {
-    if (!PyArg_ParseTuple(args, ""))     // convert args: Python->C
+    PyObject *background = Py_False;
+    if (!PyArg_ParseTuple(args, "|O", &background))     // convert args: Python->C
         return NULL;                    // NULL triggers exception
 
     PY_TRY {
-        if (!getDocumentPtr()->save()) {
+        if (!getDocumentPtr()->save(PyObject_IsTrue(background) ? true : false)) {
             PyErr_SetString(PyExc_ValueError, "Object attribute 'FileName' is not set");
             return NULL;
         }
     } PY_CATCH;
 
+    // The file may not exist yet when saving in background
+    if (getDocumentPtr()->isSavingInBackground())
+        Py_Return;
+
     const char* filename = getDocumentPtr()->FileName.getValue();
     Base::FileInfo fi(filename);
     if (!fi.isReadable()) {
@@ -491,6 +497,30 @@ PyObject*  DocumentPy::recompute(PyObject * args)
     } PY_CATCH;
 }
 
+PyObject*  DocumentPy::recomputeProfile(PyObject * args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return NULL;
+    PY_TRY {
+        auto events = RecomputeProfiler::instance().getProfile(getDocumentPtr());
+        long long start = events.empty()?0:events.front().start;
+        Py::List res;
+        for(auto &event : events) {
+            Py::Dict dict;
+            dict.setItem("Category",Py::String(event.category));
+            dict.setItem("Name",Py::String(event.name));
+            dict.setItem("Object",Py::String(event.object));
+            dict.setItem("Detail",Py::String(event.detail));
+            dict.setItem("Start",Py::Float((event.start-start)*1e-6));
+            dict.setItem("Duration",Py::Float(event.duration*1e-6));
+            dict.setItem("Depth",Py::Int(event.depth));
+            dict.setItem("Thread",Py::Int(event.thread));
+            res.append(dict);
+        }
+        return Py::new_reference_to(res);
+    } PY_CATCH;
+}
+
 PyObject*  DocumentPy::getObject(PyObject *args)
 {
     long id = -1;
@@ -636,6 +666,32 @@ Py::Int DocumentPy::getUndoRedoMemSize(void) const
     return Py::Int((long)getDocumentPtr()->getUndoMemSize());
 }
 
+Py::Int DocumentPy::getUndoMemLimit(void) const
+{
+    return Py::Int((long)getDocumentPtr()->getUndoLimit());
+}
+
+void DocumentPy::setUndoMemLimit(Py::Int arg)
+{
+    long limit = arg;
+    if(limit < 0)
+        throw Py::ValueError("Expect a non-negative integer");
+    getDocumentPtr()->setUndoLimit((std::size_t)limit);
+}
+
+Py::Int DocumentPy::getUndoCompressThreshold(void) const
+{
+    return Py::Int((long)getDocumentPtr()->getUndoCompressThreshold());
+}
+
+void DocumentPy::setUndoCompressThreshold(Py::Int arg)
+{
+    long threshold = arg;
+    if(threshold < 0)
+        throw Py::ValueError("Expect a non-negative integer");
+    getDocumentPtr()->setUndoCompressThreshold((unsigned int)threshold);
+}
+
 Py::Int DocumentPy::getUndoCount(void) const
 {
     return Py::Int((long)getDocumentPtr()->getAvailableUndos());
@@ -776,6 +832,111 @@ int DocumentPy::setCustomAttributes(const char* attr, PyObject *)
     return 0;
 }
 
+PyObject* DocumentPy::setPropertiesBulk(PyObject *args)
+{
+    PyObject *pyChanges;
+    if (!PyArg_ParseTuple(args, "O", &pyChanges))
+        return NULL;
+
+    // Objects are referred to through their Python object, which stays alive
+    // but is invalidated when the object is deleted by any Python code
+    // invoked while setting the properties.
+    struct BulkChange {
+        Py::Object pyObj;
+        Py::Object dict;
+        bool active = false;
+
+        BulkChange(const Py::Object &pyObj, const Py::Object &dict)
+            :pyObj(pyObj), dict(dict)
+        {}
+
+        BulkChange(BulkChange &&other)
+            :pyObj(other.pyObj), dict(other.dict), active(other.active)
+        {
+            other.active = false;
+        }
+
+        ~BulkChange() {
+            // Must make sure to not throw in a destructor
+            try {
+                end();
+            }catch(Base::Exception &e) {
+                e.ReportException();
+            }catch(...) {}
+        }
+
+        DocumentObject *getObject() const {
+            auto pyDocObj = static_cast<DocumentObjectPy*>(pyObj.ptr());
+            return pyDocObj->isValid() ? pyDocObj->getDocumentObjectPtr() : 0;
+        }
+
+        void begin() {
+            if (auto obj = getObject()) {
+                obj->beginBulkChange();
+                active = true;
+            }
+        }
+
+        void end() {
+            if (!active)
+                return;
+            active = false;
+            if (auto obj = getObject())
+                obj->endBulkChange();
+        }
+    };
+
+    PY_TRY {
+        std::vector<BulkChange> changes;
+        auto addChange = [&](PyObject *pyObj, PyObject *dict) {
+            DocumentObject *obj = 0;
+            if (PyObject_TypeCheck(pyObj, &DocumentObjectPy::Type))
+                obj = static_cast<DocumentObjectPy*>(pyObj)->getDocumentObjectPtr();
+            else if (PyUnicode_Check(pyObj))
+                obj = getDocumentPtr()->getObject(Py::String(pyObj).as_std_string("utf-8").c_str());
+            if (!obj || !obj->getNameInDocument())
+                throw Py::ValueError("Expect an object or object name of this document");
+            if (!PyDict_Check(dict))
+                throw Py::TypeError("Expect a dict of property values");
+            changes.emplace_back(Py::asObject(obj->getPyObject()), Py::Object(dict));
+        };
+
+        if (PyDict_Check(pyChanges)) {
+            PyObject *key, *value;
+            Py_ssize_t pos = 0;
+            while (PyDict_Next(pyChanges, &pos, &key, &value))
+                addChange(key, value);
+        } else if (PySequence_Check(pyChanges)) {
+            Py::Sequence seq(pyChanges);
+            for (Py_ssize_t i=0; i<seq.size(); ++i) {
+                Py::Sequence item(seq[i]);
+                if (item.size() != 2)
+                    throw Py::TypeError("Expect a sequence of (object, dict) pairs");
+                addChange(item[0].ptr(), item[1].ptr());
+            }
+        } else
+            throw Py::TypeError("Expect a dict or a sequence of (object, dict) pairs");
+
+        // Defer the change notification of all objects until all properties
+        // are set.
+        for (auto &change : changes)
+            change.begin();
+
+        for (auto &change : changes) {
+            // Skip objects deleted or removed from the document in the meantime
+            auto obj = change.getObject();
+            if (!obj || !obj->getNameInDocument())
+                continue;
+            Py::Callable method(change.pyObj.getAttr("setProperties"));
+            method.apply(Py::TupleN(change.dict));
+        }
+
+        for (auto &change : changes)
+            change.end();
+        Py_Return;
+    } PY_CATCH;
+}
+
 PyObject* DocumentPy::getLinksTo(PyObject *args)
 {
     PyObject *pyobj = Py_None;
@@ -32,6 +32,7 @@
 #include "PropertyContainer.h"
 #include "Application.h"
 #include "ExtensionContainer.h"
+#include "ObjectIdentifier.h"
 #include <Base/Reader.h>
 #include <Base/Writer.h>
 #include <Base/Console.h>
@@ -188,6 +189,8 @@ Property* DynamicProperty::_addDynamicProperty(PropertyContainer &pc, const char
     pcProperty->syncType(attr);
     pcProperty->StatusBits.set((size_t)Property::PropDynamic);
 
+    ObjectIdentifier::invalidateResolveCache();
+
     GetApplication().signalAppendDynamicProperty(*pcProperty);
 
     return pcProperty;
@@ -203,6 +206,7 @@ bool DynamicProperty::addProperty(Property *prop)
     index.emplace(prop,std::string(),prop->getName(),
             prop->getGroup(),prop->getDocumentation(),
             StringIDRef(),prop->getType(),false,false);
+    ObjectIdentifier::invalidateResolveCache();
     return true;
 }
 
@@ -212,6 +216,7 @@ bool DynamicProperty::removeProperty(const Property *prop)
     auto it = index.find(const_cast<Property*>(prop));
     if (it != index.end()) {
         index.erase(it);
+        ObjectIdentifier::invalidateResolveCache();
         return true;
     }
     return false;
@@ -228,6 +233,7 @@ bool DynamicProperty::removeDynamicProperty(const char* name)
             throw Base::RuntimeError("property is not dynamic");
         Property *prop = it->property;
         GetApplication().signalRemoveDynamicProperty(*prop);
+        ObjectIdentifier::invalidateResolveCache();
         delete prop;
         index.erase(it);
         return true;
@@ -240,23 +246,20 @@ std::string DynamicProperty::getUniquePropertyName(PropertyContainer &pc, const
 {
     std::string CleanName = Base::Tools::getIdentifier(Name);
 
-    // name in use?
+    // name in use? Check by direct look up first to avoid collecting all
+    // property names, which makes adding many properties (e.g. spreadsheet
+    // cells) quadratic.
+    if (!pc.getPropertyByName(CleanName.c_str()))
+        return CleanName;
+
     std::map<std::string,Property*> objectProps;
     pc.getPropertyMap(objectProps);
-    auto pos = objectProps.find(CleanName);
-
-    if (pos == objectProps.end()) {
-        // if not, name is OK
-        return CleanName;
-    }
-    else {
-        std::vector<std::string> names;
-        names.reserve(objectProps.size());
-        for (pos = objectProps.begin();pos != objectProps.end();++pos) {
-            names.push_back(pos->first);
-        }
-        return Base::Tools::getUniqueName(CleanName, names);
+    std::vector<std::string> names;
+    names.reserve(objectProps.size());
+    for (auto pos = objectProps.begin();pos != objectProps.end();++pos) {
+        names.push_back(pos->first);
     }
+    return Base::Tools::getUniqueName(CleanName, names);
 }
 
 void DynamicProperty::save(const Property *prop, Base::Writer &writer) const 
@@ -52,6 +52,7 @@
 #include <cctype>
 #include <algorithm>
 #include <climits>
+#include <atomic>
 #include "Expression.h"
 #include "ExpressionParser.h"
 #include <Base/Unit.h>
@@ -1519,12 +1520,350 @@ ExpressionPtr Expression::replaceObject(const DocumentObject *parent,
     return expr;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// Native evaluation
+//
+// Numeric expressions, i.e. numbers, quantities, booleans, arithmetic and
+// comparison operators, conditionals and math functions, are compiled into a
+// flat node list and evaluated directly over Base::Quantity without creating
+// any Python object or taking the GIL. Any other node becomes a Python leaf
+// that is evaluated through getPyValue(). The native result follows the same
+// type rules as the Python evaluation (e.g. int vs float vs Quantity), and
+// the evaluation falls back to Python on any error, so that the same error
+// message is reported.
+
+class ExpressionParams: public ParameterGrp::ObserverType {
+public:
+    ExpressionParams() {
+        handle = GetApplication().GetParameterGroupByPath(
+                "User parameter:BaseApp/Preferences/Expression");
+        handle->Attach(this);
+        nativeEvaluation = handle->GetBool("NativeEvaluation", true);
+    }
+
+    void OnChange(Base::Subject<const char*> &, const char* sReason) {
+        if(sReason && strcmp(sReason,"NativeEvaluation")==0)
+            nativeEvaluation = handle->GetBool("NativeEvaluation", true);
+    }
+
+    static ExpressionParams *instance() {
+        static ExpressionParams *inst = new ExpressionParams;
+        return inst;
+    }
+
+    std::atomic<bool> nativeEvaluation;
+
+private:
+    ParameterGrp::handle handle;
+};
+
+// Non zero if there is an expression being evaluated in the current thread.
+// Only top level evaluation is done natively.
+static thread_local int _EvalDepth;
+
+struct EvalDepthGuard {
+    EvalDepthGuard() {++_EvalDepth;}
+    ~EvalDepthGuard() {--_EvalDepth;}
+};
+
+// Properties of the variable nodes of the program being evaluated in the
+// current thread by Expression::NativeEvaluation::run(), which must not call
+// into Python
+static thread_local const std::vector<Property*> *_NativeProps;
+
+struct NativePropsGuard {
+    NativePropsGuard(const std::vector<Property*> &props) {_NativeProps = &props;}
+    ~NativePropsGuard() {_NativeProps = nullptr;}
+};
+
+// Thrown to abort native evaluation and retry with Python
+struct NativeFallback {};
+
+struct NativeValue {
+    enum Type {
+        TypeBool,
+        TypeInt,
+        TypeFloat,
+        TypeQuantity,
+    };
+    Type type = TypeInt;
+    Quantity value;
+
+    NativeValue() {}
+
+    NativeValue(Type t, const Quantity &q)
+        :type(t),value(q)
+    {}
+
+    double getValue() const {
+        return value.getValue();
+    }
+
+    bool isQuantity() const {
+        return type == TypeQuantity;
+    }
+
+    bool isTrue() const {
+        return value.getValue() != 0.0;
+    }
+
+    bool fromPy(const Py::Object &pyobj) {
+        PyObject *obj = pyobj.ptr();
+        if (PyObject_TypeCheck(obj, &QuantityPy::Type)) {
+            type = TypeQuantity;
+            value = *static_cast<QuantityPy*>(obj)->getQuantityPtr();
+        } else if (PyBool_Check(obj)) {
+            type = TypeBool;
+            value = Quantity(obj == Py_True ? 1.0 : 0.0);
+        } else if (PyFloat_Check(obj)) {
+            type = TypeFloat;
+            value = Quantity(PyFloat_AsDouble(obj));
+#if PY_MAJOR_VERSION < 3
+        } else if (PyInt_Check(obj)) {
+            type = TypeInt;
+            value = Quantity((double)PyInt_AsLong(obj));
+#endif
+        } else if (PyLong_Check(obj)) {
+            int overflow = 0;
+            long long v = PyLong_AsLongLongAndOverflow(obj,&overflow);
+            if(overflow || !isExactInt((double)v))
+                return false;
+            type = TypeInt;
+            value = Quantity((double)v);
+        } else
+            return false;
+        return true;
+    }
+
+    Py::Object getPyValue() const {
+        switch(type) {
+        case TypeBool:
+            return Py::Boolean(isTrue());
+        case TypeInt:
+            return pyFromQuantity(value);
+        case TypeFloat:
+            return Py::Float(value.getValue());
+        default:
+            return Py::Object(new QuantityPy(new Quantity(value)));
+        }
+    }
+
+    App::any getAnyValue() const {
+        switch(type) {
+        case TypeBool:
+            return App::any(isTrue() ? 1L : 0L);
+        case TypeInt:
+            return App::any((long)value.getValue());
+        case TypeFloat:
+            return App::any(value.getValue());
+        default:
+            return App::any(value);
+        }
+    }
+
+    ExpressionPtr toExpression(const DocumentObject *owner) const {
+        if(type == TypeBool) {
+            if(isTrue())
+                return ConstantExpression::create(owner,"True",Quantity(1.0));
+            else
+                return ConstantExpression::create(owner,"False",Quantity(0.0));
+        }
+        return NumberExpression::create(owner,value);
+    }
+
+    // Python integers have arbitrary precision, only keep those that can be
+    // exactly represented by double
+    static bool isExactInt(double v) {
+        return std::fabs(v) <= 9007199254740992.0;
+    }
+};
+
+struct App::ExpressionProgram {
+    enum NodeType {
+        NodeNumber,
+        NodeBool,
+        NodeVariable,
+        NodePython,
+        NodeOperator,
+        NodeConditional,
+        NodeFunction,
+    };
+
+    struct Node {
+        NodeType type;
+        int op;
+        const Expression *expr;
+        int args[3];
+        int argCount;
+    };
+
+    std::vector<Node> nodes;
+    int root = -1;
+    bool hasPython = false;
+    mutable std::atomic<bool> disabled;
+
+    ExpressionProgram()
+        :disabled(false)
+    {}
+
+    int addNode(NodeType type, const Expression *expr,
+            int op=0, int arg0=-1, int arg1=-1, int arg2=-1)
+    {
+        Node node;
+        node.type = type;
+        node.op = op;
+        node.expr = expr;
+        node.args[0] = arg0;
+        node.args[1] = arg1;
+        node.args[2] = arg2;
+        node.argCount = arg0<0 ? 0 : (arg1<0 ? 1 : (arg2<0 ? 2 : 3));
+        nodes.push_back(node);
+        return (int)nodes.size()-1;
+    }
+
+    int addPython(const Expression *expr) {
+        hasPython = true;
+        return addNode(NodePython, expr);
+    }
+
+    int compile(const Expression *expr) {
+        if(expr->components.size())
+            return addPython(expr);
+        return expr->_compile(*this);
+    }
+
+    NativeValue eval(int index, bool &pyError) const;
+    NativeValue evalPython(const Expression *expr, bool &pyError) const;
+    NativeValue evalVariable(const Node &node, bool &pyError) const;
+    NativeValue evalOperator(const Node &node, bool &pyError) const;
+
+    static std::shared_ptr<ExpressionProgram> getProgram(const Expression *expr, int options);
+    static bool evaluate(const Expression *expr, int options, NativeValue &value);
+};
+
+std::shared_ptr<ExpressionProgram> ExpressionProgram::getProgram(const Expression *expr, int options)
+{
+    if(_EvalDepth
+            || (options & Expression::OptionPythonMode)
+            || !_EvalStack.empty()
+            || !ExpressionParams::instance()->nativeEvaluation)
+        return std::shared_ptr<ExpressionProgram>();
+
+    auto program = std::atomic_load(&expr->program);
+    if(!program) {
+        program = std::make_shared<ExpressionProgram>();
+        program->root = program->compile(expr);
+        // Nothing to gain if the whole expression has to be evaluated by Python
+        if(program->nodes[program->root].type == NodePython)
+            program->disabled = true;
+        std::atomic_store(&expr->program, program);
+    }
+    if(program->disabled)
+        return std::shared_ptr<ExpressionProgram>();
+    return program;
+}
+
+bool ExpressionProgram::evaluate(const Expression *expr, int options, NativeValue &value)
+{
+    auto program = getProgram(expr, options);
+    if(!program)
+        return false;
+
+    EvalDepthGuard guard;
+    bool pyError = false;
+    try {
+        if(!program->hasPython)
+            value = program->eval(program->root, pyError);
+        else {
+            Base::PyGILStateLocker lock;
+            EvalFrame frame;
+            if(options & Expression::OptionCallFrame)
+                frame.push();
+            value = program->eval(program->root, pyError);
+        }
+        return true;
+    } catch (NativeFallback &) {
+    } catch (Base::Exception &) {
+        // Propagate the exception if it comes from Python evaluation,
+        // otherwise, let Python report the error
+        if(pyError)
+            throw;
+    }
+    return false;
+}
+
+NativeValue ExpressionProgram::evalPython(const Expression *expr, bool &pyError) const
+{
+    if(_NativeProps)
+        throw NativeFallback();
+
+    Base::PyGILStateLocker lock;
+    Py::Object pyobj;
+    try {
+        pyobj = expr->getPyValue();
+    } catch (...) {
+        pyError = true;
+        throw;
+    }
+    NativeValue res;
+    if(!res.fromPy(pyobj)) {
+        // Not a numeric expression after all
+        disabled = true;
+        throw NativeFallback();
+    }
+    return res;
+}
+
+NativeValue ExpressionProgram::evalVariable(const Node &node, bool &pyError) const
+{
+    Property *prop;
+    if(_NativeProps)
+        prop = (*_NativeProps)[&node - &nodes[0]];
+    else {
+        // Variables may be bound in the evaluation frame
+        if(!_EvalStack.empty() && (_EvalStack.size()>1 || !_EvalStack[0]->vars.empty()))
+            return evalPython(node.expr, pyError);
+
+        prop = static_cast<const VariableExpression*>(node.expr)->getPath().getDirectProperty();
+    }
+    if(prop) {
+        if(prop->isDerivedFrom(PropertyQuantity::getClassTypeId()))
+            return NativeValue(NativeValue::TypeQuantity,
+                    static_cast<PropertyQuantity*>(prop)->getQuantityValue());
+        if(prop->isDerivedFrom(PropertyFloat::getClassTypeId()))
+            return NativeValue(NativeValue::TypeFloat,
+                    Quantity(static_cast<PropertyFloat*>(prop)->getValue()));
+        if(prop->isDerivedFrom(PropertyInteger::getClassTypeId()))
+            return NativeValue(NativeValue::TypeInt,
+                    Quantity((double)static_cast<PropertyInteger*>(prop)->getValue()));
+        if(prop->isDerivedFrom(PropertyBool::getClassTypeId()))
+            return NativeValue(NativeValue::TypeBool,
+                    Quantity(static_cast<PropertyBool*>(prop)->getValue()?1.0:0.0));
+    }
+    return evalPython(node.expr, pyError);
+}
+
+int Expression::_compile(ExpressionProgram &program) const {
+    return program.addPython(this);
+}
+
 App::any Expression::getValueAsAny(int options) const {
+    NativeValue value;
+    if(ExpressionProgram::evaluate(this,options,value))
+        return value.getAnyValue();
+
     Base::PyGILStateLocker lock;
+    EvalDepthGuard guard;
     return pyObjectToAny(getPyValue(options));
 }
 
 Py::Object Expression::getPyValue(int options, int *jumpCode) const {
+    if(!jumpCode && !_EvalDepth) {
+        NativeValue value;
+        if(ExpressionProgram::evaluate(this,options,value))
+            return value.getPyValue();
+    }
+
     if(options & OptionCallFrame) {
         options &= ~OptionCallFrame;
         EvalFrame frame;
@@ -1537,6 +1876,7 @@ Py::Object Expression::getPyValue(int options, int *jumpCode) const {
     }
 
     try {
+        EvalDepthGuard guard;
         Py::Object pyobj = _getPyValue(jumpCode);
         if(components.size()) {
             for(auto &c : components)
@@ -1552,6 +1892,7 @@ Py::Object Expression::getPyValue(int options, int *jumpCode) const {
 void Expression::addComponent(ComponentPtr &&component) {
     assert(component);
     components.push_back(std::move(component));
+    std::atomic_store(&program, std::shared_ptr<ExpressionProgram>());
 }
 
 void Expression::visit(ExpressionVisitor &v) {
@@ -1562,10 +1903,63 @@ void Expression::visit(ExpressionVisitor &v) {
 }
 
 ExpressionPtr Expression::eval(int options) const {
+    NativeValue value;
+    if(ExpressionProgram::evaluate(this,options,value))
+        return value.toExpression(owner);
+
     Base::PyGILStateLocker lock;
+    EvalDepthGuard guard;
     return expressionFromPy(owner,getPyValue(options));
 }
 
+Expression::NativeEvaluation::NativeEvaluation(const Expression *expr)
+    :expr(expr)
+{
+    if(!expr)
+        return;
+    auto prog = ExpressionProgram::getProgram(expr,0);
+    if(!prog || prog->hasPython)
+        return;
+
+    // Resolve the variables here, because the resolution may look up and
+    // update the resolve cache of the object identifier
+    props.resize(prog->nodes.size(),nullptr);
+    for(std::size_t i=0; i<prog->nodes.size(); ++i) {
+        const auto &node = prog->nodes[i];
+        if(node.type != ExpressionProgram::NodeVariable)
+            continue;
+        props[i] = static_cast<const VariableExpression*>(node.expr)->getPath().getDirectProperty();
+        if(!props[i])
+            return;
+    }
+    program = prog;
+}
+
+bool Expression::NativeEvaluation::run() {
+    done = false;
+    if(!program)
+        return false;
+
+    NativePropsGuard guard(props);
+    bool pyError = false;
+    try {
+        NativeValue res = program->eval(program->root, pyError);
+        value = res.value;
+        isBool = res.type == NativeValue::TypeBool;
+        done = true;
+    } catch (NativeFallback &) {
+    } catch (Base::Exception &) {
+    }
+    return done;
+}
+
+ExpressionPtr Expression::NativeEvaluation::getResult() const {
+    if(!done)
+        return ExpressionPtr();
+    return NativeValue(isBool ? NativeValue::TypeBool : NativeValue::TypeQuantity,
+                       value).toExpression(expr->getOwner());
+}
+
 bool Expression::isSame(const Expression &other) const {
     if(&other == this)
         return true;
@@ -1688,6 +2082,10 @@ Py::Object UnitExpression::_getPyValue(int *) const {
     return Py::Object(cache);
 }
 
+int UnitExpression::_compile(ExpressionProgram &program) const {
+    return program.addNode(ExpressionProgram::NodeNumber, this);
+}
+
 //
 // NumberExpression class
 //
@@ -1966,6 +2364,40 @@ Py::Object OperatorExpression::_getPyValue(int *) const
     return calc(this,op,value,right.get(),false);
 }
 
+int OperatorExpression::_compile(ExpressionProgram &program) const
+{
+    switch(op) {
+    case OP_NEG:
+    case OP_POS:
+    case OP_NOT:
+        return program.addNode(ExpressionProgram::NodeOperator, this, op,
+                program.compile(left.get()));
+    case OP_ADD:
+    case OP_SUB:
+    case OP_MUL:
+    case OP_UNIT:
+    case OP_DIV:
+    case OP_FDIV:
+    case OP_MOD:
+    case OP_POW:
+    case OP_POW2:
+    case OP_EQ:
+    case OP_NE:
+    case OP_LT:
+    case OP_GT:
+    case OP_LE:
+    case OP_GE:
+    case OP_AND:
+    case OP_OR: {
+        int l = program.compile(left.get());
+        int r = program.compile(right.get());
+        return program.addNode(ExpressionProgram::NodeOperator, this, op, l, r);
+    }
+    default:
+        return program.addPython(this);
+    }
+}
+
 
 /**
   * Simplify the expression. For OperatorExpressions, we return a NumberExpression if
@@ -2632,153 +3064,9 @@ Py::Object FunctionExpression::evalAggregate(const Expression *owner, int f, con
     return pyFromQuantity(c->getQuantity());
 }
 
-Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const ExpressionList &args) 
+static Quantity calcFunction(const Expression *expr, int f,
+        const Quantity &v1, const Quantity *v2, const Quantity *v3)
 {
-    if(!expr || !expr->getOwner())
-        _EXPR_THROW("Invalid owner.", expr);
-
-    if(args.empty())
-        _EXPR_THROW("Function requires at least one argument.",expr);
-
-    // Handle aggregate functions
-    if (f > AGGREGATES)
-        return evalAggregate(expr, f, args);
-
-    switch(f) {
-    case GET_VAR: 
-        if(args.size()<2)
-            _EXPR_THROW("Function expects 2 or 3 arguments.",expr);
-        // fall through
-    case HAS_VAR: {
-        Py::Object value = args[0]->getPyValue();
-        if(!value.isString())
-            _EXPR_THROW("Expects the first argument evaluating to a string.",expr);
-        Py::Object pyobj;
-        bool found = Base::Interpreter().getVariable(value.as_string().c_str(),pyobj);
-        if(f == HAS_VAR)
-            return Py::Boolean(found);
-#if 1
-        // getvar() may pose as a security problem. Disable it for now.
-        __EXPR_THROW(Base::NotImplementedError, "getvar() is disabled.", expr);
-#else
-        if(!found) {
-            if(args.size()==2)
-                return args[1]->getPyValue();
-            _EXPR_THROW("Variable not found.",expr);
-        }
-        return pyobj;
-#endif
-    } case LIST: {
-        if(args.size() == 1 && args[0]->isDerivedFrom(RangeExpression::getClassTypeId()))
-            return args[0]->getPyValue();
-        Py::List list(args.size());
-        int i=0;
-        for(auto &arg : args)
-            list.setItem(i++,arg->getPyValue());
-        return list;
-    } case TUPLE: {
-        if(args.size() == 1 && args[0]->isDerivedFrom(RangeExpression::getClassTypeId()))
-            return Py::Tuple(args[0]->getPyValue());
-        Py::Tuple tuple(args.size());
-        int i=0;
-        for(auto &arg : args)
-            tuple.setItem(i++,arg->getPyValue());
-        return tuple;
-    } case MSCALE: {
-        if(args.size() < 2)
-            _EXPR_THROW("Function requires at least two arguments.",expr);
-        Py::Object pymat = args[0]->getPyValue();
-        Py::Object pyscale;
-        if(PyObject_TypeCheck(pymat.ptr(),&Base::MatrixPy::Type)) {
-            if(args.size() == 2) {
-                Py::Object obj = args[1]->getPyValue();
-                if(obj.isSequence() && PySequence_Size(obj.ptr())==3)
-                    pyscale = Py::Tuple(Py::Sequence(obj));
-            } else if(args.size() == 4) {
-                Py::Tuple tuple(3);
-                tuple.setItem(0,args[1]->getPyValue());
-                tuple.setItem(1,args[2]->getPyValue());
-                tuple.setItem(2,args[3]->getPyValue());
-                pyscale = tuple;
-            }
-        }
-        if(!pyscale.isNone()) {
-            Base::Vector3d vec;
-            if (!PyArg_ParseTuple(pyscale.ptr(), "ddd", &vec.x,&vec.y,&vec.z))
-                PyErr_Clear();
-            else {
-                auto mat = static_cast<Base::MatrixPy*>(pymat.ptr())->value();
-                mat.scale(vec);
-                return Py::Object(new Base::MatrixPy(mat));
-            }
-        }
-        _EXPR_THROW("Function requires arguments to be either "
-                "(matrix,vector) or (matrix,number,number,number).", expr);
-
-    } case MINVERT: {
-        Py::Object pyobj = args[0]->getPyValue();
-        Py::Tuple args;
-        if (PyObject_TypeCheck(pyobj.ptr(),&Base::MatrixPy::Type)) {
-            auto m = static_cast<Base::MatrixPy*>(pyobj.ptr())->value();
-            if (fabs(m.determinant()) <= DBL_EPSILON)
-                _EXPR_THROW("Cannot invert singular matrix.",expr);
-            m.inverseGauss();
-            return Py::Object(new Base::MatrixPy(m));
-
-        } else if (PyObject_TypeCheck(pyobj.ptr(),&Base::PlacementPy::Type)) {
-            const auto &pla = *static_cast<Base::PlacementPy*>(pyobj.ptr())->getPlacementPtr();
-            return Py::Object(new Base::PlacementPy(pla.inverse()));
-
-        } else if (PyObject_TypeCheck(pyobj.ptr(),&Base::RotationPy::Type)) {
-            const auto &rot = *static_cast<Base::RotationPy*>(pyobj.ptr())->getRotationPtr();
-            return Py::Object(new Base::RotationPy(rot.inverse()));
-        }
-        _EXPR_THROW("Function requires the first argument to be either Matrix, Placement or Rotation.",expr);
-
-    } case CREATE: {
-        Py::Object pytype = args[0]->getPyValue();
-        if(!pytype.isString())
-            _EXPR_THROW("Function requires the first argument to be a string.",expr);
-        std::string type(pytype.as_string());
-        Py::Object res;
-        if(boost::iequals(type,"matrix")) 
-            res = Py::Object(new Base::MatrixPy(Base::Matrix4D()));
-        else if(boost::iequals(type,"vector"))
-            res = Py::Object(new Base::VectorPy(Base::Vector3d()));
-        else if(boost::iequals(type,"placement"))
-            res = Py::Object(new Base::PlacementPy(Base::Placement()));
-        else if(boost::iequals(type,"rotation"))
-            res = Py::Object(new Base::RotationPy(Base::Rotation()));
-        else
-            _EXPR_THROW("Unknown type '" << type << "'.",expr);
-        if(args.size()>1) {
-            Py::Tuple tuple(args.size()-1);
-            for(unsigned i=1;i<args.size();++i)
-                tuple.setItem(i-1,args[i]->getPyValue());
-            Py::Dict dict;
-            PyObjectBase::__PyInit(res.ptr(),tuple.ptr(),dict.ptr());
-        }
-        return res;
-
-    } default:
-        break;
-    }
-
-    Py::Object e1 = args[0]->getPyValue();
-    Quantity v1 = pyToQuantity(e1,expr,"Invalid first argument.");
-    Py::Object e2;
-    Quantity v2;
-    if(args.size()>1) {
-        e2 = args[1]->getPyValue();
-        v2 = pyToQuantity(e2,expr,"Invalid second argument.");
-    }
-    Py::Object e3;
-    Quantity v3;
-    if(args.size()>2) {
-        e3 = args[2]->getPyValue();
-        v3 = pyToQuantity(e3,expr,"Invalid third argument.");
-    }
-
     double output;
     Unit unit;
     double scaler = 1;
@@ -2848,28 +3136,28 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const Exp
         break;
     }
     case ATAN2:
-        if (e2.isNone())
+        if (!v2)
             _EXPR_THROW("Invalid second argument.",expr);
 
-        if (v1.getUnit() != v2.getUnit())
+        if (v1.getUnit() != v2->getUnit())
             _EXPR_THROW("Units must be equal.",expr);
         unit = Unit::Angle;
         scaler = 180.0 / M_PI;
         break;
     case FMOD:
-        if (e2.isNone())
+        if (!v2)
             _EXPR_THROW("Invalid second argument.",expr);
-        unit = v1.getUnit() / v2.getUnit();
+        unit = v1.getUnit() / v2->getUnit();
         break;
     case FPOW: {
-        if (e2.isNone())
+        if (!v2)
             _EXPR_THROW("Invalid second argument.",expr);
 
-        if (!v2.getUnit().isEmpty())
+        if (!v2->getUnit().isEmpty())
             _EXPR_THROW("Exponent is not allowed to have a unit.",expr);
 
         // Compute new unit for exponentiation
-        double exponent = v2.getValue();
+        double exponent = v2->getValue();
         if (!v1.getUnit().isEmpty()) {
             if (exponent - boost::math::round(exponent) < 1e-9)
                 unit = v1.getUnit().pow(exponent);
@@ -2880,17 +3168,14 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const Exp
     }
     case HYPOT:
     case CATH:
-        if (e2.isNone())
+        if (!v2)
             _EXPR_THROW("Invalid second argument.",expr);
-        if (v1.getUnit() != v2.getUnit())
+        if (v1.getUnit() != v2->getUnit())
             _EXPR_THROW("Units must be equal.",expr);
 
-        if (args.size() > 2) {
-            if (e3.isNone())
-                _EXPR_THROW("Invalid second argument.",expr);
-            if (v2.getUnit() != v3.getUnit())
-                _EXPR_THROW("Units must be equal.",expr);
-        }
+        // The type of the optional third argument is checked by the caller
+        if (v3 && v2->getUnit() != v3->getUnit())
+            _EXPR_THROW("Units must be equal.",expr);
         unit = v1.getUnit();
         break;
     default:
@@ -2942,23 +3227,23 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const Exp
         output = cosh(value);
         break;
     case FMOD: {
-        output = fmod(value, v2.getValue());
+        output = fmod(value, v2->getValue());
         break;
     }
     case ATAN2: {
-        output = atan2(value, v2.getValue());
+        output = atan2(value, v2->getValue());
         break;
     }
     case FPOW: {
-        output = pow(value, v2.getValue());
+        output = pow(value, v2->getValue());
         break;
     }
     case HYPOT: {
-        output = sqrt(pow(v1.getValue(), 2) + pow(v2.getValue(), 2) + (!e3.isNone() ? pow(v3.getValue(), 2) : 0));
+        output = sqrt(pow(v1.getValue(), 2) + pow(v2->getValue(), 2) + (v3 ? pow(v3->getValue(), 2) : 0));
         break;
     }
     case CATH: {
-        output = sqrt(pow(v1.getValue(), 2) - pow(v2.getValue(), 2) - (!e3.isNone() ? pow(v3.getValue(), 2) : 0));
+        output = sqrt(pow(v1.getValue(), 2) - pow(v2->getValue(), 2) - (v3 ? pow(v3->getValue(), 2) : 0));
         break;
     }
     case ROUND:
@@ -2977,13 +3262,387 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const Exp
         _EXPR_THROW("Unknown function: " << f,expr);
     }
 
-    return Py::Object(new QuantityPy(new Quantity(scaler * output, unit)));
+    return Quantity(scaler * output, unit);
+}
+
+Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const ExpressionList &args) 
+{
+    if(!expr || !expr->getOwner())
+        _EXPR_THROW("Invalid owner.", expr);
+
+    if(args.empty())
+        _EXPR_THROW("Function requires at least one argument.",expr);
+
+    // Handle aggregate functions
+    if (f > AGGREGATES)
+        return evalAggregate(expr, f, args);
+
+    switch(f) {
+    case GET_VAR: 
+        if(args.size()<2)
+            _EXPR_THROW("Function expects 2 or 3 arguments.",expr);
+        // fall through
+    case HAS_VAR: {
+        Py::Object value = args[0]->getPyValue();
+        if(!value.isString())
+            _EXPR_THROW("Expects the first argument evaluating to a string.",expr);
+        Py::Object pyobj;
+        bool found = Base::Interpreter().getVariable(value.as_string().c_str(),pyobj);
+        if(f == HAS_VAR)
+            return Py::Boolean(found);
+#if 1
+        // getvar() may pose as a security problem. Disable it for now.
+        __EXPR_THROW(Base::NotImplementedError, "getvar() is disabled.", expr);
+#else
+        if(!found) {
+            if(args.size()==2)
+                return args[1]->getPyValue();
+            _EXPR_THROW("Variable not found.",expr);
+        }
+        return pyobj;
+#endif
+    } case LIST: {
+        if(args.size() == 1 && args[0]->isDerivedFrom(RangeExpression::getClassTypeId()))
+            return args[0]->getPyValue();
+        Py::List list(args.size());
+        int i=0;
+        for(auto &arg : args)
+            list.setItem(i++,arg->getPyValue());
+        return list;
+    } case TUPLE: {
+        if(args.size() == 1 && args[0]->isDerivedFrom(RangeExpression::getClassTypeId()))
+            return Py::Tuple(args[0]->getPyValue());
+        Py::Tuple tuple(args.size());
+        int i=0;
+        for(auto &arg : args)
+            tuple.setItem(i++,arg->getPyValue());
+        return tuple;
+    } case MSCALE: {
+        if(args.size() < 2)
+            _EXPR_THROW("Function requires at least two arguments.",expr);
+        Py::Object pymat = args[0]->getPyValue();
+        Py::Object pyscale;
+        if(PyObject_TypeCheck(pymat.ptr(),&Base::MatrixPy::Type)) {
+            if(args.size() == 2) {
+                Py::Object obj = args[1]->getPyValue();
+                if(obj.isSequence() && PySequence_Size(obj.ptr())==3)
+                    pyscale = Py::Tuple(Py::Sequence(obj));
+            } else if(args.size() == 4) {
+                Py::Tuple tuple(3);
+                tuple.setItem(0,args[1]->getPyValue());
+                tuple.setItem(1,args[2]->getPyValue());
+                tuple.setItem(2,args[3]->getPyValue());
+                pyscale = tuple;
+            }
+        }
+        if(!pyscale.isNone()) {
+            Base::Vector3d vec;
+            if (!PyArg_ParseTuple(pyscale.ptr(), "ddd", &vec.x,&vec.y,&vec.z))
+                PyErr_Clear();
+            else {
+                auto mat = static_cast<Base::MatrixPy*>(pymat.ptr())->value();
+                mat.scale(vec);
+                return Py::Object(new Base::MatrixPy(mat));
+            }
+        }
+        _EXPR_THROW("Function requires arguments to be either "
+                "(matrix,vector) or (matrix,number,number,number).", expr);
+
+    } case MINVERT: {
+        Py::Object pyobj = args[0]->getPyValue();
+        Py::Tuple args;
+        if (PyObject_TypeCheck(pyobj.ptr(),&Base::MatrixPy::Type)) {
+            auto m = static_cast<Base::MatrixPy*>(pyobj.ptr())->value();
+            if (fabs(m.determinant()) <= DBL_EPSILON)
+                _EXPR_THROW("Cannot invert singular matrix.",expr);
+            m.inverseGauss();
+            return Py::Object(new Base::MatrixPy(m));
+
+        } else if (PyObject_TypeCheck(pyobj.ptr(),&Base::PlacementPy::Type)) {
+            const auto &pla = *static_cast<Base::PlacementPy*>(pyobj.ptr())->getPlacementPtr();
+            return Py::Object(new Base::PlacementPy(pla.inverse()));
+
+        } else if (PyObject_TypeCheck(pyobj.ptr(),&Base::RotationPy::Type)) {
+            const auto &rot = *static_cast<Base::RotationPy*>(pyobj.ptr())->getRotationPtr();
+            return Py::Object(new Base::RotationPy(rot.inverse()));
+        }
+        _EXPR_THROW("Function requires the first argument to be either Matrix, Placement or Rotation.",expr);
+
+    } case CREATE: {
+        Py::Object pytype = args[0]->getPyValue();
+        if(!pytype.isString())
+            _EXPR_THROW("Function requires the first argument to be a string.",expr);
+        std::string type(pytype.as_string());
+        Py::Object res;
+        if(boost::iequals(type,"matrix")) 
+            res = Py::Object(new Base::MatrixPy(Base::Matrix4D()));
+        else if(boost::iequals(type,"vector"))
+            res = Py::Object(new Base::VectorPy(Base::Vector3d()));
+        else if(boost::iequals(type,"placement"))
+            res = Py::Object(new Base::PlacementPy(Base::Placement()));
+        else if(boost::iequals(type,"rotation"))
+            res = Py::Object(new Base::RotationPy(Base::Rotation()));
+        else
+            _EXPR_THROW("Unknown type '" << type << "'.",expr);
+        if(args.size()>1) {
+            Py::Tuple tuple(args.size()-1);
+            for(unsigned i=1;i<args.size();++i)
+                tuple.setItem(i-1,args[i]->getPyValue());
+            Py::Dict dict;
+            PyObjectBase::__PyInit(res.ptr(),tuple.ptr(),dict.ptr());
+        }
+        return res;
+
+    } default:
+        break;
+    }
+
+    Py::Object e1 = args[0]->getPyValue();
+    Quantity v1 = pyToQuantity(e1,expr,"Invalid first argument.");
+    Quantity v2;
+    if(args.size()>1)
+        v2 = pyToQuantity(args[1]->getPyValue(),expr,"Invalid second argument.");
+    Quantity v3;
+    if(args.size()>2)
+        v3 = pyToQuantity(args[2]->getPyValue(),expr,"Invalid third argument.");
+
+    return Py::Object(new QuantityPy(new Quantity(calcFunction(
+                        expr, f, v1, args.size()>1?&v2:0, args.size()>2?&v3:0))));
 }
 
 Py::Object FunctionExpression::_getPyValue(int *) const {
     return evaluate(this,f,args);
 }
 
+int FunctionExpression::_compile(ExpressionProgram &program) const {
+    if(f < ACOS || f > CATH || !owner || args.empty() || args.size() > 3)
+        return program.addPython(this);
+    int a[3] = {-1,-1,-1};
+    for(std::size_t i=0; i<args.size(); ++i)
+        a[i] = program.compile(args[i].get());
+    return program.addNode(ExpressionProgram::NodeFunction, this, f, a[0], a[1], a[2]);
+}
+
+NativeValue ExpressionProgram::eval(int index, bool &pyError) const
+{
+    const Node &node = nodes[index];
+    switch(node.type) {
+    case NodeNumber: {
+        const Quantity &q = static_cast<const UnitExpression*>(node.expr)->getQuantity();
+        if(!q.getUnit().isEmpty())
+            return NativeValue(NativeValue::TypeQuantity, q);
+        long l;
+        int i;
+        if(essentiallyInteger(q.getValue(),l,i))
+            return NativeValue(NativeValue::TypeInt, Quantity((double)l));
+        return NativeValue(NativeValue::TypeFloat, q);
+    }
+    case NodeBool:
+        return NativeValue(NativeValue::TypeBool, Quantity(node.op ? 1.0 : 0.0));
+    case NodeVariable:
+        return evalVariable(node, pyError);
+    case NodePython:
+        return evalPython(node.expr, pyError);
+    case NodeOperator:
+        return evalOperator(node, pyError);
+    case NodeConditional:
+        if(eval(node.args[0], pyError).isTrue())
+            return eval(node.args[1], pyError);
+        return eval(node.args[2], pyError);
+    case NodeFunction: {
+        Quantity v[3];
+        for(int i=0; i<node.argCount; ++i)
+            v[i] = eval(node.args[i], pyError).value;
+        return NativeValue(NativeValue::TypeQuantity, calcFunction(node.expr, node.op,
+                    v[0], node.argCount>1?&v[1]:0, node.argCount>2?&v[2]:0));
+    }
+    default:
+        throw NativeFallback();
+    }
+}
+
+// Python float modulo, where the result has the same sign as the divisor
+static double pyFloatMod(double a, double b) {
+    double mod = std::fmod(a, b);
+    if (mod) {
+        if ((b < 0) != (mod < 0))
+            mod += b;
+    } else
+        mod = std::copysign(0.0, b);
+    return mod;
+}
+
+// Python float floor division
+static double pyFloatFloorDiv(double a, double b) {
+    double mod = std::fmod(a, b);
+    double div = (a - mod) / b;
+    if (mod && ((b < 0) != (mod < 0)))
+        div -= 1.0;
+    if (!div)
+        return std::copysign(0.0, a / b);
+    double floordiv = std::floor(div);
+    if (div - floordiv > 0.5)
+        floordiv += 1.0;
+    return floordiv;
+}
+
+NativeValue ExpressionProgram::evalOperator(const Node &node, bool &pyError) const
+{
+    NativeValue l = eval(node.args[0], pyError);
+
+    switch(node.op) {
+    case OP_NOT:
+        return NativeValue(NativeValue::TypeBool, Quantity(l.isTrue() ? 0.0 : 1.0));
+    case OP_AND:
+        if(!l.isTrue())
+            return NativeValue(NativeValue::TypeBool, Quantity(0.0));
+        return NativeValue(NativeValue::TypeBool,
+                Quantity(eval(node.args[1], pyError).isTrue() ? 1.0 : 0.0));
+    case OP_OR:
+        if(l.isTrue())
+            return NativeValue(NativeValue::TypeBool, Quantity(1.0));
+        return NativeValue(NativeValue::TypeBool,
+                Quantity(eval(node.args[1], pyError).isTrue() ? 1.0 : 0.0));
+    case OP_NEG:
+        if(l.isQuantity())
+            return NativeValue(NativeValue::TypeQuantity, l.value * -1.0);
+        return NativeValue(l.type==NativeValue::TypeFloat ? l.type : NativeValue::TypeInt,
+                Quantity(-l.getValue()));
+    case OP_POS:
+        if(l.type == NativeValue::TypeBool)
+            l.type = NativeValue::TypeInt;
+        return l;
+    default:
+        break;
+    }
+
+    NativeValue r = eval(node.args[1], pyError);
+
+    if(l.isQuantity() || r.isQuantity()) {
+        // Same as the number protocol of QuantityPy
+        switch(node.op) {
+        case OP_ADD:
+            return NativeValue(NativeValue::TypeQuantity, l.value + r.value);
+        case OP_SUB:
+            return NativeValue(NativeValue::TypeQuantity, l.value - r.value);
+        case OP_MUL:
+        case OP_UNIT:
+            return NativeValue(NativeValue::TypeQuantity, l.value * r.value);
+        case OP_DIV:
+            return NativeValue(NativeValue::TypeQuantity, l.value / r.value);
+        case OP_MOD:
+            if(!l.isQuantity() || r.getValue() == 0.0)
+                break;
+            return NativeValue(NativeValue::TypeQuantity,
+                    Quantity(pyFloatMod(l.getValue(),r.getValue()), l.value.getUnit()));
+        case OP_POW:
+        case OP_POW2:
+            if(!l.isQuantity())
+                break;
+            if(r.isQuantity())
+                return NativeValue(NativeValue::TypeQuantity, l.value.pow(r.value));
+            return NativeValue(NativeValue::TypeQuantity, l.value.pow(r.getValue()));
+        case OP_EQ:
+        case OP_NE:
+        case OP_LT:
+        case OP_GT:
+        case OP_LE:
+        case OP_GE: {
+            if(!l.isQuantity() || !r.isQuantity())
+                break;
+            bool res;
+            switch(node.op) {
+            case OP_EQ:
+                res = l.value == r.value;
+                break;
+            case OP_NE:
+                res = !(l.value == r.value);
+                break;
+            case OP_LT:
+                res = l.value < r.value;
+                break;
+            case OP_LE:
+                res = (l.value < r.value) || (l.value == r.value);
+                break;
+            case OP_GT:
+                res = !(l.value < r.value) && !(l.value == r.value);
+                break;
+            default:
+                res = !(l.value < r.value);
+                break;
+            }
+            return NativeValue(NativeValue::TypeBool, Quantity(res ? 1.0 : 0.0));
+        }
+        default:
+            break;
+        }
+        throw NativeFallback();
+    }
+
+    double a = l.getValue();
+    double b = r.getValue();
+    bool isInt = l.type != NativeValue::TypeFloat && r.type != NativeValue::TypeFloat;
+    double res;
+    switch(node.op) {
+    case OP_EQ:
+        return NativeValue(NativeValue::TypeBool, Quantity(a == b ? 1.0 : 0.0));
+    case OP_NE:
+        return NativeValue(NativeValue::TypeBool, Quantity(a != b ? 1.0 : 0.0));
+    case OP_LT:
+        return NativeValue(NativeValue::TypeBool, Quantity(a < b ? 1.0 : 0.0));
+    case OP_GT:
+        return NativeValue(NativeValue::TypeBool, Quantity(a > b ? 1.0 : 0.0));
+    case OP_LE:
+        return NativeValue(NativeValue::TypeBool, Quantity(a <= b ? 1.0 : 0.0));
+    case OP_GE:
+        return NativeValue(NativeValue::TypeBool, Quantity(a >= b ? 1.0 : 0.0));
+    case OP_ADD:
+        res = a + b;
+        break;
+    case OP_SUB:
+        res = a - b;
+        break;
+    case OP_MUL:
+    case OP_UNIT:
+        res = a * b;
+        break;
+    case OP_DIV:
+        if(b == 0.0)
+            throw NativeFallback();
+        return NativeValue(NativeValue::TypeFloat, Quantity(a / b));
+    case OP_FDIV:
+        if(b == 0.0 || (isInt && !NativeValue::isExactInt(a)))
+            throw NativeFallback();
+        res = pyFloatFloorDiv(a, b);
+        break;
+    case OP_MOD:
+        if(b == 0.0 || (isInt && !NativeValue::isExactInt(a)))
+            throw NativeFallback();
+        res = pyFloatMod(a, b);
+        break;
+    case OP_POW:
+    case OP_POW2:
+        if(a == 0.0 && b < 0.0)
+            throw NativeFallback();
+        if(isInt && b < 0.0)
+            isInt = false;
+        else if(a < 0.0 && b != std::floor(b))
+            throw NativeFallback();
+        res = std::pow(a, b);
+        if(!isInt && std::isinf(res) && !std::isinf(a) && !std::isinf(b))
+            throw NativeFallback();
+        break;
+    default:
+        throw NativeFallback();
+    }
+    if(isInt) {
+        if(!NativeValue::isExactInt(res))
+            throw NativeFallback();
+        return NativeValue(NativeValue::TypeInt, Quantity(res));
+    }
+    return NativeValue(NativeValue::TypeFloat, Quantity(res));
+}
+
 /**
   * Try to simplify the expression, i.e calculate all constant expressions.
   *
@@ -3356,6 +4015,10 @@ Py::Object VariableExpression::_getPyValue(int *) const {
     return res;
 }
 
+int VariableExpression::_compile(ExpressionProgram &program) const {
+    return program.addNode(ExpressionProgram::NodeVariable, this);
+}
+
 void VariableExpression::addComponent(ComponentPtr &&c) {
     do {
         if(components.size())
@@ -4419,6 +5082,13 @@ Py::Object ConditionalExpression::_getPyValue(int *) const {
         return falseExpr->getPyValue();
 }
 
+int ConditionalExpression::_compile(ExpressionProgram &program) const {
+    int c = program.compile(condition.get());
+    int t = program.compile(trueExpr.get());
+    int f = program.compile(falseExpr.get());
+    return program.addNode(ExpressionProgram::NodeConditional, this, 0, c, t, f);
+}
+
 ExpressionPtr ConditionalExpression::simplify() const
 {
     ExpressionPtr e(condition->simplify());
@@ -4513,6 +5183,16 @@ Py::Object ConstantExpression::_getPyValue(int *) const {
     return Py::Object(cache);
 }
 
+int ConstantExpression::_compile(ExpressionProgram &program) const {
+    if(strcmp(name, "True") == 0)
+        return program.addNode(ExpressionProgram::NodeBool, this, 1);
+    else if(strcmp(name, "False") == 0)
+        return program.addNode(ExpressionProgram::NodeBool, this, 0);
+    else if(strcmp(name, "None") == 0)
+        return program.addPython(this);
+    return NumberExpression::_compile(program);
+}
+
 bool ConstantExpression::isNumber() const {
     return strcmp(name,"None") 
         && strcmp(name,"True") 
@@ -23,6 +23,7 @@
 #ifndef EXPRESSION_H
 #define EXPRESSION_H
 
+#include <memory>
 #include <string>
 #include <boost/pool/pool_alloc.hpp>
 #include <boost/tuple/tuple.hpp>
@@ -45,6 +46,7 @@ namespace App  {
 class DocumentObject;
 class Expression;
 class Document;
+struct ExpressionProgram;
 
 typedef std::unique_ptr<Expression> ExpressionPtr;
 
@@ -165,6 +167,41 @@ public:
     };
     ExpressionPtr eval(int options=0) const;
 
+    /** Helper for evaluating an expression natively in a worker thread
+     *
+     * Only numeric expressions with variables referring directly to numeric
+     * properties can be evaluated this way. The constructor compiles the
+     * expression and resolves the referenced properties, and getResult()
+     * creates the result expression, both of which must be done in the main
+     * thread. run() neither calls into Python nor allocates any expression,
+     * and can therefore be called from a worker thread, provided that the
+     * referenced properties are not modified at the same time.
+     */
+    class AppExport NativeEvaluation {
+    public:
+        NativeEvaluation(const Expression *expr=0);
+
+        /// Return true if the expression can be evaluated natively
+        bool isValid() const {return !!program;}
+
+        /// Evaluate the expression, return false on error
+        bool run();
+
+        /** Return the result as a NumberExpression or ConstantExpression, or
+         * null if run() failed, in which case the error can be reported by
+         * calling eval().
+         */
+        ExpressionPtr getResult() const;
+
+    private:
+        const Expression *expr;
+        std::shared_ptr<ExpressionProgram> program;
+        std::vector<Property*> props;
+        Base::Quantity value;
+        bool isBool = false;
+        bool done = false;
+    };
+
     App::any getValueAsAny(int options=0) const;
 
     Py::Object getPyValue(int options=0, int *jumpCode=0) const;
@@ -284,17 +321,24 @@ protected:
     virtual void _moveCells(const CellAddress &, int, int, ExpressionVisitor &) {}
     virtual void _offsetCells(int, int, ExpressionVisitor &) {}
     virtual Py::Object _getPyValue(int *jumpCode=0) const = 0;
+    virtual int _compile(ExpressionProgram &program) const;
     virtual void _visit(ExpressionVisitor &) {}
 
     void swapComponents(Expression &other) {components.swap(other.components);}
 
     friend ExpressionVisitor;
+    friend struct ExpressionProgram;
 
 protected:
     App::DocumentObject * owner; /**< The document object used to access unqualified variables (i.e local scope) */
 
     ComponentList components;
 
+    /** Natively compiled form of this expression for evaluating numeric
+     * expressions without going through Python. Created on first evaluation.
+     */
+    mutable std::shared_ptr<ExpressionProgram> program;
+
 public:
     std::string comment;
 };
@@ -148,6 +148,7 @@ protected:
     virtual void _toString(std::ostream &ss, bool persistent, int indent) const;
     virtual ExpressionPtr _copy() const;
     virtual Py::Object _getPyValue(int *jumpCode=0) const;
+    virtual int _compile(ExpressionProgram &program) const;
 
 protected:
     mutable PyObject *cache = 0;
@@ -198,6 +199,7 @@ protected:
     {}
 
     virtual Py::Object _getPyValue(int *jumpCode=0) const;
+    virtual int _compile(ExpressionProgram &program) const;
     virtual void _toString(std::ostream &ss, bool persistent, int indent) const;
     virtual ExpressionPtr _copy() const;
 
@@ -250,6 +252,7 @@ protected:
     virtual void _moveCells(const CellAddress &, int, int, ExpressionVisitor &);
     virtual void _offsetCells(int, int, ExpressionVisitor &);
     virtual Py::Object _getPyValue(int *jumpCode=0) const;
+    virtual int _compile(ExpressionProgram &program) const;
 
 protected:
     ObjectIdentifier var; /**< Variable name  */
@@ -396,6 +399,7 @@ protected:
     virtual void _toString(std::ostream &ss, bool persistent, int indent) const;
     virtual ExpressionPtr _copy() const;
     virtual Py::Object _getPyValue(int *jumpCode=0) const;
+    virtual int _compile(ExpressionProgram &program) const;
 
     virtual bool isCommutative() const;
 
@@ -462,6 +466,7 @@ protected:
     virtual void _toString(std::ostream &ss, bool persistent, int indent) const;
     virtual ExpressionPtr _copy() const;
     virtual Py::Object _getPyValue(int *jumpCode=0) const;
+    virtual int _compile(ExpressionProgram &program) const;
 
     ExpressionPtr condition;  /**< Condition */
     ExpressionPtr trueExpr;  /**< Expression if abs(condition) is > 0.5 */
@@ -494,6 +499,7 @@ protected:
     virtual void _toString(std::ostream &ss, bool persistent, int indent) const;
     virtual ExpressionPtr _copy() const;
     virtual Py::Object _getPyValue(int *jumpCode=0) const;
+    virtual int _compile(ExpressionProgram &program) const;
     static Py::Object evalAggregate(const Expression *owner, int type, const ExpressionList &args);
 
     int f;        /**< Function to execute */
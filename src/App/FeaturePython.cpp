@@ -307,6 +307,10 @@ bool FeaturePythonImp::getSubObjects(std::vector<std::string> &ret, int reason)
     }
 }
 
+bool FeaturePythonImp::hasSubObject() const {
+    return !py_getSubObject.isNone() || !py_getLinkedObject.isNone();
+}
+
 bool FeaturePythonImp::getLinkedObject(DocumentObject *&ret, bool recurse, 
         Base::Matrix4D *_mat, bool transform, int depth) const
 {
@@ -59,6 +59,9 @@ public:
 
     bool getSubObjects(std::vector<std::string> &ret, int reason) const;
 
+    /// Return true if the proxy customizes sub-object or linked object resolution
+    bool hasSubObject() const;
+
     bool getLinkedObject(App::DocumentObject *&ret, bool recurse, 
             Base::Matrix4D *mat, bool transform, int depth) const;
 
@@ -279,6 +282,11 @@ public:
         return FeatureT::canLoadPartial();
     }
 
+    /// The proxy is called from execute(), which needs the Python interpreter
+    virtual bool isRecomputeThreadSafe() const override {
+        return false;
+    }
+
     PyObject *getPyObject(void) {
         if (FeatureT::PythonObject.is(Py::_None())) {
             // ref counter is set to 1
@@ -305,6 +313,9 @@ protected:
     virtual void onChanged(const Property* prop) {
         if(prop == &Proxy)
             imp->init(Proxy.getValue().ptr());
+        // The proxy may customize getSubObject() using any property
+        if(prop == &Proxy || imp->hasSubObject())
+            DocumentObject::invalidateSubObjectCache();
         imp->onChanged(prop);
         FeatureT::onChanged(prop);
     }
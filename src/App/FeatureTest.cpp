@@ -29,7 +29,9 @@
 #include <Base/Console.h>
 #include <Base/Exception.h>
 #include <Base/Unit.h>
+#include "Document.h"
 #include "FeatureTest.h"
+#include "StringHasher.h"
 #include "Material.h"
 #include "Material.h"
 
@@ -96,6 +98,7 @@ FeatureTest::FeatureTest()
   ADD_PROPERTY_TYPE(ExecResult    ,("empty"),group,Prop_None,"Result of the execution");
   ADD_PROPERTY_TYPE(ExceptionType ,(0),group,Prop_None,"The type of exception the execution method throws");
   ADD_PROPERTY_TYPE(ExecCount     ,(0),group,Prop_None,"Number of executions");
+  ADD_PROPERTY_TYPE(HashCount     ,(0),group,Prop_None,"Number of strings the execution maps with the document string hasher");
   
   // properties with types
   ADD_PROPERTY_TYPE(TypeHidden  ,(4711),group,Prop_Hidden,"An example property which has the type 'Hidden'"  );
@@ -177,6 +180,16 @@ doc.recompute()
 #endif
     }
 
+    // Strings shared by all test features, to test concurrent use of the
+    // string hasher in parallel recompute. Start at a different string in
+    // each feature to mix lookups of existing strings with insertions.
+    int count = HashCount.getValue();
+    for(int n=0;n<count;++n) {
+        std::string text("FeatureTestHash");
+        text += std::to_string((n+getID())%count);
+        getDocument()->Hasher->getID(text.c_str(),(int)text.size());
+    }
+
     ExecCount.setValue(ExecCount.getValue() + 1);
 
     ExecResult.setValue("Exec");
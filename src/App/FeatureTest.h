@@ -90,6 +90,7 @@ public:
   App::PropertyString   ExecResult;
   App::PropertyInteger  ExceptionType;
   App::PropertyInteger  ExecCount;
+  App::PropertyInteger  HashCount;
   
   App::PropertyInteger   TypeHidden;
   App::PropertyInteger   TypeReadOnly;
@@ -108,6 +109,10 @@ public:
   virtual short mustExecute(void) const;
   /// recalculate the Feature
   virtual DocumentObjectExecReturn *execute(void);
+  /// execute() only touches its own properties
+  virtual bool isRecomputeThreadSafe() const {
+    return true;
+  }
   /// returns the type name of the ViewProvider
   //FIXME: Probably it makes sense to have a view provider for unittests (e.g. Gui::ViewProviderTest)
   virtual const char* getViewProviderName(void) const {
@@ -106,6 +106,7 @@ void LinkBaseExtension::setProperty(int idx, Property *prop) {
 
     if(props[idx]) {
         props[idx]->setStatus(Property::LockDynamic,false);
+        props[idx]->setStatus(Property::AffectSubObject,false);
         props[idx] = 0;
     }
     if(!prop) 
@@ -121,6 +122,10 @@ void LinkBaseExtension::setProperty(int idx, Property *prop) {
     props[idx] = prop;
     props[idx]->setStatus(Property::LockDynamic,true);
 
+    // All but the following properties are used by extensionGetSubObject()
+    if(idx!=PropLinkMode && idx!=PropVisibilityList)
+        props[idx]->setStatus(Property::AffectSubObject,true);
+
     switch(idx) {
     case PropLinkMode: {
         static const char *linkModeEnums[] = {"None","Auto Delete","Auto Link","Auto Unlink",0};
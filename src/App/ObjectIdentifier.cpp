@@ -28,6 +28,7 @@
 
 #include <limits>
 #include <iomanip>
+#include <atomic>
 
 #include <boost/algorithm/string/predicate.hpp>
 
@@ -48,6 +49,11 @@
 
 FC_LOG_LEVEL_INIT("Expression",true,true)
 
+// Generation counter of object identifier resolution. Bumped by
+// ObjectIdentifier::invalidateResolveCache() to invalidate all cached
+// ResolveResults.
+static std::atomic<unsigned long> _ResolveGeneration(1);
+
 using namespace App;
 using namespace Base;
 
@@ -176,11 +182,11 @@ ObjectIdentifier::ObjectIdentifier(const Property &prop, int index)
 
 std::string App::ObjectIdentifier::getPropertyName() const
 {
-    ResolveResults result(*this);
+    auto result = getResolveResults();
 
-    assert(result.propertyIndex >=0 && static_cast<std::size_t>(result.propertyIndex) < components.size());
+    assert(result->propertyIndex >=0 && static_cast<std::size_t>(result->propertyIndex) < components.size());
 
-    return components[result.propertyIndex].getName();
+    return components[result->propertyIndex].getName();
 }
 
 /**
@@ -191,19 +197,22 @@ std::string App::ObjectIdentifier::getPropertyName() const
 
 const App::ObjectIdentifier::Component &App::ObjectIdentifier::getPropertyComponent(int i) const
 {
-    ResolveResults result(*this);
+    auto result = getResolveResults();
 
-    assert(result.propertyIndex + i >=0 && static_cast<std::size_t>(result.propertyIndex) + i < components.size());
+    assert(result->propertyIndex + i >=0 && static_cast<std::size_t>(result->propertyIndex) + i < components.size());
 
-    return components[result.propertyIndex + i];
+    return components[result->propertyIndex + i];
 }
 
 App::ObjectIdentifier::Component &App::ObjectIdentifier::getPropertyComponent(int i)
 {
-    ResolveResults result(*this);
-    assert(result.propertyIndex + i >=0 && 
-            static_cast<std::size_t>(result.propertyIndex) + i < components.size());
-    return components[result.propertyIndex + i];
+    auto result = getResolveResults();
+    assert(result->propertyIndex + i >=0 && 
+            static_cast<std::size_t>(result->propertyIndex) + i < components.size());
+    // The caller may modify the returned component
+    _cache.clear();
+    _resolveCache.reset();
+    return components[result->propertyIndex + i];
 }
 
 std::vector<ObjectIdentifier::Component> ObjectIdentifier::getPropertyComponents() const {
@@ -271,9 +280,9 @@ int ObjectIdentifier::numComponents() const
 
 int ObjectIdentifier::numSubComponents() const
 {
-    ResolveResults result(*this);
+    auto result = getResolveResults();
 
-    return components.size() - result.propertyIndex;
+    return components.size() - result->propertyIndex;
 }
 
 bool ObjectIdentifier::verify(const App::Property &prop, bool silent) const {
@@ -440,6 +449,7 @@ bool ObjectIdentifier::replaceObject(ObjectIdentifier &res, const App::DocumentO
     }
     res.subObjectName = String(r.second,true);
     res._cache.clear();
+    res._resolveCache.reset();
     res.shadowSub.first.clear();
     res.shadowSub.second.clear();
     return true;
@@ -469,6 +479,7 @@ bool ObjectIdentifier::updateLabelReference(
         if(sub.size()) {
             subObjectName = String(sub,true);
             _cache.clear();
+            _resolveCache.reset();
             return true;
         }
     }
@@ -490,6 +501,8 @@ bool ObjectIdentifier::updateLabelReference(
         documentObjectName = ObjectIdentifier::String(newLabel, true);
 
         _cache.clear();
+
+        _resolveCache.reset();
         return true;
     }
 
@@ -500,6 +513,7 @@ bool ObjectIdentifier::updateLabelReference(
     {
         components[0].name = ObjectIdentifier::String(newLabel, true);
         _cache.clear();
+        _resolveCache.reset();
         return true;
     }
 
@@ -514,6 +528,7 @@ bool ObjectIdentifier::updateLabelReference(
         if (result.propertyIndex == 1 && result.resolvedDocumentObject == obj) {
             components[0].name = id.components[0].name;
             _cache.clear();
+            _resolveCache.reset();
             return true;
         }
     }
@@ -528,6 +543,7 @@ bool ObjectIdentifier::relabeledDocument(ExpressionVisitor &v,
         v.aboutToChange();
         documentName = String(newLabel,true);
         _cache.clear();
+        _resolveCache.reset();
         return true;
     }
     return false;
@@ -1044,9 +1060,9 @@ DocumentObject *ObjectIdentifier::getDocumentObject() const
     if (!doc)
         return 0;
 
-    ResolveResults result(*this);
+    auto result = getResolveResults();
 
-    return getDocumentObject(doc, result.resolvedDocumentObjectName, dummy);
+    return getDocumentObject(doc, result->resolvedDocumentObjectName, dummy);
 }
 
 
@@ -1069,31 +1085,31 @@ enum PseudoPropertyType {
 };
 
 std::pair<DocumentObject*,std::string> ObjectIdentifier::getDep(std::vector<std::string> *labels) const {
-    ResolveResults result(*this);
+    auto result = getResolveResults();
     if(labels) {
         if(documentObjectName.getString().size()) {
             if(documentObjectName.isRealString())
                 labels->push_back(documentObjectName.getString());
-        } else if(result.propertyIndex == 1)
+        } else if(result->propertyIndex == 1)
             labels->push_back(components[0].name.getString());
         if(subObjectName.getString().size()) 
             PropertyLinkBase::getLabelReferences(*labels,subObjectName.getString().c_str());
     }
     if(subObjectName.getString().empty()) {
-        if(result.propertyType==PseudoNone) {
+        if(result->propertyType==PseudoNone) {
             CellAddress addr;
-            if(addr.parseAbsoluteAddress(result.propertyName.c_str())) 
-                return std::make_pair(result.resolvedDocumentObject,addr.toString(true));
-            return std::make_pair(result.resolvedDocumentObject,result.propertyName);
-        }else if(result.propertyType == PseudoSelf
-                    && result.resolvedDocumentObject
-                    && result.propertyIndex+1 < (int)components.size())
+            if(addr.parseAbsoluteAddress(result->propertyName.c_str())) 
+                return std::make_pair(result->resolvedDocumentObject,addr.toString(true));
+            return std::make_pair(result->resolvedDocumentObject,result->propertyName);
+        }else if(result->propertyType == PseudoSelf
+                    && result->resolvedDocumentObject
+                    && result->propertyIndex+1 < (int)components.size())
         {
-            return std::make_pair(result.resolvedDocumentObject,
-                    components[result.propertyIndex+1].getName());
+            return std::make_pair(result->resolvedDocumentObject,
+                    components[result->propertyIndex+1].getName());
         }
     }
-    return std::make_pair(result.resolvedDocumentObject,std::string());
+    return std::make_pair(result->resolvedDocumentObject,std::string());
 }
 
 /**
@@ -1174,9 +1190,9 @@ ObjectIdentifier ObjectIdentifier::parse(const DocumentObject *docObj, const std
 
 std::string ObjectIdentifier::resolveErrorString() const
 {
-    ResolveResults result(*this);
+    auto result = getResolveResults();
 
-    return result.resolveErrorString();
+    return result->resolveErrorString();
 }
 
 /**
@@ -1189,6 +1205,7 @@ ObjectIdentifier &ObjectIdentifier::operator <<(const ObjectIdentifier::Componen
 {
     components.push_back(value);
     _cache.clear();
+    _resolveCache.reset();
     return *this;
 }
 
@@ -1196,6 +1213,7 @@ ObjectIdentifier &ObjectIdentifier::operator <<(ObjectIdentifier::Component &&va
 {
     components.push_back(std::move(value));
     _cache.clear();
+    _resolveCache.reset();
     return *this;
 }
 
@@ -1207,10 +1225,21 @@ ObjectIdentifier &ObjectIdentifier::operator <<(ObjectIdentifier::Component &&va
 
 Property *ObjectIdentifier::getProperty(int *ptype) const
 {
-    ResolveResults result(*this);
+    auto result = getResolveResults();
     if(ptype)
-        *ptype = result.propertyType;
-    return result.resolvedProperty;
+        *ptype = result->propertyType;
+    return result->resolvedProperty;
+}
+
+Property *ObjectIdentifier::getDirectProperty() const
+{
+    auto result = getResolveResults();
+    if(!result->resolvedProperty
+            || result->propertyType!=PseudoNone
+            || result->propertyIndex+1!=(int)components.size()
+            || !components[result->propertyIndex].isSimple())
+        return 0;
+    return result->resolvedProperty;
 }
 
 Property *ObjectIdentifier::resolveProperty(const App::DocumentObject *obj, 
@@ -1289,6 +1318,7 @@ ObjectIdentifier ObjectIdentifier::canonicalPath() const
     if(result.resolvedDocumentObject && result.resolvedDocumentObject!=owner) {
         res.owner = result.resolvedDocumentObject;
         res._cache.clear();
+        res._resolveCache.reset();
     }
     res.resolveAmbiguity(result);
     if(!result.resolvedProperty || result.propertyType!=PseudoNone)
@@ -1323,6 +1353,7 @@ void ObjectIdentifier::setDocumentName(ObjectIdentifier::String &&name, bool for
         force = false;
     documentNameSet = force;
     _cache.clear();
+    _resolveCache.reset();
     if(name.getString().size() && _DocumentMap) {
         if(name.isRealString()) {
             auto iter = _DocumentMap->find(name.toString());
@@ -1377,6 +1408,8 @@ void ObjectIdentifier::setDocumentObjectName(ObjectIdentifier::String &&name, bo
     subObjectName = std::move(subname);
 
     _cache.clear();
+
+    _resolveCache.reset();
 }
 
 void ObjectIdentifier::setDocumentObjectName(const App::DocumentObject *obj, bool force,
@@ -1411,6 +1444,8 @@ void ObjectIdentifier::setDocumentObjectName(const App::DocumentObject *obj, boo
     subObjectName = std::move(subname);
 
     _cache.clear();
+
+    _resolveCache.reset();
 }
 
 
@@ -1657,25 +1692,25 @@ Py::Object ObjectIdentifier::access(const ResolveResults &result, Py::Object *va
 
 App::any ObjectIdentifier::getValue(bool pathValue, bool *isPseudoProperty) const
 {
-    ResolveResults rs(*this);
+    auto rs = getResolveResults();
 
     if(isPseudoProperty) {
-        *isPseudoProperty = rs.propertyType!=PseudoNone;
-        if(rs.propertyType == PseudoSelf
+        *isPseudoProperty = rs->propertyType!=PseudoNone;
+        if(rs->propertyType == PseudoSelf
                 && isLocalProperty()
-                && rs.propertyIndex+1 < (int)components.size()
-                && owner->getPropertyByName(components[rs.propertyIndex+1].getName().c_str()))
+                && rs->propertyIndex+1 < (int)components.size()
+                && owner->getPropertyByName(components[rs->propertyIndex+1].getName().c_str()))
         {
             *isPseudoProperty = false;
         }
     }
 
-    if(rs.resolvedProperty && rs.propertyType==PseudoNone && pathValue)
-        return rs.resolvedProperty->getPathValue(*this);
+    if(rs->resolvedProperty && rs->propertyType==PseudoNone && pathValue)
+        return rs->resolvedProperty->getPathValue(*this);
 
     Base::PyGILStateLocker lock;
     try {
-        return pyObjectToAny(access(rs));
+        return pyObjectToAny(access(*rs));
     }catch(Py::Exception &) {
         Base::PyException::ThrowException();
     }
@@ -1684,27 +1719,27 @@ App::any ObjectIdentifier::getValue(bool pathValue, bool *isPseudoProperty) cons
 
 Py::Object ObjectIdentifier::getPyValue(bool pathValue, bool *isPseudoProperty) const
 {
-    ResolveResults rs(*this);
+    auto rs = getResolveResults();
 
     if(isPseudoProperty) {
-        *isPseudoProperty = rs.propertyType!=PseudoNone;
-        if(rs.propertyType == PseudoSelf
+        *isPseudoProperty = rs->propertyType!=PseudoNone;
+        if(rs->propertyType == PseudoSelf
                 && isLocalProperty()
-                && rs.propertyIndex+1 < (int)components.size()
-                && owner->getPropertyByName(components[rs.propertyIndex+1].getName().c_str()))
+                && rs->propertyIndex+1 < (int)components.size()
+                && owner->getPropertyByName(components[rs->propertyIndex+1].getName().c_str()))
         {
             *isPseudoProperty = false;
         }
     }
 
-    if(rs.resolvedProperty && rs.propertyType==PseudoNone && pathValue) {
+    if(rs->resolvedProperty && rs->propertyType==PseudoNone && pathValue) {
         Py::Object res;
-        if(rs.resolvedProperty->getPyPathValue(*this,res))
+        if(rs->resolvedProperty->getPyPathValue(*this,res))
             return res;
     }
 
     try {
-        return access(rs);
+        return access(*rs);
     }catch(Py::Exception &) {
         Base::PyException::ThrowException();
     }
@@ -1769,6 +1804,7 @@ void ObjectIdentifier::importSubNames(const ObjectIdentifier::SubNameMap &subNam
         else
             documentObjectName.str = obj->getNameInDocument();
         _cache.clear();
+        _resolveCache.reset();
     }
     if(subObjectName.getString().empty())
         return;
@@ -1778,6 +1814,7 @@ void ObjectIdentifier::importSubNames(const ObjectIdentifier::SubNameMap &subNam
         return;
     subObjectName = String(it->second,true);
     _cache.clear();
+    _resolveCache.reset();
     shadowSub.first.clear();
     shadowSub.second.clear();
 }
@@ -1795,6 +1832,7 @@ bool ObjectIdentifier::updateElementReference(ExpressionVisitor &v,
     if(v.getPropertyLink()->_updateElementReference(
             feature,result.resolvedDocumentObject,subObjectName.str,shadowSub,reverse)) {
         _cache.clear();
+        _resolveCache.reset();
         v.aboutToChange();
         return true;
     }
@@ -1813,6 +1851,7 @@ bool ObjectIdentifier::adjustLinks(ExpressionVisitor &v, const std::set<App::Doc
             documentObjectName = String(prop.getValue()->getNameInDocument(),false,true);
             subObjectName = String(prop.getSubValues().front(),true);
             _cache.clear();
+            _resolveCache.reset();
             return true;
         }
     }
@@ -1880,10 +1919,43 @@ ObjectIdentifier::ResolveResults::ResolveResults(const ObjectIdentifier &oi)
     , resolvedProperty(0)
     , propertyName()
     , propertyType(PseudoNone)
+    , generation(_ResolveGeneration)
 {
     oi.resolve(*this);
 }
 
+void ObjectIdentifier::invalidateResolveCache()
+{
+    ++_ResolveGeneration;
+}
+
+unsigned long ObjectIdentifier::getResolveGeneration()
+{
+    return _ResolveGeneration;
+}
+
+std::shared_ptr<const ObjectIdentifier::ResolveResults> ObjectIdentifier::getResolveResults() const
+{
+    auto res = std::atomic_load(&_resolveCache);
+    if(res && res->generation == _ResolveGeneration)
+        return res;
+
+    res = std::make_shared<const ResolveResults>(*this);
+
+    // Only cache result that depends solely on the document, object, label
+    // and property look up, which are tracked by the generation counter. Sub
+    // object and linked property resolution depend on link properties and
+    // are therefore always resolved on demand.
+    if(subObjectName.getString().empty()
+            && res->resolvedProperty
+            && (res->propertyType != PseudoNone
+                || res->resolvedProperty->getContainer() == res->resolvedDocumentObject))
+    {
+        std::atomic_store(&_resolveCache, res);
+    }
+    return res;
+}
+
 std::string ObjectIdentifier::ResolveResults::resolveErrorString() const
 {
     std::ostringstream ss;
@@ -244,6 +244,7 @@ public:
         localProperty = other.localProperty;
         _cache = std::move(other._cache);
         _hash = std::move(other._hash);
+        _resolveCache = std::move(other._resolveCache);
         return *this;
     }
 
@@ -255,12 +256,14 @@ public:
     void addComponent(const Component &c) { 
         components.push_back(c);
         _cache.clear();
+        _resolveCache.reset();
     }
 
     // Components
     void addComponent(Component &&c) { 
         components.push_back(std::move(c));
         _cache.clear();
+        _resolveCache.reset();
     }
 
     std::string getPropertyName() const;
@@ -288,6 +291,12 @@ public:
 
     App::Property *getProperty(int *ptype=0) const;
 
+    /** Return the property if this identifier refers directly to the value of
+     * a normal (i.e. non pseudo) property without any further sub path,
+     * or null otherwise.
+     */
+    App::Property *getDirectProperty() const;
+
     App::ObjectIdentifier canonicalPath() const;
 
     // Document-centric functions
@@ -369,6 +378,17 @@ public:
 
     std::size_t hash() const;
 
+    /** Invalidate the cached resolution of all object identifiers
+     *
+     * Must be called whenever an object path may resolve differently, e.g.
+     * on adding, removing or renaming document, object, or dynamic property,
+     * and on changing object or document label.
+     */
+    static void invalidateResolveCache();
+
+    /// Return the current generation of the resolve cache
+    static unsigned long getResolveGeneration();
+
 protected:
 
     struct ResolveResults {
@@ -386,6 +406,7 @@ protected:
         std::string propertyName;
         int propertyType;
         std::bitset<32> flags;
+        unsigned long generation;
 
         std::string resolveErrorString() const;
         void getProperty(const ObjectIdentifier &oi);
@@ -403,6 +424,9 @@ protected:
     void resolve(ResolveResults & results) const;
     void resolveAmbiguity(ResolveResults &results);
 
+    /// Return the resolved results, reuse the cached one if still valid
+    std::shared_ptr<const ResolveResults> getResolveResults() const;
+
     static App::DocumentObject *getDocumentObject(
             const App::Document *doc, const String &name, std::bitset<32> &flags);
 
@@ -419,6 +443,7 @@ protected:
 private:
     std::string _cache; // Cached string represstation of this identifier
     std::size_t _hash; // Cached hash of this string
+    mutable std::shared_ptr<const ResolveResults> _resolveCache; // Cached resolution of this identifier
 };
 
 inline std::size_t hash_value(const App::ObjectIdentifier & path) {
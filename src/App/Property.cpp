@@ -25,6 +25,8 @@
 
 #ifndef _PreComp_
 #	include <cassert>
+#	include <cstring>
+#	include <sstream>
 #endif
 
 #include <boost/algorithm/string/predicate.hpp>
@@ -161,7 +163,7 @@ ObjectIdentifier Property::canonicalPath(const ObjectIdentifier &p) const
 
 void Property::touch()
 {
-    if (father)
+    if (father && father->checkBulkChange(this))
         father->onChanged(this);
     StatusBits.set(Touched);
 }
@@ -173,14 +175,14 @@ void Property::setReadOnly(bool readOnly)
 
 void Property::hasSetValue(void)
 {
-    if (father)
+    if (father && father->checkBulkChange(this))
         father->onChanged(this);
     StatusBits.set(Touched);
 }
 
 void Property::aboutToSetValue(void)
 {
-    if (father)
+    if (father && father->checkBulkBeforeChange(this))
         father->onBeforeChange(this);
 }
 
@@ -286,6 +288,57 @@ void PropertyListsBase::_setPyObject(PyObject *value) {
     setPyValues(vals,indices);
 }
 
+static int _bufferItemType(const Py_buffer &buf) {
+    const char *format = buf.format ? buf.format : "B";
+    if (format[0] == '@' || format[0] == '=' || format[0] == '<')
+        ++format;
+    if (buf.itemsize == sizeof(double) && strcmp(format, "d") == 0)
+        return 'd';
+    if (buf.itemsize == sizeof(float) && strcmp(format, "f") == 0)
+        return 'f';
+    return 0;
+}
+
+bool PropertyListsBase::DoubleBuffer::check(PyObject *value) {
+    if (!PyObject_CheckBuffer(value))
+        return false;
+    Py_buffer view;
+    if (PyObject_GetBuffer(value, &view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) < 0) {
+        // Not a contiguous buffer, let the caller try it as a sequence
+        PyErr_Clear();
+        return false;
+    }
+    bool res = _bufferItemType(view) != 0;
+    PyBuffer_Release(&view);
+    return res;
+}
+
+PropertyListsBase::DoubleBuffer::DoubleBuffer(PyObject *value, std::size_t columns) {
+    if (PyObject_GetBuffer(value, &buf, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) < 0)
+        throw Py::Exception();
+    int type = _bufferItemType(buf);
+    if (!type) {
+        PyBuffer_Release(&buf);
+        throw Base::TypeError("Expect a buffer of float or double");
+    }
+    std::size_t size = buf.len / buf.itemsize;
+    if (size % columns) {
+        PyBuffer_Release(&buf);
+        std::ostringstream ss;
+        ss << "Expect a buffer of " << columns << " numbers per item";
+        throw Base::ValueError(ss.str());
+    }
+    count = size / columns;
+    if (type == 'f') {
+        const float *data = static_cast<const float*>(buf.buf);
+        converted.assign(data, data + size);
+    }
+}
+
+PropertyListsBase::DoubleBuffer::~DoubleBuffer() {
+    PyBuffer_Release(&buf);
+}
+
 //**************************************************************************
 //**************************************************************************
 // PropertyLists
@@ -320,6 +373,9 @@ void PropertyLists::Save (Base::Writer &writer) const
         writer.Stream() << writer.ind() << '<' << element << " count=\"" <<  getSize() <<"\" ";
         if(!saveXML(writer))
             writer.Stream() << writer.ind() << "</" << element << ">\n";
+    } else if (writer.isBinaryStream()) {
+        writer.Stream() << writer.ind() << '<' << element << " bin=\""
+            << writer.addBinaryRecord(this) << "\"/>\n";
     } else {
         writer.Stream() << writer.ind() << '<' << element << " file=\"" 
             << writer.addFile(getFileName(writer.isPreferBinary()?".bin":".txt"), this) 
@@ -334,6 +390,8 @@ void PropertyLists::Restore(Base::XMLReader &reader)
     if (!file.empty()) {
         // initiate a file read
         reader.addFile(file.c_str(),this);
+    }else if(reader.hasAttribute("bin")) {
+        reader.addBinaryRecord(reader.getAttributeAsUnsigned("bin"),this);
     }else if(reader.hasAttribute("count")) {
         restoreXML(reader);
     }else if(getSize()) {
@@ -84,6 +84,9 @@ public:
                       // relevant for the container using it
         EvalOnRestore = 14, // In case of expression binding, evaluate the
                             // expression on restore and touch the object on value change.
+        AffectSubObject = 15, // Changing the property may change the result of
+                              // getSubObject() of its container, which invalidates
+                              // DocumentObject::getSubObjectCached()
 
         // The following bits are corresponding to PropertyType set when the
         // property added. These types are meant to be static, and cannot be
@@ -237,6 +240,16 @@ public:
     /// Paste the value from the property (mainly for Undo/Redo and transactions)
     virtual void Paste(const Property &from) = 0;
 
+    /** Check if the property value can be fully saved and restored through
+     * SaveDocFile() and RestoreDocFile(), without a container
+     *
+     * Large values of such property are kept compressed in the undo/redo
+     * stack.
+     */
+    virtual bool isDocFileSelfContained() const {
+        return false;
+    }
+
     /// Called when a child property has changed value
     virtual void hasSetChildValue(Property &) {}
     /// Called before a child property changing value
@@ -397,6 +410,46 @@ protected:
 
     void _setPyObject(PyObject *);
 
+    /** Helper class to access a Python buffer of double items
+     *
+     * Used by list properties to accept e.g. a NumPy array as value without
+     * converting each item to a Python object.
+     */
+    class AppExport DoubleBuffer {
+    public:
+        /** Constructor
+         *
+         * @param value: the Python object supporting the buffer protocol
+         * @param columns: number of doubles per list item
+         *
+         * Throws Base::TypeError if the buffer is not made of float or
+         * double, or Base::ValueError if its size is not a multiple of
+         * \a columns. A buffer of float is converted to double.
+         */
+        DoubleBuffer(PyObject *value, std::size_t columns);
+        ~DoubleBuffer();
+
+        /** Check if the object can be accessed through DoubleBuffer
+         *
+         * Returns true only for a contiguous buffer of float or double.
+         * Any other object should be treated as a sequence.
+         */
+        static bool check(PyObject *value);
+
+        const double *data() const {
+            return converted.empty() ? static_cast<const double*>(buf.buf) : &converted[0];
+        }
+        /// Number of list items in the buffer
+        std::size_t rows() const {
+            return count;
+        }
+
+    private:
+        Py_buffer buf;
+        std::size_t count;
+        std::vector<double> converted;
+    };
+
 protected:
     std::set<int> _touchList;
 };
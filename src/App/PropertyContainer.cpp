@@ -29,6 +29,9 @@
 # include <functional>
 #endif
 
+#include <exception>
+#include <unordered_set>
+
 /// Here the FreeCAD includes sorted by Base,App,Gui......
 #include <Base/Reader.h>
 #include <Base/Writer.h>
@@ -63,6 +66,100 @@ PropertyContainer::~PropertyContainer()
 
 }
 
+//**************************************************************************
+// Bulk property change
+
+struct PropertyContainer::BulkChangeData
+{
+    int depth = 0;
+    // properties with onBeforeChange() called
+    std::unordered_set<const Property*> beforeChanged;
+    // properties with deferred onChanged() in the order of change
+    std::vector<const Property*> changed;
+    std::unordered_set<const Property*> changedSet;
+};
+
+void PropertyContainer::beginBulkChange()
+{
+    if(!_bulkChange)
+        _bulkChange.reset(new BulkChangeData);
+    ++_bulkChange->depth;
+}
+
+void PropertyContainer::endBulkChange()
+{
+    if(!_bulkChange || --_bulkChange->depth > 0)
+        return;
+
+    // Reset before notification, so that any further change made inside
+    // onChanged() is signaled normally.
+    std::unique_ptr<BulkChangeData> data(std::move(_bulkChange));
+
+    std::exception_ptr error;
+    for(auto prop : data->changed) {
+        try {
+            onChanged(prop);
+        } catch(...) {
+            if(!error)
+                error = std::current_exception();
+        }
+    }
+    if(error)
+        std::rethrow_exception(error);
+}
+
+bool PropertyContainer::checkBulkBeforeChange(const Property *prop)
+{
+    return !_bulkChange || _bulkChange->beforeChanged.insert(prop).second;
+}
+
+bool PropertyContainer::checkBulkChange(const Property *prop)
+{
+    if(!_bulkChange)
+        return true;
+    if(_bulkChange->changedSet.insert(prop).second)
+        _bulkChange->changed.push_back(prop);
+    return false;
+}
+
+void PropertyContainer::removeBulkChange(const Property *prop)
+{
+    if(!_bulkChange || !prop)
+        return;
+    _bulkChange->beforeChanged.erase(prop);
+    if(_bulkChange->changedSet.erase(prop)) {
+        auto &changed = _bulkChange->changed;
+        changed.erase(std::remove(changed.begin(), changed.end(), prop), changed.end());
+    }
+}
+
+PropertyContainer::BulkChange::BulkChange(PropertyContainer &c)
+    :container(&c)
+{
+    container->beginBulkChange();
+}
+
+PropertyContainer::BulkChange::~BulkChange()
+{
+    if(!container)
+        return;
+    // Must make sure to not throw in a destructor
+    try {
+        container->endBulkChange();
+    }catch(Base::Exception &e) {
+        e.ReportException();
+    }catch(...) {}
+}
+
+void PropertyContainer::BulkChange::tryInvoke()
+{
+    if(container) {
+        auto c = container;
+        container = nullptr;
+        c->endBulkChange();
+    }
+}
+
 unsigned int PropertyContainer::getMemSize (void) const
 {
     std::map<std::string,Property*> Map;
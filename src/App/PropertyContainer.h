@@ -25,6 +25,7 @@
 #define APP_PROPERTYCONTAINER_H
 
 #include <map>
+#include <memory>
 #include <climits>
 #include <cstring>
 #include <Base/Persistence.h>
@@ -211,6 +212,8 @@ public:
   }
 
   virtual bool removeDynamicProperty(const char* name) {
+      if(_bulkChange)
+          removeBulkChange(getDynamicPropertyByName(name));
       return dynamicProps.removeDynamicProperty(name);
   }
   virtual std::vector<std::string> getDynamicPropertyNames() const {
@@ -233,6 +236,40 @@ public:
       _propertyPrefix = prefix;
   }
 
+  /** Begin a bulk change of properties
+   *
+   * Until the matching endBulkChange(), onBeforeChange() is only called on
+   * the first change of each property, and onChanged() is deferred and
+   * called once for each changed property in the order of their first
+   * change. So any change signal and transaction record is only emitted once
+   * per property. The calls can be nested.
+   *
+   * @sa BulkChange
+   */
+  void beginBulkChange();
+  /** End a bulk change of properties
+   *
+   * The deferred onChanged() is called when ending the outermost bulk
+   * change. The first exception thrown in any onChanged() is rethrown after
+   * all properties have been notified.
+   */
+  void endBulkChange();
+  /// Check if there is any active bulk change
+  bool isBulkChanging() const {
+      return !!_bulkChange;
+  }
+
+  /// Helper class to begin and end a bulk property change within a scope
+  class AppExport BulkChange {
+  public:
+      BulkChange(PropertyContainer &container);
+      ~BulkChange();
+      /// End the bulk change early to allow error propagation
+      void tryInvoke();
+  private:
+      PropertyContainer *container;
+  };
+
   friend class Property;
   friend class DynamicProperty;
 
@@ -250,6 +287,14 @@ protected:
   virtual void handleChangedPropertyName(Base::XMLReader &reader, const char * TypeName, const char *PropName);
   virtual void handleChangedPropertyType(Base::XMLReader &reader, const char * TypeName, Property * prop);
 
+private:
+  /// Called by Property::aboutToSetValue(), returns false if the change is already recorded
+  bool checkBulkBeforeChange(const Property *prop);
+  /// Called by Property::hasSetValue(), returns false if the change is deferred
+  bool checkBulkChange(const Property *prop);
+  /// Drop a property that is about to be removed from the bulk change
+  void removeBulkChange(const Property *prop);
+
 private:
   // forbidden
   PropertyContainer(const PropertyContainer&);
@@ -260,6 +305,8 @@ protected:
 
 private: 
   std::string _propertyPrefix;
+  struct BulkChangeData;
+  std::unique_ptr<BulkChangeData> _bulkChange;
   static PropertyData propertyData; 
 };
 
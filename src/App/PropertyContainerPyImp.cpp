@@ -31,6 +31,8 @@
 #include "PropertyContainer.h"
 #include "Property.h"
 #include "PropertyLinks.h"
+#include "PropertyGeo.h"
+#include "PropertyStandard.h"
 #include "Application.h"
 #include "DocumentObject.h"
 
@@ -198,6 +200,7 @@ static const std::map<std::string, int> &getStatusMap() {
         statusMap["LockDynamic"] = Property::LockDynamic;
         statusMap["NoModify"] = Property::NoModify;
         statusMap["PartialTrigger"] = Property::PartialTrigger;
+        statusMap["AffectSubObject"] = Property::AffectSubObject;
     }
     return statusMap;
 }
@@ -427,6 +430,92 @@ PyObject* PropertyContainerPy::dumpPropertyContent(PyObject *args, PyObject *kwd
     return ba;
 }
 
+PyObject* PropertyContainerPy::setProperties(PyObject *args)
+{
+    PyObject *pyDict;
+    if (!PyArg_ParseTuple(args, "O!", &PyDict_Type, &pyDict))
+        return NULL;
+
+    PY_TRY {
+        getPropertyContainerPtr()->beginBulkChange();
+        bool ok = true;
+        PyObject *key, *value;
+        Py_ssize_t pos = 0;
+        while (PyDict_Next(pyDict, &pos, &key, &value)) {
+            if (!PyUnicode_Check(key)) {
+                PyErr_SetString(PyExc_TypeError, "Expect property name to be a string");
+                ok = false;
+                break;
+            }
+            std::string name = Py::String(key).as_std_string("utf-8");
+            if (!getPropertyContainerPtr()->getPropertyByName(name.c_str())) {
+                PyErr_Format(PyExc_AttributeError, "Property container has no property '%s'", name.c_str());
+                ok = false;
+                break;
+            }
+            // Set through the normal attribute access, so that any override
+            // of setCustomAttributes() or attribute setter (e.g. of Python
+            // feature) applies
+            if (PyObject_SetAttr(this, key, value) < 0) {
+                ok = false;
+                break;
+            }
+            // The container may be deleted by any Python code invoked above
+            if (!isValid())
+                break;
+        }
+        if (isValid())
+            getPropertyContainerPtr()->endBulkChange();
+        if (!ok)
+            return 0;
+        Py_Return;
+    } PY_CATCH;
+}
+
+static PyObject *makeArrayView(const double *data, std::size_t rows, std::size_t columns)
+{
+    Py::Bytes bytes(reinterpret_cast<const char*>(data),
+                    static_cast<Py_ssize_t>(rows * columns * sizeof(double)));
+    Py::Object view(PyMemoryView_FromObject(bytes.ptr()), true);
+    Py::Callable cast(view.getAttr("cast"));
+    if (columns == 1)
+        return Py::new_reference_to(cast.apply(Py::TupleN(Py::String("d"))));
+    Py::Tuple shape(2);
+    shape.setItem(0, Py::Long(static_cast<long>(rows)));
+    shape.setItem(1, Py::Long(static_cast<long>(columns)));
+    return Py::new_reference_to(cast.apply(Py::TupleN(Py::String("d"), shape)));
+}
+
+PyObject* PropertyContainerPy::getPropertyArray(PyObject *args)
+{
+    char* name;
+    if (!PyArg_ParseTuple(args, "s", &name))
+        return NULL;
+
+    Property* prop = getPropertyContainerPtr()->getPropertyByName(name);
+    if (!prop) {
+        PyErr_Format(PyExc_AttributeError, "Property container has no property '%s'", name);
+        return 0;
+    }
+
+    PY_TRY {
+        if (prop->isDerivedFrom(PropertyPlacementList::getClassTypeId())) {
+            std::vector<double> data = static_cast<PropertyPlacementList*>(prop)->getArray();
+            return makeArrayView(data.data(), data.size() / 7, 7);
+        }
+        if (prop->isDerivedFrom(PropertyVectorList::getClassTypeId())) {
+            auto vecProp = static_cast<PropertyVectorList*>(prop);
+            return makeArrayView(vecProp->getArray(), vecProp->getSize(), 3);
+        }
+        if (prop->isDerivedFrom(PropertyFloatList::getClassTypeId())) {
+            const std::vector<double> &data = static_cast<PropertyFloatList*>(prop)->getValues();
+            return makeArrayView(data.data(), data.size(), 1);
+        }
+        PyErr_Format(PyExc_TypeError, "Property '%s' does not support array access", name);
+        return 0;
+    } PY_CATCH;
+}
+
 PyObject* PropertyContainerPy::restorePropertyContent(PyObject *args)
 {
     PyObject* buffer;
@@ -33,6 +33,7 @@
 #include "PropertyExpressionEngine.h"
 #include "PropertyStandard.h"
 #include "PropertyUnits.h"
+#include "RecomputeProfiler.h"
 #include <CXX/Objects.hxx>
 #include <boost/bind.hpp>
 #include <boost/graph/graph_traits.hpp>
@@ -557,6 +558,10 @@ DocumentObjectExecReturn *App::PropertyExpressionEngine::execute(ExecuteOption o
 
     resetter r(running);
 
+    static const char *optionNames[] = {"All", "Output", "NonOutput", "OnRestore"};
+    RecomputeProfiler::Scope profile(expressions.empty()?0:docObj,
+            "Expression", "execute", optionNames[option]);
+
     // Compute evaluation order
     std::vector<App::ObjectIdentifier> evaluationOrder = computeEvaluationOrder(option);
     std::vector<ObjectIdentifier>::const_iterator it = evaluationOrder.begin();
@@ -28,6 +28,7 @@
 #endif
 
 #include <boost/algorithm/string/predicate.hpp>
+#include <cstring>
 
 /// Here the FreeCAD includes sorted by Base,App,Gui......
 
@@ -335,6 +336,30 @@ PyObject *PropertyVectorList::getPyObject(void)
     return list;
 }
 
+void PropertyVectorList::setPyObject(PyObject *value)
+{
+    if (DoubleBuffer::check(value)) {
+        DoubleBuffer buf(value, 3);
+        setArray(buf.data(), buf.rows());
+        return;
+    }
+    inherited::setPyObject(value);
+}
+
+const double *PropertyVectorList::getArray() const
+{
+    static_assert(sizeof(Base::Vector3d) == 3*sizeof(double), "unexpected padding in Vector3d");
+    return _lValueList.empty() ? nullptr : &_lValueList[0].x;
+}
+
+void PropertyVectorList::setArray(const double *data, std::size_t count)
+{
+    std::vector<Base::Vector3d> values(count);
+    if (count)
+        memcpy(&values[0].x, data, count * sizeof(Base::Vector3d));
+    setValues(std::move(values));
+}
+
 Base::Vector3d PropertyVectorList::getPyValue(PyObject *item) const {
     PropertyVector val;
     val.setPyObject( item );
@@ -773,6 +798,12 @@ void PropertyPlacement::setPyObject(PyObject *value)
 
 void PropertyPlacement::Save (Base::Writer &writer) const
 {
+    if (writer.isBinaryStream()) {
+        writer.Stream() << writer.ind() << "<PropertyPlacement bin=\""
+                        << writer.addBinaryRecord(this) << "\"/>\n";
+        return;
+    }
+
     Vector3d axis;
     double rfAngle;
     _cPos.getRotation().getValue(axis, rfAngle);
@@ -799,6 +830,12 @@ void PropertyPlacement::Restore(Base::XMLReader &reader)
 {
     // read my Element
     reader.readElement("PropertyPlacement");
+
+    if (reader.hasAttribute("bin")) {
+        reader.addBinaryRecord(reader.getAttributeAsUnsigned("bin"), this);
+        return;
+    }
+
     // get the value of my Attribute
     aboutToSetValue();
 
@@ -825,6 +862,22 @@ void PropertyPlacement::Restore(Base::XMLReader &reader)
 }
 
 
+void PropertyPlacement::SaveDocFile (Base::Writer &writer) const
+{
+    Base::OutputStream str(writer.Stream());
+    const Base::Vector3d &pos = _cPos.getPosition();
+    const Base::Rotation &rot = _cPos.getRotation();
+    str << pos.x << pos.y << pos.z << rot[0] << rot[1] << rot[2] << rot[3];
+}
+
+void PropertyPlacement::RestoreDocFile(Base::Reader &reader)
+{
+    Base::InputStream str(reader);
+    double x, y, z, q0, q1, q2, q3;
+    str >> x >> y >> z >> q0 >> q1 >> q2 >> q3;
+    setValue(Base::Placement(Vector3d(x,y,z), Rotation(q0,q1,q2,q3)));
+}
+
 Property *PropertyPlacement::Copy(void) const
 {
     PropertyPlacement *p= new PropertyPlacement();
@@ -872,6 +925,48 @@ PyObject *PropertyPlacementList::getPyObject(void)
     return list;
 }
 
+void PropertyPlacementList::setPyObject(PyObject *value)
+{
+    if (DoubleBuffer::check(value)) {
+        DoubleBuffer buf(value, 7);
+        setArray(buf.data(), buf.rows());
+        return;
+    }
+    inherited::setPyObject(value);
+}
+
+std::vector<double> PropertyPlacementList::getArray() const
+{
+    std::vector<double> res;
+    res.reserve(_lValueList.size() * 7);
+    for (const auto &pla : _lValueList) {
+        const Base::Vector3d &pos = pla.getPosition();
+        const Base::Rotation &rot = pla.getRotation();
+        res.insert(res.end(), {pos.x, pos.y, pos.z, rot[0], rot[1], rot[2], rot[3]});
+    }
+    return res;
+}
+
+void PropertyPlacementList::setArray(const double *data, std::size_t count)
+{
+    std::vector<Base::Placement> values(count);
+    for (auto &pla : values) {
+        pla.setPosition(Base::Vector3d(data[0], data[1], data[2]));
+        pla.setRotation(Base::Rotation(data[3], data[4], data[5], data[6]));
+        data += 7;
+    }
+    setValues(std::move(values));
+}
+
+std::vector<Base::Matrix4D> PropertyPlacementList::getMatrices(
+        const std::vector<Base::Vector3d> *scales) const
+{
+    std::vector<Base::Matrix4D> res(_lValueList.size());
+    Base::Placement::toMatrices(_lValueList.data(), _lValueList.size(), res.data(),
+            scales ? scales->data() : 0, scales ? scales->size() : 0);
+    return res;
+}
+
 Base::Placement PropertyPlacementList::getPyValue(PyObject *item) const {
     PropertyPlacement val;
     val.setPyObject( item );
@@ -214,6 +214,17 @@ public:
     using inherited::setValue;
 
     virtual PyObject *getPyObject(void);
+    /** Set the value from a Python object
+     *
+     * Besides a sequence of vectors, it also accepts any object supporting
+     * the buffer protocol with double items, e.g. a NumPy array of shape (N,3)
+     */
+    virtual void setPyObject(PyObject *);
+
+    /// Return the vectors as a flat array of 3 doubles each, or null if empty
+    const double *getArray() const;
+    /// Set the vectors from a flat array of 3 doubles each
+    void setArray(const double *data, std::size_t count);
 
     virtual Property *Copy(void) const;
     virtual void Paste(const Property &from);
@@ -357,6 +368,9 @@ public:
 
     virtual void Save (Base::Writer &writer) const;
     virtual void Restore(Base::XMLReader &reader);
+    /// Used to store the placement as a record of the binary property stream
+    virtual void SaveDocFile (Base::Writer &writer) const;
+    virtual void RestoreDocFile(Base::Reader &reader);
 
     virtual Property *Copy(void) const;
     virtual void Paste(const Property &from);
@@ -405,6 +419,8 @@ class AppExport PropertyPlacementList: public PropertyListsT<Base::Placement>
     TYPESYSTEM_HEADER();
 
 public:
+    typedef PropertyListsT<Base::Placement> inherited;
+
     /**
      * A property that stores a list of placements
      */
@@ -413,6 +429,25 @@ public:
     virtual ~PropertyPlacementList();
 
     virtual PyObject *getPyObject(void);
+    /** Set the value from a Python object
+     *
+     * Besides a sequence of placements, it also accepts any object
+     * supporting the buffer protocol with double items (e.g. a NumPy array
+     * of shape (N,7)), with each placement stored as position x, y, z
+     * followed by the rotation quaternion x, y, z, w.
+     */
+    virtual void setPyObject(PyObject *);
+
+    /// Return the placements as a flat array of 7 doubles each, see setPyObject()
+    std::vector<double> getArray() const;
+    /// Set the placements from a flat array of 7 doubles each, see setPyObject()
+    void setArray(const double *data, std::size_t count);
+
+    /** Return the transformation matrices of all placements
+     *
+     * @param scales: optional per placement scale factors, see Base::Placement::toMatrices()
+     */
+    std::vector<Base::Matrix4D> getMatrices(const std::vector<Base::Vector3d> *scales=0) const;
 
     virtual Property *Copy(void) const;
     virtual void Paste(const Property &from);
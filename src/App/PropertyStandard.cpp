@@ -1215,6 +1215,16 @@ PyObject *PropertyFloatList::getPyObject(void)
     return list;
 }
 
+void PropertyFloatList::setPyObject(PyObject *value)
+{
+    if (DoubleBuffer::check(value)) {
+        DoubleBuffer buf(value, 1);
+        setValues(std::vector<double>(buf.data(), buf.data() + buf.rows()));
+        return;
+    }
+    inherited::setPyObject(value);
+}
+
 double PropertyFloatList::getPyValue(PyObject *item) const {
     if (PyFloat_Check(item)) {
         return PyFloat_AsDouble(item);
@@ -585,6 +585,7 @@ class AppExport PropertyFloatList: public PropertyListsT<double>
     TYPESYSTEM_HEADER();
 
 public:
+    typedef PropertyListsT<double> inherited;
 
     /**
      * A constructor.
@@ -602,6 +603,12 @@ public:
     { return "Gui::PropertyEditor::PropertyFloatListItem"; }
 
     virtual PyObject *getPyObject(void);
+    /** Set the value from a Python object
+     *
+     * Besides a sequence of floats, it also accepts any object supporting
+     * the buffer protocol with double items, e.g. a NumPy array
+     */
+    virtual void setPyObject(PyObject *);
     
     virtual Property *Copy(void) const;
     virtual void Paste(const Property &from);
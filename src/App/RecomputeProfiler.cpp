@@ -0,0 +1,272 @@
+/****************************************************************************
+ *   Copyright (c) 2020 FreeCAD Developers                                  *
+ *                                                                          *
+ *   This file is part of the FreeCAD CAx development system.               *
+ *                                                                          *
+ *   This library is free software; you can redistribute it and/or          *
+ *   modify it under the terms of the GNU Library General Public            *
+ *   License as published by the Free Software Foundation; either           *
+ *   version 2 of the License, or (at your option) any later version.       *
+ *                                                                          *
+ *   This library  is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *   GNU Library General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU Library General Public      *
+ *   License along with this library; see the file COPYING.LIB. If not,     *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,          *
+ *   Suite 330, Boston, MA  02111-1307, USA                                 *
+ *                                                                          *
+ ****************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <cstdio>
+# include <sstream>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+
+#include <Base/Console.h>
+#include <Base/FileInfo.h>
+#include <Base/Stream.h>
+
+#include "Document.h"
+#include "DocumentObject.h"
+#include "RecomputeProfiler.h"
+
+FC_LOG_LEVEL_INIT("App",true,true);
+
+using namespace App;
+
+static thread_local int _ProfileDepth;
+
+std::atomic<bool> RecomputeProfiler::_Enabled(false);
+
+RecomputeProfiler::RecomputeProfiler()
+    :startTime(std::chrono::steady_clock::now())
+{
+}
+
+RecomputeProfiler &RecomputeProfiler::instance()
+{
+    static RecomputeProfiler *_instance;
+    if(!_instance)
+        _instance = new RecomputeProfiler;
+    return *_instance;
+}
+
+long long RecomputeProfiler::now() const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - startTime).count();
+}
+
+bool RecomputeProfiler::isActive(const Document *doc) const
+{
+    if(!traceFile.empty())
+        return true;
+    return profiling && doc && doc->testStatus(Document::Recomputing);
+}
+
+void RecomputeProfiler::updateEnabled()
+{
+    _Enabled = profiling || !traceFile.empty();
+}
+
+bool RecomputeProfiler::setEnabled(bool enable)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    bool res = profiling;
+    profiling = enable;
+    if(!profiling)
+        profiles.clear();
+    updateEnabled();
+    return res;
+}
+
+void RecomputeProfiler::beginRecompute(const Document *doc)
+{
+    if(!isEnabled())
+        return;
+    std::lock_guard<std::mutex> lock(mutex);
+    profiles[doc].clear();
+}
+
+void RecomputeProfiler::removeDocument(const Document *doc)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    profiles.erase(doc);
+}
+
+std::vector<RecomputeProfiler::Event> RecomputeProfiler::getProfile(const Document *doc) const
+{
+    std::vector<Event> res;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = profiles.find(doc);
+        if(it != profiles.end())
+            res = it->second;
+    }
+    // Events are added on exiting their scope, sort them so that any parent
+    // event comes before its children
+    std::stable_sort(res.begin(), res.end(), [](const Event &a, const Event &b) {
+        if(a.start != b.start)
+            return a.start < b.start;
+        return a.depth < b.depth;
+    });
+    return res;
+}
+
+void RecomputeProfiler::addEvent(const Document *doc, Event &&event)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if(!traceFile.empty())
+        traces.push_back(event);
+    if(profiling && doc && doc->testStatus(Document::Recomputing))
+        profiles[doc].push_back(std::move(event));
+}
+
+void RecomputeProfiler::setTraceFile(const std::string &filename)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    traceFile = filename;
+    if(traceFile.empty())
+        traces.clear();
+    updateEnabled();
+}
+
+static void writeJsonString(std::ostream &s, const std::string &str)
+{
+    s << '"';
+    for(char c : str) {
+        switch(c) {
+        case '"':
+            s << "\\\"";
+            break;
+        case '\\':
+            s << "\\\\";
+            break;
+        case '\n':
+            s << "\\n";
+            break;
+        case '\t':
+            s << "\\t";
+            break;
+        default:
+            if((unsigned char)c < 0x20) {
+                char buf[8];
+                snprintf(buf, sizeof(buf), "\\u%04x", (unsigned)c);
+                s << buf;
+            } else
+                s << c;
+        }
+    }
+    s << '"';
+}
+
+void RecomputeProfiler::writeTrace(std::ostream &s) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    s << "{\"traceEvents\":[";
+    bool first = true;
+    for(auto &event : traces) {
+        if(first)
+            first = false;
+        else
+            s << ',';
+        s << "\n{\"name\":";
+        writeJsonString(s, event.object.empty() ? event.name : event.object);
+        s << ",\"cat\":";
+        writeJsonString(s, event.category);
+        s << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread
+          << ",\"ts\":" << event.start << ",\"dur\":" << event.duration
+          << ",\"args\":{\"call\":";
+        writeJsonString(s, event.name);
+        if(!event.detail.empty()) {
+            s << ",\"detail\":";
+            writeJsonString(s, event.detail);
+        }
+        s << "}}";
+    }
+    s << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+bool RecomputeProfiler::saveTrace() const
+{
+    if(traceFile.empty())
+        return false;
+    Base::FileInfo fi(traceFile);
+    Base::ofstream file(fi, std::ios::out | std::ios::trunc);
+    if(!file) {
+        FC_ERR("Failed to write recompute trace to " << traceFile);
+        return false;
+    }
+    writeTrace(file);
+    FC_LOG("Recompute trace saved to " << traceFile);
+    return true;
+}
+
+int RecomputeProfiler::enter()
+{
+    return _ProfileDepth++;
+}
+
+void RecomputeProfiler::leave()
+{
+    --_ProfileDepth;
+}
+
+// ----------------------------------------------------------------------------
+
+static int threadSequence()
+{
+    static std::atomic<int> _Sequence(0);
+    static thread_local int _Thread = ++_Sequence;
+    return _Thread;
+}
+
+void RecomputeProfiler::Scope::begin(const DocumentObject *obj,
+        const char *category, const char *name, const char *detail)
+{
+    doc = obj?obj->getDocument():0;
+    auto &profiler = RecomputeProfiler::instance();
+    active = obj && profiler.isActive(doc);
+    if(!active)
+        return;
+    event.category = category;
+    event.name = name;
+    event.object = obj->getFullName();
+    if(detail)
+        event.detail = detail;
+    event.depth = profiler.enter();
+    event.thread = threadSequence();
+    event.start = profiler.now();
+}
+
+void RecomputeProfiler::Scope::begin(const Document *doc, const char *category, const char *name)
+{
+    this->doc = doc;
+    auto &profiler = RecomputeProfiler::instance();
+    active = doc && profiler.isActive(doc);
+    if(!active)
+        return;
+    event.category = category;
+    event.name = name;
+    event.object = doc->getName();
+    event.depth = profiler.enter();
+    event.thread = threadSequence();
+    event.start = profiler.now();
+}
+
+void RecomputeProfiler::Scope::end()
+{
+    auto &profiler = RecomputeProfiler::instance();
+    event.duration = profiler.now() - event.start;
+    profiler.leave();
+    profiler.addEvent(doc, std::move(event));
+}
@@ -0,0 +1,159 @@
+/****************************************************************************
+ *   Copyright (c) 2020 FreeCAD Developers                                  *
+ *                                                                          *
+ *   This file is part of the FreeCAD CAx development system.               *
+ *                                                                          *
+ *   This library is free software; you can redistribute it and/or          *
+ *   modify it under the terms of the GNU Library General Public            *
+ *   License as published by the Free Software Foundation; either           *
+ *   version 2 of the License, or (at your option) any later version.       *
+ *                                                                          *
+ *   This library  is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *   GNU Library General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU Library General Public      *
+ *   License along with this library; see the file COPYING.LIB. If not,     *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,          *
+ *   Suite 330, Boston, MA  02111-1307, USA                                 *
+ *                                                                          *
+ ****************************************************************************/
+
+#ifndef APP_RECOMPUTEPROFILER_H
+#define APP_RECOMPUTEPROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <iosfwd>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace App
+{
+
+class Document;
+class DocumentObject;
+
+/** Collects timing information of document recomputation
+ *
+ * The profiler is off by default, and each profiled scope then only costs
+ * a test of isEnabled(). Once enabled with setEnabled(), e.g. in Python with
+ * FreeCAD.setRecomputeProfiler(True), the profiler keeps the events of the
+ * last recompute of each document, which can be queried in Python with
+ * Document.recomputeProfile().
+ *
+ * If a trace file is set (e.g. through command line option
+ * --recompute-trace), events of all recomputations are accumulated, and
+ * written to the file in Chrome trace event format on application exit. The
+ * file can be inspected with chrome://tracing or https://ui.perfetto.dev
+ */
+class AppExport RecomputeProfiler
+{
+public:
+    struct Event {
+        /// event category, e.g. Document, DocumentObject, Expression, ViewProvider
+        std::string category;
+        /// event name, e.g. recompute, execute, updateData
+        std::string name;
+        /// full name of the object being profiled
+        std::string object;
+        /// extra information, e.g. the property name
+        std::string detail;
+        /// start time in micro seconds since the creation of the profiler
+        long long start;
+        /// duration in micro seconds
+        long long duration;
+        /// nesting level of this event in the call tree
+        int depth;
+        /// sequence number of the thread of this event
+        int thread;
+    };
+
+    static RecomputeProfiler &instance();
+
+    /// Return true if the profiler collects events for getProfile() or the trace file
+    static bool isEnabled() {
+        return _Enabled.load(std::memory_order_relaxed);
+    }
+    /** Enable or disable collecting the events of each recompute for getProfile()
+     * @return Returns the previous state
+     */
+    bool setEnabled(bool enable);
+
+    /// Called by Document::recompute() to discard the events of the last recompute
+    void beginRecompute(const Document *doc);
+    /// Return the events of the last recompute of a document ordered by start time
+    std::vector<Event> getProfile(const Document *doc) const;
+    /// Discard all events of a document
+    void removeDocument(const Document *doc);
+
+    /// Set a file name to accumulate all events for saving in Chrome trace format
+    void setTraceFile(const std::string &filename);
+    const std::string &getTraceFile() const {
+        return traceFile;
+    }
+    /// Write the accumulated events in Chrome trace event format
+    void writeTrace(std::ostream &stream) const;
+    /// Write the accumulated events to the trace file if there is any
+    bool saveTrace() const;
+
+    /// Helper class to profile a scope
+    class AppExport Scope
+    {
+    public:
+        Scope(const DocumentObject *obj, const char *category,
+                const char *name, const char *detail=0)
+            :doc(0), active(false)
+        {
+            if(isEnabled())
+                begin(obj, category, name, detail);
+        }
+        Scope(const Document *doc, const char *category, const char *name)
+            :doc(0), active(false)
+        {
+            if(isEnabled())
+                begin(doc, category, name);
+        }
+        ~Scope() {
+            if(active)
+                end();
+        }
+
+    private:
+        void begin(const DocumentObject *obj, const char *category,
+                const char *name, const char *detail);
+        void begin(const Document *doc, const char *category, const char *name);
+        void end();
+
+    private:
+        const Document *doc;
+        Event event;
+        bool active;
+    };
+
+private:
+    RecomputeProfiler();
+
+    bool isActive(const Document *doc) const;
+    long long now() const;
+    int enter();
+    void leave();
+    void addEvent(const Document *doc, Event &&event);
+    void updateEnabled();
+
+private:
+    static std::atomic<bool> _Enabled;
+    std::chrono::steady_clock::time_point startTime;
+    std::string traceFile;
+    bool profiling = false;
+    mutable std::mutex mutex;
+    std::map<const Document*, std::vector<Event> > profiles;
+    std::vector<Event> traces;
+};
+
+} //namespace App
+
+#endif // APP_RECOMPUTEPROFILER_H
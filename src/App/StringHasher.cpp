@@ -26,10 +26,11 @@
 #ifndef _PreComp_
 #endif
 
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
 #include <boost/algorithm/string/predicate.hpp>
-#include <boost/bimap.hpp>
-#include <boost/bimap/unordered_set_of.hpp>
-#include <boost/bimap/set_of.hpp>
 #include <QHash>
 #include <QCryptographicHash>
 #include <Base/Console.h>
@@ -86,25 +87,73 @@ std::string StringID::dataToText() const {
 
 ///////////////////////////////////////////////////////////
 //
-namespace boost {
-template<>
-struct hash<QByteArray> {
+struct QByteArrayHasher {
     size_t operator()(const QByteArray &data) const {
         return qHash(data);
     }
 };
-}
-
-typedef boost::bimap<
-    boost::bimaps::unordered_set_of<QByteArray>,
-    boost::bimaps::set_of<long>, 
-    boost::bimaps::with_info<StringIDRef> > HashMapBase;
 
-class StringHasher::HashMap: public HashMapBase 
+/* The string table is split into shards, each guarded by its own mutex, so
+ * that threads looking up different strings rarely block each other. The ID
+ * table owns the StringID, and is only locked when a new string is added, or
+ * when looking up by ID. Entries are never removed except by clear(), so it
+ * is safe for the shards to keep plain pointers.
+ */
+class StringHasher::HashMap
 {
 public:
-    bool SaveAll = false;
-    int Threshold = 0;
+    enum {
+        ShardCount = 16,
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<QByteArray, StringID*, QByteArrayHasher> strings;
+    };
+
+    HashMap()
+        :LastID(0), SaveAll(false), Threshold(0)
+    {}
+
+    Shard &getShard(const QByteArray &data) {
+        return Shards[QByteArrayHasher()(data) % ShardCount];
+    }
+
+    // Add a new ID. Caller must hold the lock of the shard of the ID's data
+    bool addID(Shard &shard, const StringIDRef &sid) {
+        if(!shard.strings.emplace(sid->data(), sid).second)
+            return false;
+        std::lock_guard<std::mutex> lock(IDMutex);
+        IDs.emplace_hint(IDs.end(), sid->value(), sid);
+        return true;
+    }
+
+    // Add a restored ID
+    void restoreID(const StringIDRef &sid) {
+        auto &shard = getShard(sid->data());
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if(!addID(shard, sid))
+            return;
+        long id = LastID;
+        while(sid->value() > id && !LastID.compare_exchange_weak(id, sid->value()));
+    }
+
+    void clear() {
+        for(auto &shard : Shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.strings.clear();
+        }
+        std::lock_guard<std::mutex> lock(IDMutex);
+        IDs.clear();
+        LastID = 0;
+    }
+
+    Shard Shards[ShardCount];
+    mutable std::mutex IDMutex;
+    std::map<long, StringIDRef> IDs;
+    std::atomic<long> LastID;
+    std::atomic<bool> SaveAll;
+    std::atomic<int> Threshold;
 };
 
 ///////////////////////////////////////////////////////////
@@ -134,14 +183,6 @@ int StringHasher::getThreshold() const {
     return _hashes->Threshold;
 }
 
-long StringHasher::lastID() const {
-    if(_hashes->right.empty())
-        return 0;
-    auto it = _hashes->right.end();
-    --it;
-    return it->first;
-}
-
 StringIDRef StringHasher::getID(const char *text, int len, bool hashable) {
     if(len<0) len = strlen(text);
     return getID(QByteArray::fromRawData(text,len),false,hashable);
@@ -160,9 +201,11 @@ StringIDRef StringHasher::getID(QByteArray data, bool binary, bool hashable) {
     }else
         hash = data;
 
-    auto it = _hashes->left.find(hash);
-    if(it!=_hashes->left.end())
-        return it->info;
+    auto &shard = _hashes->getShard(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.strings.find(hash);
+    if(it!=shard.strings.end())
+        return it->second;
 
     StringIDRef sid;
     if(hashed) {
@@ -171,20 +214,20 @@ StringIDRef StringHasher::getID(QByteArray data, bool binary, bool hashable) {
     }else{
         // if not hashed, make a deep copy of the data
         data = QByteArray(data.constData(),data.size());
-        hash = data;
     }
-    sid = new StringID(lastID()+1,data,binary,hashed);
-    _hashes->right.insert(_hashes->right.end(),HashMap::right_map::value_type(sid->value(),hash,sid));
+    sid = new StringID(++_hashes->LastID,data,binary,hashed);
+    _hashes->addID(shard,sid);
     return sid;
 }
 
 StringIDRef StringHasher::getID(long id) const {
     if(id<=0)
         return _StringIDNull;
-    auto it = _hashes->right.find(id);
-    if(it == _hashes->right.end())
+    std::lock_guard<std::mutex> lock(_hashes->IDMutex);
+    auto it = _hashes->IDs.find(id);
+    if(it == _hashes->IDs.end())
         return StringIDRef();
-    return it->info;
+    return it->second;
 }
 
 void StringHasher::setPersistenceFileName(const char *filename) const {
@@ -219,15 +262,16 @@ void StringHasher::Save(Base::Writer &writer) const {
         saveStream(writer.beginCharStream(false) << '\n');
         writer.endCharStream() << '\n';
     } else {
-        for(auto &v : _hashes->right) {
-            if(_hashes->SaveAll || v.info.getRefCount()>1) {
+        std::lock_guard<std::mutex> lock(_hashes->IDMutex);
+        for(auto &v : _hashes->IDs) {
+            if(_hashes->SaveAll || v.second.getRefCount()>1) {
                 // We are omiting the indentation to save some space in case of long list of hashes
-                if(v.info->isHashed()) 
-                    writer.Stream() <<"<Item hash=\""<< v.second.toBase64().constData();
-                else if(v.info->isBinary())
-                    writer.Stream() <<"<Item data=\""<< v.second.toBase64().constData();
+                if(v.second->isHashed()) 
+                    writer.Stream() <<"<Item hash=\""<< v.second->data().toBase64().constData();
+                else if(v.second->isBinary())
+                    writer.Stream() <<"<Item data=\""<< v.second->data().toBase64().constData();
                 else
-                    writer.Stream() <<"<Item text=\""<< encodeAttribute(v.second.constData());
+                    writer.Stream() <<"<Item text=\""<< encodeAttribute(v.second->data().constData());
                 writer.Stream() << "\" id=\""<<v.first<<"\"/>\n";
             }
         }
@@ -243,16 +287,17 @@ void StringHasher::SaveDocFile (Base::Writer &writer) const {
 
 void StringHasher::saveStream(std::ostream &s) const {
     Base::OutputStream str(s,false);
-    for(auto &v : _hashes->right) {
-        if(_hashes->SaveAll || v.info.getRefCount()>1) {
+    std::lock_guard<std::mutex> lock(_hashes->IDMutex);
+    for(auto &v : _hashes->IDs) {
+        if(_hashes->SaveAll || v.second.getRefCount()>1) {
             // We do not use OutputStream to save the id and flags because
             // we don't want to use '\n' as delimiter. It makes no difference
             // to restoring.
-            s << v.first << ' ' << v.info->_flags.to_ulong() << ' ';
+            s << v.first << ' ' << v.second->_flags.to_ulong() << ' ';
 
             // We DO rely on OutputStream to save the string which may
             // contain multiple lines.
-            str << v.info->dataToText();
+            str << v.second->dataToText();
         }
     }
 }
@@ -276,8 +321,7 @@ void StringHasher::restoreStream(std::istream &s, std::size_t count) {
             sid->_data = QByteArray::fromBase64(content.c_str());
         } else
             sid->_data = QByteArray(content.c_str());
-        _hashes->right.insert(_hashes->right.end(),
-                HashMap::right_map::value_type(sid->value(),sid->_data,sid));
+        _hashes->restoreID(sid);
     }
 }
 
@@ -286,13 +330,15 @@ void StringHasher::clear() {
 }
 
 size_t StringHasher::size() const {
-    return _hashes->size();
+    std::lock_guard<std::mutex> lock(_hashes->IDMutex);
+    return _hashes->IDs.size();
 }
 
 size_t StringHasher::count() const {
     size_t count = 0;
-    for(auto &v : _hashes->right) 
-        if(v.info.getRefCount()>1)
+    std::lock_guard<std::mutex> lock(_hashes->IDMutex);
+    for(auto &v : _hashes->IDs) 
+        if(v.second.getRefCount()>1)
             ++count;
     return count;
 }
@@ -328,7 +374,7 @@ void StringHasher::Restore(Base::XMLReader &reader) {
                 data = QByteArray(reader.getAttribute("text"));
                 sid = new StringID(id,data,false,false);
             }
-            _hashes->right.insert(_hashes->right.end(),HashMap::right_map::value_type(sid->value(),data,sid));
+            _hashes->restoreID(sid);
         }
     }
     reader.readEndElement("StringHasher");
@@ -343,8 +389,6 @@ PyObject *StringHasher::getPyObject() {
 }
 
 std::map<long,StringIDRef> StringHasher::getIDMap() const {
-    std::map<long,StringIDRef> ret;
-    for(auto &v : _hashes->right)
-        ret.emplace_hint(ret.end(),v.first,v.info);
-    return ret;
+    std::lock_guard<std::mutex> lock(_hashes->IDMutex);
+    return _hashes->IDs;
 }
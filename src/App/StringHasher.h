@@ -144,7 +144,6 @@ public:
     class HashMap;
 
 private:
-    long lastID() const;
     void saveStream(std::ostream &s) const;
     void restoreStream(std::istream &s, std::size_t count);
 
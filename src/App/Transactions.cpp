@@ -27,7 +27,11 @@
 # include <cassert>
 #endif
 
+#include <algorithm>
 #include <atomic>
+#include <climits>
+#include <sstream>
+#include <zlib.h>
 
 /// Here the FreeCAD includes sorted by Base,App,Gui......
 #include <Base/Writer.h>
@@ -47,10 +51,14 @@ using namespace std;
 
 TYPESYSTEM_SOURCE(App::Transaction, Base::Persistence)
 
+// Marks the cached memory size of a transaction as out of date
+static const std::size_t InvalidMemSize = static_cast<std::size_t>(-1);
+
 //**************************************************************************
 // Construction/Destruction
 
 Transaction::Transaction(int id)
+    :memSize(InvalidMemSize)
 {
     if(!id) id = getNewID();
     transID = id;
@@ -111,7 +119,33 @@ int Transaction::getLastID() {
 
 unsigned int Transaction::getMemSize (void) const
 {
-    return 0;
+    return (unsigned int)std::min<std::size_t>(getTotalMemSize(), UINT_MAX);
+}
+
+std::size_t Transaction::getTotalMemSize() const
+{
+    // The transaction is not changed once committed, so cache the result
+    // for repeated calls from Document::getUndoMemSize()
+    if(memSize == InvalidMemSize) {
+        std::size_t size = 0;
+        for(auto &v : _Objects.get<0>()) {
+            size += v.second->getMemSize();
+            // The transaction owns the removed object
+            if(v.second->status == TransactionObject::New && !v.first->isAttachedToDocument())
+                size += v.first->getMemSize();
+        }
+        memSize = size;
+    }
+    return memSize;
+}
+
+void Transaction::compress(unsigned int threshold)
+{
+    if(!threshold)
+        return;
+    for(auto &v : _Objects.get<0>())
+        v.second->compress(threshold);
+    memSize = InvalidMemSize;
 }
 
 void Transaction::Save (Base::Writer &/*writer*/) const
@@ -147,6 +181,7 @@ void Transaction::addOrRemoveProperty(TransactionalObject *Obj,
 
     TransactionObject *To;
 
+    memSize = InvalidMemSize;
     if (pos != index.end()) {
         To = pos->second;
     }
@@ -190,6 +225,7 @@ void Transaction::apply(Document &Doc, bool forward)
 
 void Transaction::addObjectNew(TransactionalObject *Obj)
 {
+    memSize = InvalidMemSize;
     auto &index = _Objects.get<1>();
     auto pos = index.find(Obj);
     if (pos != index.end()) {
@@ -216,6 +252,7 @@ void Transaction::addObjectNew(TransactionalObject *Obj)
 
 void Transaction::addObjectDel(const TransactionalObject *Obj)
 {
+    memSize = InvalidMemSize;
     auto &index = _Objects.get<1>();
     auto pos = index.find(Obj);
 
@@ -242,6 +279,7 @@ void Transaction::addObjectChange(const TransactionalObject *Obj, const Property
 
     TransactionObject *To;
 
+    memSize = InvalidMemSize;
     if (pos != index.end()) {
         To = pos->second;
     }
@@ -300,6 +338,9 @@ void TransactionObject::applyChn(Document & /*Doc*/, TransactionalObject *pcObj,
             auto &data = v.second;
             auto prop = const_cast<Property*>(v.first);
 
+            if(data.compressed.size() && !uncompress(data))
+                continue;
+
             if(!data.property) {
                 // here means we are undoing/redoing and property add operation
                 pcObj->removeDynamicProperty(v.second.name.c_str());
@@ -405,7 +446,83 @@ void TransactionObject::addOrRemoveProperty(const Property* pcProp, bool add)
 
 unsigned int TransactionObject::getMemSize (void) const
 {
-    return 0;
+    unsigned long size = 0;
+    for(auto &v : _PropChangeMap) {
+        auto &data = v.second;
+        if(data.compressed.size())
+            size += data.compressed.size();
+        else if(data.property)
+            size += data.property->getMemSize();
+    }
+    return (unsigned int)std::min<unsigned long>(size, UINT_MAX);
+}
+
+void TransactionObject::compress(unsigned int threshold)
+{
+    for(auto &v : _PropChangeMap) {
+        auto &data = v.second;
+        if(!data.property || data.compressed.size()
+                          || !data.property->isDocFileSelfContained()
+                          || data.property->getMemSize() < threshold)
+            continue;
+
+        Property *placeholder = 0;
+        try {
+            Base::StringWriter writer;
+            data.property->SaveDocFile(writer);
+            std::string content = writer.getString();
+
+            uLongf size = compressBound((uLong)content.size());
+            data.compressed.resize(size);
+            if(::compress2((Bytef*)&data.compressed[0], &size, (const Bytef*)content.c_str(),
+                        (uLong)content.size(), Z_BEST_SPEED) != Z_OK)
+                throw Base::RuntimeError("Failed to compress");
+            data.compressed.resize(size);
+            data.uncompressedSize = content.size();
+
+            // Keep an empty property of the same type for type checking
+            // and dynamic property recreation
+            placeholder = static_cast<Property*>(data.propertyType.createInstance());
+            if(!placeholder)
+                throw Base::RuntimeError("Failed to create property");
+            placeholder->setStatusValue(data.property->getStatus());
+        } catch (Base::Exception &e) {
+            FC_ERR("Failed to compress property of type "
+                    << data.propertyType.getName() << ": " << e.what());
+            data.compressed.clear();
+            delete placeholder;
+            continue;
+        }
+        delete data.property;
+        data.property = placeholder;
+    }
+}
+
+bool TransactionObject::uncompress(PropData &data)
+{
+    std::string content;
+    content.resize(data.uncompressedSize);
+    uLongf size = (uLongf)content.size();
+    int res = ::uncompress((Bytef*)&content[0], &size,
+            (const Bytef*)data.compressed.c_str(), (uLong)data.compressed.size());
+    data.compressed.clear();
+    if(res != Z_OK || size != (uLongf)content.size()) {
+        FC_ERR("Failed to uncompress property of type " << data.propertyType.getName());
+        return false;
+    }
+    try {
+        std::istringstream iss(content);
+        Base::Reader reader(iss, data.propertyType.getName());
+        data.property->RestoreDocFile(reader);
+    } catch (Base::Exception &e) {
+        e.ReportException();
+        return false;
+    } catch (std::exception &e) {
+        FC_ERR("Failed to restore property of type "
+                << data.propertyType.getName() << ": " << e.what());
+        return false;
+    }
+    return true;
 }
 
 void TransactionObject::Save (Base::Writer &/*writer*/) const
@@ -64,6 +64,8 @@ public:
     std::string Name;
 
     virtual unsigned int getMemSize (void) const;
+    /// Return the memory size in bytes, which unlike getMemSize() is not limited to 4 GB
+    std::size_t getTotalMemSize() const;
     virtual void Save (Base::Writer &writer) const;
     /// This method is used to restore properties from an XML document.
     virtual void Restore(Base::XMLReader &reader);
@@ -85,8 +87,17 @@ public:
     void addObjectDel(const TransactionalObject *Obj);
     void addObjectChange(const TransactionalObject *Obj, const Property *Prop);
 
+    /** Compress large recorded property values
+     *
+     * @param threshold: the memory size in bytes of a recorded property
+     * value, above which the value is kept compressed if the property
+     * supports it. See Property::isDocFileSelfContained().
+     */
+    void compress(unsigned int threshold);
+
 private:
     int transID;
+    mutable std::size_t memSize;
     typedef std::pair<const TransactionalObject*, TransactionObject*> Info;
     bmi::multi_index_container<
         Info,
@@ -117,6 +128,7 @@ public:
 
     void setProperty(const Property* pcProp);
     void addOrRemoveProperty(const Property* pcProp, bool add);
+    void compress(unsigned int threshold);
 
     virtual unsigned int getMemSize (void) const;
     virtual void Save (Base::Writer &writer) const;
@@ -130,7 +142,11 @@ protected:
 
     struct PropData : DynamicProperty::PropData {
         Base::Type propertyType;
+        /// Compressed content of the property, restored on apply
+        std::string compressed;
+        unsigned long uncompressedSize = 0;
     };
+    bool uncompress(PropData &data);
     std::unordered_map<const Property*, PropData> _PropChangeMap;
 
     std::string _NameInDocument;
@@ -228,6 +228,47 @@ PyObject* MatrixPy::richCompare(PyObject *v, PyObject *w, int op)
     }
 }
 
+#if PY_MAJOR_VERSION >= 3
+int MatrixPy::getBuffer(PyObject *self, Py_buffer *view, int flags)
+{
+    // Expose the 16 doubles of the matrix in place as a 4x4 row major
+    // array, so that e.g. numpy.asarray(m) shares memory with the matrix.
+    static Py_ssize_t shape[2] = {4, 4};
+    static Py_ssize_t strides[2] = {4*sizeof(double), sizeof(double)};
+
+    MatrixPy *pyself = static_cast<MatrixPy*>(self);
+    if (!pyself->isValid()) {
+        PyErr_SetString(PyExc_ReferenceError, "This object is already deleted most likely through closing a document. This reference is no longer valid!");
+        view->obj = 0;
+        return -1;
+    }
+    if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE && pyself->isConst()) {
+        PyErr_SetString(PyExc_BufferError, "This object is immutable, you can not set any attribute or call a non const method");
+        view->obj = 0;
+        return -1;
+    }
+
+    Matrix4D &mat = *pyself->getMatrixPtr();
+    view->buf = &mat[0][0];
+    view->obj = self;
+    Py_INCREF(self);
+    view->len = 16*sizeof(double);
+    view->readonly = pyself->isConst() ? 1 : 0;
+    view->itemsize = sizeof(double);
+    view->format = (flags & PyBUF_FORMAT) == PyBUF_FORMAT ? const_cast<char*>("d") : 0;
+    view->ndim = 2;
+    view->shape = (flags & PyBUF_ND) == PyBUF_ND ? shape : 0;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? strides : 0;
+    view->suboffsets = 0;
+    view->internal = 0;
+    return 0;
+}
+
+void MatrixPy::releaseBuffer(PyObject * /*self*/, Py_buffer * /*view*/)
+{
+}
+#endif
+
 PyObject* MatrixPy::move(PyObject * args)
 {
     double x,y,z;
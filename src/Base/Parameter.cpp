@@ -37,6 +37,7 @@
 #   endif
 #   include <xercesc/framework/StdOutFormatTarget.hpp>
 #   include <xercesc/framework/LocalFileFormatTarget.hpp>
+#   include <xercesc/framework/MemBufFormatTarget.hpp>
 #   include <xercesc/framework/LocalFileInputSource.hpp>
 #   include <xercesc/parsers/XercesDOMParser.hpp>
 #   include <xercesc/util/XMLUni.hpp>
@@ -60,9 +61,13 @@
 #   include <unistd.h>
 #endif
 
+#include <chrono>
+
 #include "Parameter.h"
 #include "Exception.h"
 #include "Console.h"
+#include "FileInfo.h"
+#include "Stream.h"
 
 
 //#ifdef XERCES_HAS_CPP_NAMESPACE
@@ -226,8 +231,9 @@ ParameterLock::~ParameterLock() {
 
 /** Default construction
   */
-ParameterGrp::ParameterGrp(XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *GroupNode,const char* sName)
-        : Base::Handled(), Subject<const char*>(),_pGroupNode(GroupNode)
+ParameterGrp::ParameterGrp(XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *GroupNode,const char* sName,
+                           ParameterManager *Manager)
+        : Base::Handled(), Subject<const char*>(),_pGroupNode(GroupNode),_Manager(Manager),_Indexed(false)
 {
     if (sName) _cName=sName;
 }
@@ -325,37 +331,32 @@ void ParameterGrp::insert(const char* FileName)
 
 Base::Reference<ParameterGrp> ParameterGrp::GetGroup(const char* Name)
 {
-    std::string cName = Name;
-
-    std::string::size_type pos = cName.find('/');
-
-    // is there a path separator ?
-    if (pos == std::string::npos) {
+    // no path separator?
+    const char *pos = strchr(Name,'/');
+    if (!pos)
         return _GetGroup(Name);
+
+    // walk down the path, empty parts due to leading, trailing or double
+    // slashes are skipped
+    Base::Reference<ParameterGrp> rParamGrp;
+    ParameterGrp *pcGrp = this;
+    std::string cTemp;
+    for (;;) {
+        if (pos != Name) {
+            cTemp.assign(Name, pos-Name);
+            rParamGrp = pcGrp->_GetGroup(cTemp.c_str());
+            pcGrp = rParamGrp;
+        }
+        if (!*pos)
+            break;
+        Name = pos+1;
+        pos = strchr(Name,'/');
+        if (!pos)
+            pos = Name + strlen(Name);
     }
-    else if (pos == cName.size()) {
-        // ending slash! cut it away
-        cName.erase(pos);
-        return _GetGroup(cName.c_str());
-    }
-    else if (pos == 0) {
-        // a leading slash is not handled (root unknown)
-        //throw FCException("ParameterGrp::GetGroup() leading slash not allowed");
-        // remove leading slash
-        cName.erase(0,1);
-        // subsequent call
-        return GetGroup(cName.c_str());
-    }
-    else {
-        // path, split the first path
-        std::string cTemp;
-        // getting the first part
-        cTemp.assign(cName,0,pos);
-        // removing the first part from the original
-        cName.erase(0,pos+1);
-        //sbsequent call
-        return _GetGroup(cTemp.c_str())->GetGroup(cName.c_str());
-    }
+    if (!rParamGrp.isValid())
+        return _GetGroup("");
+    return rParamGrp;
 }
 
 Base::Reference<ParameterGrp> ParameterGrp::_GetGroup(const char* Name)
@@ -370,10 +371,14 @@ Base::Reference<ParameterGrp> ParameterGrp::_GetGroup(const char* Name)
     }
 
     // search if Group node already there
-    pcTemp = FindOrCreateElement(_pGroupNode,"FCParamGroup",Name);
+    pcTemp = FindElement(_pGroupNode,"FCParamGroup",Name);
+    if (!pcTemp) {
+        pcTemp = FindOrCreateElement(_pGroupNode,"FCParamGroup",Name);
+        SetModified();
+    }
 
     // create and register handle
-    rParamGrp = Base::Reference<ParameterGrp> (new ParameterGrp(pcTemp,Name));
+    rParamGrp = Base::Reference<ParameterGrp> (new ParameterGrp(pcTemp,Name,_Manager));
     _GroupMap[Name] = rParamGrp;
 
     return rParamGrp;
@@ -392,7 +397,7 @@ std::vector<Base::Reference<ParameterGrp> > ParameterGrp::GetGroups(void)
         Name = StrX( ((DOMElement*)pcTemp)->getAttributes()->getNamedItem(XStr("Name").unicodeForm())->getNodeValue()).c_str();
         // already created?
         if (!(rParamGrp=_GroupMap[Name]).isValid()) {
-            rParamGrp = Base::Reference<ParameterGrp> (new ParameterGrp(((DOMElement*)pcTemp),Name.c_str()));
+            rParamGrp = Base::Reference<ParameterGrp> (new ParameterGrp(((DOMElement*)pcTemp),Name.c_str(),_Manager));
             _GroupMap[Name] = rParamGrp;
         }
         vrParamGrp.push_back( rParamGrp );
@@ -427,22 +432,26 @@ bool ParameterGrp::HasGroup(const char* Name) const
 bool ParameterGrp::GetBool(const char* Name, bool bPreset) const
 {
     // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCBool",Name);
+    ParamEntry *pcEntry = FindEntry(FCBool,Name);
     // if not return preset
-    if (!pcElem) return bPreset;
+    if (!pcEntry) return bPreset;
     // if yes check the value and return
-    if (strcmp(StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str(),"1"))
-        return false;
-    else
-        return true;
+    if (!pcEntry->parsed) {
+        pcEntry->value.b = !strcmp(StrX(pcEntry->element->getAttribute(XStr("Value").unicodeForm())).c_str(),"1");
+        pcEntry->parsed = true;
+    }
+    return pcEntry->value.b;
 }
 
 void  ParameterGrp::SetBool(const char* Name, bool bValue)
 {
     // find or create the Element
-    DOMElement *pcElem = FindOrCreateElement(_pGroupNode,"FCBool",Name);
+    ParamEntry &entry = FindOrCreateEntry(FCBool,Name);
     // and set the value
-    pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(bValue?"1":"0").unicodeForm());
+    entry.element->setAttribute(XStr("Value").unicodeForm(), XStr(bValue?"1":"0").unicodeForm());
+    entry.value.b = bValue;
+    entry.parsed = true;
+    SetModified();
     // trigger observer
     Notify(Name);
 }
@@ -494,21 +503,28 @@ std::vector<std::pair<std::string,bool> > ParameterGrp::GetBoolMap(const char *
 long ParameterGrp::GetInt(const char* Name, long lPreset) const
 {
     // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCInt",Name);
+    ParamEntry *pcEntry = FindEntry(FCInt,Name);
     // if not return preset
-    if (!pcElem) return lPreset;
+    if (!pcEntry) return lPreset;
     // if yes check the value and return
-    return atol (StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str());
+    if (!pcEntry->parsed) {
+        pcEntry->value.i = atol (StrX(pcEntry->element->getAttribute(XStr("Value").unicodeForm())).c_str());
+        pcEntry->parsed = true;
+    }
+    return pcEntry->value.i;
 }
 
 void  ParameterGrp::SetInt(const char* Name, long lValue)
 {
     char cBuf[256];
     // find or create the Element
-    DOMElement *pcElem = FindOrCreateElement(_pGroupNode,"FCInt",Name);
+    ParamEntry &entry = FindOrCreateEntry(FCInt,Name);
     // and set the value
     sprintf(cBuf,"%li",lValue);
-    pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+    entry.element->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+    entry.value.i = lValue;
+    entry.parsed = true;
+    SetModified();
     // trigger observer
     Notify(Name);
 }
@@ -555,21 +571,28 @@ std::vector<std::pair<std::string,long> > ParameterGrp::GetIntMap(const char * s
 unsigned long ParameterGrp::GetUnsigned(const char* Name, unsigned long lPreset) const
 {
     // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCUInt",Name);
+    ParamEntry *pcEntry = FindEntry(FCUInt,Name);
     // if not return preset
-    if (!pcElem) return lPreset;
+    if (!pcEntry) return lPreset;
     // if yes check the value and return
-    return strtoul (StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str(),0,10);
+    if (!pcEntry->parsed) {
+        pcEntry->value.u = strtoul (StrX(pcEntry->element->getAttribute(XStr("Value").unicodeForm())).c_str(),0,10);
+        pcEntry->parsed = true;
+    }
+    return pcEntry->value.u;
 }
 
 void  ParameterGrp::SetUnsigned(const char* Name, unsigned long lValue)
 {
     char cBuf[256];
     // find or create the Element
-    DOMElement *pcElem = FindOrCreateElement(_pGroupNode,"FCUInt",Name);
+    ParamEntry &entry = FindOrCreateEntry(FCUInt,Name);
     // and set the value
     sprintf(cBuf,"%lu",lValue);
-    pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+    entry.element->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+    entry.value.u = lValue;
+    entry.parsed = true;
+    SetModified();
     // trigger observer
     Notify(Name);
 }
@@ -616,21 +639,29 @@ std::vector<std::pair<std::string,unsigned long> > ParameterGrp::GetUnsignedMap(
 double ParameterGrp::GetFloat(const char* Name, double dPreset) const
 {
     // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCFloat",Name);
+    ParamEntry *pcEntry = FindEntry(FCFloat,Name);
     // if not return preset
-    if (!pcElem) return dPreset;
+    if (!pcEntry) return dPreset;
     // if yes check the value and return
-    return atof (StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str());
+    if (!pcEntry->parsed) {
+        pcEntry->value.f = atof (StrX(pcEntry->element->getAttribute(XStr("Value").unicodeForm())).c_str());
+        pcEntry->parsed = true;
+    }
+    return pcEntry->value.f;
 }
 
 void  ParameterGrp::SetFloat(const char* Name, double dValue)
 {
     char cBuf[256];
     // find or create the Element
-    DOMElement *pcElem = FindOrCreateElement(_pGroupNode,"FCFloat",Name);
+    ParamEntry &entry = FindOrCreateEntry(FCFloat,Name);
     // and set the value
     sprintf(cBuf,"%.12f",dValue); // use %.12f instead of %f to handle values < 1.0e-6
-    pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+    entry.element->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+    // cache the value as read back from the document
+    entry.value.f = atof(cBuf);
+    entry.parsed = true;
+    SetModified();
     // trigger observer
     Notify(Name);
 }
@@ -691,7 +722,8 @@ void ParameterGrp::GetBlob(const char* /*Name*/, void* /*pBuf*/, long /*lMaxLeng
 void  ParameterGrp::SetASCII(const char* Name, const char *sValue)
 {
     // find or create the Element
-    DOMElement *pcElem = FindOrCreateElement(_pGroupNode,"FCText",Name);
+    ParamEntry &entry = FindOrCreateEntry(FCText,Name);
+    DOMElement *pcElem = entry.element;
     // and set the value
     DOMNode *pcElem2 = pcElem->getFirstChild();
     if (!pcElem2) {
@@ -702,6 +734,11 @@ void  ParameterGrp::SetASCII(const char* Name, const char *sValue)
     else {
         pcElem2->setNodeValue(XUTF8Str(sValue).unicodeForm());
     }
+    // value.b tells whether there is a text node
+    entry.text = sValue;
+    entry.value.b = true;
+    entry.parsed = true;
+    SetModified();
     // trigger observer
     Notify(Name);
 
@@ -710,18 +747,24 @@ void  ParameterGrp::SetASCII(const char* Name, const char *sValue)
 std::string ParameterGrp::GetASCII(const char* Name, const char * pPreset) const
 {
     // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCText",Name);
+    ParamEntry *pcEntry = FindEntry(FCText,Name);
     // if not return preset
-    if (!pcElem) {
+    if (!pcEntry) {
         if (pPreset==0)
             return std::string("");
         else
             return std::string(pPreset);
     }
     // if yes check the value and return
-    DOMNode *pcElem2 = pcElem->getFirstChild();
-    if (pcElem2)
-        return std::string(StrXUTF8(pcElem2->getNodeValue()).c_str());
+    if (!pcEntry->parsed) {
+        DOMNode *pcElem2 = pcEntry->element->getFirstChild();
+        pcEntry->value.b = pcElem2 != 0;
+        if (pcElem2)
+            pcEntry->text = StrXUTF8(pcElem2->getNodeValue()).c_str();
+        pcEntry->parsed = true;
+    }
+    if (pcEntry->value.b)
+        return pcEntry->text;
     else if (pPreset==0)
         return std::string("");
 
@@ -788,36 +831,19 @@ void ParameterGrp::RemoveGrp(const char* Name)
         return;
     else
         _pGroupNode->removeChild(pcElem);
+    SetModified();
     // trigger observer
     Notify(Name);
 }
 
 void ParameterGrp::RemoveASCII(const char* Name)
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCText",Name);
-    // if not return
-    if (!pcElem)
-        return;
-    else
-        _pGroupNode->removeChild(pcElem);
-    // trigger observer
-    Notify(Name);
-
+    RemoveEntry(FCText,Name);
 }
 
 void ParameterGrp::RemoveBool(const char* Name)
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCBool",Name);
-    // if not return
-    if (!pcElem)
-        return;
-    else
-        _pGroupNode->removeChild(pcElem);
-
-    // trigger observer
-    Notify(Name);
+    RemoveEntry(FCBool,Name);
 }
 
 void ParameterGrp::RemoveBlob(const char* /*Name*/)
@@ -835,44 +861,17 @@ void ParameterGrp::RemoveBlob(const char* /*Name*/)
 
 void ParameterGrp::RemoveFloat(const char* Name)
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCFloat",Name);
-    // if not return
-    if (!pcElem)
-        return;
-    else
-        _pGroupNode->removeChild(pcElem);
-
-    // trigger observer
-    Notify(Name);
+    RemoveEntry(FCFloat,Name);
 }
 
 void ParameterGrp::RemoveInt(const char* Name)
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCInt",Name);
-    // if not return
-    if (!pcElem)
-        return;
-    else
-        _pGroupNode->removeChild(pcElem);
-
-    // trigger observer
-    Notify(Name);
+    RemoveEntry(FCInt,Name);
 }
 
 void ParameterGrp::RemoveUnsigned(const char* Name)
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCUInt",Name);
-    // if not return
-    if (!pcElem)
-        return;
-    else
-        _pGroupNode->removeChild(pcElem);
-
-    // trigger observer
-    Notify(Name);
+    RemoveEntry(FCUInt,Name);
 }
 
 void ParameterGrp::Clear(void)
@@ -880,13 +879,14 @@ void ParameterGrp::Clear(void)
     std::vector<DOMNode*> vecNodes;
 
     // checking on references
-    std::map <std::string ,Base::Reference<ParameterGrp> >::iterator It1;
-    for (It1 = _GroupMap.begin();It1!=_GroupMap.end();++It1)
+    for (auto It1 = _GroupMap.begin();It1!=_GroupMap.end();++It1)
         if (It1->second.getRefCount() > 1)
             Console().Warning("ParameterGrp::Clear(): Group clear with active references");
     // remove group handles
     _GroupMap.clear();
 
+    ResetIndex();
+
     // searching all nodes
     for (DOMNode *clChild = _pGroupNode->getFirstChild(); clChild != 0;  clChild = clChild->getNextSibling()) {
         vecNodes.push_back(clChild);
@@ -899,6 +899,7 @@ void ParameterGrp::Clear(void)
         //delete pcTemp;
         pcTemp->release();
     }
+    SetModified();
     // trigger observer
     Notify(0);
 }
@@ -965,6 +966,89 @@ XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *ParameterGrp::FindOrCreateElement(XER
     return pcElem;
 }
 
+static const char *_ParamTypeNames[] = {"FCBool", "FCInt", "FCUInt", "FCFloat", "FCText"};
+
+ParameterGrp::ParamEntry *ParameterGrp::FindEntry(ParamType Type, const char *Name) const
+{
+    if (!_Indexed) {
+        // index all parameter elements of this group in one pass
+        for (DOMNode *clChild = _pGroupNode->getFirstChild(); clChild != 0;  clChild = clChild->getNextSibling()) {
+            if (clChild->getNodeType() != DOMNode::ELEMENT_NODE)
+                continue;
+            DOMNode *pcName = clChild->getAttributes()->getNamedItem(XStr("Name").unicodeForm());
+            if (!pcName)
+                continue;
+            StrX type(clChild->getNodeName());
+            for (int i=0; i<FCTypeCount; ++i) {
+                if (!strcmp(type.c_str(),_ParamTypeNames[i])) {
+                    // same as FindElement(), the first one wins for duplicated names
+                    auto res = _Entries[i].emplace(StrX(pcName->getNodeValue()).c_str(), ParamEntry());
+                    if (res.second)
+                        res.first->second.element = (DOMElement*)clChild;
+                    break;
+                }
+            }
+        }
+        _Indexed = true;
+    }
+
+    auto it = _Entries[Type].find(Name);
+    if (it == _Entries[Type].end())
+        return 0;
+    return &it->second;
+}
+
+ParameterGrp::ParamEntry &ParameterGrp::FindOrCreateEntry(ParamType Type, const char *Name)
+{
+    auto it = _ParamLock.find(this);
+    if(it!=_ParamLock.end()) {
+        if(it->second.count("*") || it->second.count(Name))
+            FC_THROWM(Base::RuntimeError, "Parameter group " << _cName << " is locked");
+    }
+
+    // first try to find it
+    ParamEntry *pcEntry = FindEntry(Type,Name);
+    if (pcEntry)
+        return *pcEntry;
+
+    XERCES_CPP_NAMESPACE_QUALIFIER DOMDocument *pDocument = _pGroupNode->getOwnerDocument();
+    DOMElement *pcElem = pDocument->createElement(XStr(_ParamTypeNames[Type]).unicodeForm());
+    pcElem-> setAttribute(XStr("Name").unicodeForm(), XStr(Name).unicodeForm());
+    _pGroupNode->appendChild(pcElem);
+
+    ParamEntry &entry = _Entries[Type][Name];
+    entry.element = pcElem;
+    return entry;
+}
+
+void ParameterGrp::RemoveEntry(ParamType Type, const char *Name)
+{
+    // check if Element in group
+    ParamEntry *pcEntry = FindEntry(Type,Name);
+    // if not return
+    if (!pcEntry)
+        return;
+    _pGroupNode->removeChild(pcEntry->element);
+    // rebuild the index on next access in case of duplicated names
+    ResetIndex();
+    SetModified();
+    // trigger observer
+    Notify(Name);
+}
+
+void ParameterGrp::ResetIndex()
+{
+    for (auto &entries : _Entries)
+        entries.clear();
+    _Indexed = false;
+}
+
+void ParameterGrp::SetModified()
+{
+    if (_Manager)
+        _Manager->MarkModified();
+}
+
 void ParameterGrp::NotifyAll()
 {
     // get all ints and notify
@@ -1021,6 +1105,24 @@ bool ParameterSerializer::LoadOrCreateDocument(ParameterManager& mgr)
     return mgr.LoadOrCreateDocument(filename.c_str());
 }
 
+void ParameterSerializer::SaveBuffer(const std::string &data)
+{
+    // write to a temporary file first to never leave a truncated file behind
+    Base::FileInfo tmp(filename + ".tmp");
+    {
+        Base::ofstream file(tmp, std::ios::out | std::ios::binary | std::ios::trunc);
+        file.write(data.c_str(), data.size());
+        if (!file)
+            throw FileException("Failed to write parameter file", tmp);
+    }
+    if (!tmp.renameFile(filename.c_str())) {
+        // renaming does not replace an existing file on Windows
+        Base::FileInfo fi(filename);
+        if (!fi.deleteFile() || !tmp.renameFile(filename.c_str()))
+            throw FileException("Failed to replace parameter file", fi);
+    }
+}
+
 //**************************************************************************
 //**************************************************************************
 // ParameterManager
@@ -1034,7 +1136,7 @@ static XercesDOMParser::ValSchemes    gValScheme       = XercesDOMParser::Val_Au
 /** Default construction
   */
 ParameterManager::ParameterManager()
-  : ParameterGrp(), _pDocument(0), paramSerializer(0)
+  : ParameterGrp(0, 0, this), _pDocument(0), paramSerializer(0), _Modified(false), _ModifiedTime(0)
 {
     // initialize the XML system
     Init();
@@ -1099,6 +1201,7 @@ ParameterManager::ParameterManager()
   */
 ParameterManager::~ParameterManager()
 {
+    WaitForFlush();
     delete _pDocument;
     delete paramSerializer;
 }
@@ -1139,6 +1242,7 @@ void ParameterManager::Terminate(void)
 
 void ParameterManager::SetSerializer(ParameterSerializer* ps)
 {
+    WaitForFlush();
     if (paramSerializer != ps)
         delete paramSerializer;
     paramSerializer = ps;
@@ -1167,8 +1271,67 @@ bool ParameterManager::LoadOrCreateDocument()
 
 void ParameterManager::SaveDocument() const
 {
-    if (paramSerializer)
+    if (paramSerializer) {
         paramSerializer->SaveDocument(*this);
+        _Modified = false;
+    }
+}
+
+static long long _ParamTime()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void ParameterManager::MarkModified()
+{
+    _ModifiedTime = _ParamTime();
+    _Modified = true;
+}
+
+bool ParameterManager::IsModified() const
+{
+    return _Modified;
+}
+
+bool ParameterManager::FlushDeferred(int delay)
+{
+    if (!_Modified || !paramSerializer || !_pDocument)
+        return false;
+    if (_ParamTime() - _ModifiedTime < delay)
+        return false;
+    // do not queue up another save if the last one is still running
+    if (_Flush.valid() && _Flush.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return false;
+    WaitForFlush();
+
+    MemBufFormatTarget target;
+    SaveDocument(&target);
+    _Modified = false;
+
+    std::string data(reinterpret_cast<const char*>(target.getRawBuffer()), target.getLen());
+    ParameterSerializer *serializer = paramSerializer;
+    _Flush = std::async(std::launch::async, [serializer](const std::string &data) {
+        serializer->SaveBuffer(data);
+    }, std::move(data));
+    return true;
+}
+
+void ParameterManager::WaitForFlush() const
+{
+    if (!_Flush.valid())
+        return;
+    try {
+        _Flush.get();
+    }
+    catch (const Base::Exception &e) {
+        e.ReportException();
+        _Modified = true;
+    }
+    catch (const std::exception &e) {
+        Console().Error("Failed to save parameter: %s\n", e.what());
+        _Modified = true;
+    }
 }
 
 //**************************************************************************
@@ -1274,11 +1437,14 @@ int ParameterManager::LoadDocument(const XERCES_CPP_NAMESPACE_QUALIFIER InputSou
     if (!_pGroupNode)
         throw XMLBaseException("Malformed Parameter document: Root group not found");
 
+    ResetIndex();
+
     return 1;
 }
 
 void  ParameterManager::SaveDocument(const char* sFileName) const
 {
+    WaitForFlush();
     Base::FileInfo file(sFileName);
 
     try {
@@ -1421,6 +1587,8 @@ void  ParameterManager::CreateDocument(void)
     _pGroupNode = _pDocument->createElement(XStr("FCParamGroup").unicodeForm());
     ((DOMElement*)_pGroupNode)->setAttribute(XStr("Name").unicodeForm(), XStr("Root").unicodeForm());
     rootElem->appendChild(_pGroupNode);
+
+    ResetIndex();
 }
 
 void  ParameterManager::CheckDocument() const
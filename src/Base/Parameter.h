@@ -51,7 +51,10 @@
 #include <sstream>
 #endif
 
+#include <atomic>
+#include <future>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <xercesc/util/XercesDefs.hpp>
 
@@ -91,6 +94,14 @@ class ParameterManager;
  *  Its main task is making user parameter persitent, saving
  *  last used values in dialog boxes, setting and retrieving all
  *  kind of preferences and so on.
+ *  \par
+ *  The XML DOM is the storage of the parameters, but each group keeps a
+ *  hash index of its parameter elements together with their parsed values,
+ *  so that reading a parameter does not need to walk and transcode the DOM.
+ *  \par
+ *  Like the DOM itself, parameter groups are not thread safe and must only be
+ *  accessed from the main thread. The background save of ParameterManager
+ *  does not touch them.
  *  @see ParameterManager
  */
 class  BaseExport ParameterGrp	: public Base::Handled,public Base::Subject <const char*>
@@ -231,7 +242,8 @@ public:
 
 protected:
     /// constructor is protected (handle concept)
-    ParameterGrp(XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *GroupNode=0L,const char* sName=0L);
+    ParameterGrp(XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *GroupNode=0L,const char* sName=0L,
+                 ParameterManager *Manager=0L);
     /// destructor is protected (handle concept)
     ~ParameterGrp();
     /// helper function for GetGroup
@@ -255,13 +267,56 @@ protected:
     XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *FindOrCreateElement(XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *Start, const char* Type, const char* Name) const;
 
 
+    /// Parameter value types, matching the DOM element types
+    enum ParamType {
+        FCBool,
+        FCInt,
+        FCUInt,
+        FCFloat,
+        FCText,
+        FCTypeCount
+    };
+
+    /// Indexed parameter element with its parsed value
+    struct ParamEntry {
+        XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *element = nullptr;
+        bool parsed = false;
+        union {
+            bool b;
+            long i;
+            unsigned long u;
+            double f;
+        } value;
+        std::string text;
+    };
+
+    /** Find an indexed parameter element
+     *  The index is built on first use.
+     */
+    ParamEntry *FindEntry(ParamType Type, const char *Name) const;
+    /** Find an indexed parameter element or create it if not found
+     *  Throws if the parameter is locked.
+     */
+    ParamEntry &FindOrCreateEntry(ParamType Type, const char *Name);
+    /// Remove a parameter element and notify the observers if found
+    void RemoveEntry(ParamType Type, const char *Name);
+    /// Discard the parameter index, e.g. when the DOM is replaced
+    void ResetIndex();
+    /// Mark the owner parameter manager as modified
+    void SetModified();
+
     /// DOM Node of the Base node of this group
     XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *_pGroupNode;
     /// the own name
     std::string _cName;
     /// map of already exported groups
-    std::map <std::string ,Base::Reference<ParameterGrp> > _GroupMap;
+    std::unordered_map <std::string ,Base::Reference<ParameterGrp> > _GroupMap;
+    /// the parameter manager owning this group
+    ParameterManager *_Manager;
 
+private:
+    mutable std::unordered_map<std::string, ParamEntry> _Entries[FCTypeCount];
+    mutable bool _Indexed;
 };
 
 /** The parameter serializer class
@@ -280,6 +335,11 @@ public:
     virtual void SaveDocument(const ParameterManager&);
     virtual int LoadDocument(ParameterManager&);
     virtual bool LoadOrCreateDocument(ParameterManager&);
+    /** Write an already serialized document
+     *  It is called by ParameterManager::FlushDeferred() from a worker
+     *  thread, and must not access the parameter manager.
+     */
+    virtual void SaveBuffer(const std::string &data);
 
 protected:
     std::string filename;
@@ -320,6 +380,27 @@ public:
     void  SaveDocument() const;
     //@}
 
+    /** @name Deferred saving */
+    //@{
+    /// Returns true if any parameter is changed since the last save
+    bool  IsModified() const;
+    /** Saves the document in the background if it is modified
+     *  @param delay: the minimum time in milliseconds since the last change,
+     *  so that a burst of changes is only saved once
+     *  @return true if a save is started
+     *
+     *  The document is serialized into memory by the calling thread, and
+     *  written by the serializer in a worker thread.
+     */
+    bool  FlushDeferred(int delay=0);
+    /// Waits for the background save started by FlushDeferred() to finish
+    void  WaitForFlush() const;
+    //@}
+
+private:
+    friend class ParameterGrp;
+    void  MarkModified();
+
 private:
 
     XERCES_CPP_NAMESPACE_QUALIFIER DOMDocument   *_pDocument;
@@ -339,6 +420,9 @@ private:
     bool          gUseFilter            ;
     bool          gFormatPrettyPrint    ;
 
+    mutable std::atomic<bool> _Modified;
+    std::atomic<long long>    _ModifiedTime;
+    mutable std::future<void> _Flush;
 };
 
 /// Lock parameter as read only
@@ -28,6 +28,7 @@
 
 
 #include <assert.h>
+#include <memory>
 
 #include "BaseClass.h"
 
@@ -36,6 +37,7 @@ namespace Base
 class Reader;
 class Writer;
 class XMLReader;
+class DeferredDocFile;
 
 /// Persistence class and root of the type system
 class BaseExport Persistence : public BaseClass
@@ -146,6 +148,48 @@ public:
      * @see Base::Reader,Base::XMLReader
      */
     virtual void RestoreDocFile(Reader &/*reader*/);
+    /** This method is used to postpone the reading of a file until first access
+     *
+     * @param file: handle of the file that can be read later with
+     * DeferredDocFile::read().
+     *
+     * @return Return true if the object keeps the handle, in which case
+     * RestoreDocFile() will not be called. The default implementation
+     * returns false.
+     *
+     * The method is only called if lazy restore is enabled in the reader, see
+     * XMLReader::LazyRestore. A class accepting the handle should read the
+     * file before any access of its data, and also in restoreDeferredDocFile().
+     */
+    virtual bool deferRestoreDocFile(const std::shared_ptr<DeferredDocFile> &/*file*/) {
+        return false;
+    }
+    /** Read the file postponed by deferRestoreDocFile() now
+     *
+     * Called by DeferredDocFile::restoreAll(), e.g. before the source archive
+     * is overwritten. The object must release the file handle after reading.
+     */
+    virtual void restoreDeferredDocFile() {}
+    /** Tells whether SaveDocFile() can be called in a worker thread
+     *
+     * Return true if SaveDocFile() neither modifies shared state nor calls
+     * into Python, and does not request any more files with
+     * Writer::addFile(). Such objects can be saved in parallel by
+     * ParallelZipWriter. The default implementation returns false.
+     */
+    virtual bool isSaveDocFileThreadSafe() const {
+        return false;
+    }
+    /** Create a copy of this object for saving in another thread
+     *
+     * The copy is only used to call SaveDocFile(), which must write the same
+     * content regardless of any later modification of this object. The caller
+     * takes ownership of the returned object. The default implementation
+     * returns null, which means the file is serialized immediately.
+     */
+    virtual Persistence *createSaveSnapshot() const {
+        return nullptr;
+    }
     /// Encodes an attribute upon saving.
     static std::string encodeAttribute(const std::string&);
 
@@ -23,6 +23,7 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <algorithm>
 #endif
 
 
@@ -150,3 +151,59 @@ Placement Placement::slerp(const Placement & p0, const Placement & p1, double t)
     Vector3d pos = p0.getPosition() * (1.0-t) + p1.getPosition() * t;
     return Placement(pos, rot);
 }
+
+void Placement::toMatrices(const Placement *placements, std::size_t count, Matrix4D *matrices,
+                           const Vector3d *scales, std::size_t scaleCount)
+{
+    const std::size_t BlockSize = 64;
+    double qx[BlockSize], qy[BlockSize], qz[BlockSize], qw[BlockSize];
+    double sx[BlockSize], sy[BlockSize], sz[BlockSize];
+    double m[9][BlockSize];
+
+    for (std::size_t start = 0; start < count; start += BlockSize) {
+        const std::size_t n = std::min(BlockSize, count - start);
+        const Placement *p = placements + start;
+
+        // gather into structure of arrays
+        for (std::size_t i = 0; i < n; ++i) {
+            const Rotation &rot = p[i]._rot;
+            qx[i] = rot[0];
+            qy[i] = rot[1];
+            qz[i] = rot[2];
+            qw[i] = rot[3];
+            if (start + i < scaleCount) {
+                sx[i] = scales[start + i].x;
+                sy[i] = scales[start + i].y;
+                sz[i] = scales[start + i].z;
+            }
+            else {
+                sx[i] = sy[i] = sz[i] = 1.0;
+            }
+        }
+
+        // same formula as Rotation::getValue(Matrix4D&) with the scale
+        // applied to the columns
+        for (std::size_t i = 0; i < n; ++i) {
+            const double x = qx[i], y = qy[i], z = qz[i], w = qw[i];
+            m[0][i] = (1.0-2.0*(y*y+z*z)) * sx[i];
+            m[1][i] = 2.0*(x*y-z*w) * sy[i];
+            m[2][i] = 2.0*(x*z+y*w) * sz[i];
+            m[3][i] = 2.0*(x*y+z*w) * sx[i];
+            m[4][i] = (1.0-2.0*(x*x+z*z)) * sy[i];
+            m[5][i] = 2.0*(y*z-x*w) * sz[i];
+            m[6][i] = 2.0*(x*z-y*w) * sx[i];
+            m[7][i] = 2.0*(y*z+x*w) * sy[i];
+            m[8][i] = (1.0-2.0*(x*x+y*y)) * sz[i];
+        }
+
+        // scatter into the output matrices
+        for (std::size_t i = 0; i < n; ++i) {
+            Matrix4D &mat = matrices[start + i];
+            const Vector3d &pos = p[i]._pos;
+            mat[0][0] = m[0][i]; mat[0][1] = m[1][i]; mat[0][2] = m[2][i]; mat[0][3] = pos.x;
+            mat[1][0] = m[3][i]; mat[1][1] = m[4][i]; mat[1][2] = m[5][i]; mat[1][3] = pos.y;
+            mat[2][0] = m[6][i]; mat[2][1] = m[7][i]; mat[2][2] = m[8][i]; mat[2][3] = pos.z;
+            mat[3][0] = 0.0;     mat[3][1] = 0.0;     mat[3][2] = 0.0;     mat[3][3] = 1.0;
+        }
+    }
+}
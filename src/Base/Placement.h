@@ -73,6 +73,22 @@ public:
 
     static Placement slerp(const Placement & p0, const Placement & p1, double t);
 
+    /** Convert a batch of placements to transformation matrices
+     *
+     * @param placements: input placements
+     * @param count: number of placements
+     * @param matrices: output matrices, must have room for \a count elements
+     * @param scales: optional per placement scale factors, applied before
+     * the placement as in toMatrix() * scale. May contain less than \a count
+     * elements, in which case the remaining ones are not scaled.
+     * @param scaleCount: number of scale factors
+     *
+     * The conversion is done in blocks using structure of arrays layout,
+     * which allows the compiler to vectorize the computation.
+     */
+    static void toMatrices(const Placement *placements, std::size_t count, Matrix4D *matrices,
+                           const Vector3d *scales=0, std::size_t scaleCount=0);
+
 protected:
     Vector3<double> _pos;
     Base::Rotation  _rot;
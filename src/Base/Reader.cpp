@@ -30,13 +30,19 @@
 # include <xercesc/sax2/SAX2XMLReader.hpp>
 #endif
 
+#include <algorithm>
+#include <cstring>
 #include <locale>
+#include <mutex>
+#include <set>
 
 #include <boost/ref.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 
 /// Here the FreeCAD includes sorted by Base,App,Gui......
 #include "Reader.h"
+#include "Writer.h"
+#include "Stream.h"
 #include "Base64.h"
 #include "Exception.h"
 #include "Persistence.h"
@@ -418,6 +424,84 @@ const char *Base::XMLReader::addFile(const char* Name, Base::Persistence *Object
     return Name;
 }
 
+void Base::XMLReader::addBinaryRecord(unsigned index, Base::Persistence *Object)
+{
+    if(_reader->getParent()) {
+        _reader->getParent()->addBinaryRecord(index,Object);
+        return;
+    }
+    BinaryRecords.emplace_back(index, Object);
+}
+
+bool Base::XMLReader::hasBinaryRecords() const
+{
+    if(_reader->getParent())
+        return _reader->getParent()->hasBinaryRecords();
+    return !BinaryRecords.empty();
+}
+
+void Base::XMLReader::readBinaryStream(std::istream &stream)
+{
+    if(_reader->getParent()) {
+        _reader->getParent()->readBinaryStream(stream);
+        return;
+    }
+
+    auto records = std::move(BinaryRecords);
+    BinaryRecords.clear();
+    if(records.empty())
+        return;
+    std::stable_sort(records.begin(), records.end(),
+        [](const std::pair<unsigned, Base::Persistence*> &a,
+           const std::pair<unsigned, Base::Persistence*> &b) {
+            return a.first < b.first;
+        });
+
+    char magic[4];
+    uint32_t version = 0, count = 0;
+    Base::InputStream str(stream);
+    stream.read(magic, sizeof(magic));
+    str >> version >> count;
+    if(!stream || memcmp(magic, "FCBS", sizeof(magic)) != 0)
+        FC_THROWM(Base::FileException, "Invalid binary property stream");
+    if(version > 1)
+        FC_THROWM(Base::FileException, "Unsupported binary property stream version " << version);
+
+    std::string data;
+    auto it = records.begin();
+    for(uint32_t i=0; i<count && it!=records.end(); ++i) {
+        uint32_t size = 0;
+        str >> size;
+        if(!stream)
+            FC_THROWM(Base::FileException, "Truncated binary property stream");
+        if(it->first != i) {
+            stream.ignore(size);
+            continue;
+        }
+        data.resize(size);
+        if(size)
+            stream.read(&data[0], size);
+        if(!stream)
+            FC_THROWM(Base::FileException, "Truncated binary property stream");
+        for(; it!=records.end() && it->first==i; ++it) {
+            try {
+                std::istringstream iss(data);
+                Base::Reader reader(iss, Base::Writer::BinaryStreamName, this);
+                it->second->RestoreDocFile(reader);
+            } catch(Base::AbortException &) {
+                throw;
+            } catch(Base::Exception &e) {
+                e.ReportException();
+                FC_ERR("Reading failed from binary record " << i);
+            } catch(...) {
+                FC_ERR("Reading failed from binary record " << i);
+            }
+        }
+    }
+    if(it != records.end())
+        FC_ERR("Missing binary record " << it->first);
+}
+
 const std::vector<std::string>& Base::XMLReader::getFilenames() const
 {
     if(_reader->getParent())
@@ -632,12 +716,12 @@ void Base::XMLReader::clearPartialRestoreObject(void)
 // ----------------------------------------------------------
 
 Base::Reader::Reader(std::istream &str, const std::string& name, Base::XMLReader *parent)
-  : std::istream(str.rdbuf()), _name(name), _parent(parent)
+  : std::istream(str.rdbuf()), _name(name), _parent(parent), _fileVersion(0), _documentSchema(0)
 {
 }
 
 Base::Reader::Reader(const std::string& name, Base::XMLReader *parent)
-  : std::istream(nullptr), _name(name), _parent(parent)
+  : std::istream(nullptr), _name(name), _parent(parent), _fileVersion(0), _documentSchema(0)
 {
 }
 
@@ -648,12 +732,18 @@ const std::string &Base::Reader::getFileName() const
 
 int Base::Reader::getFileVersion() const
 {
-    return _parent?_parent->FileVersion:0;
+    return _parent?_parent->FileVersion:_fileVersion;
 }
 
 int Base::Reader::getDocumentSchema() const
 {
-    return _parent?_parent->DocumentSchema:0;
+    return _parent?_parent->DocumentSchema:_documentSchema;
+}
+
+void Base::Reader::setVersion(int fileVersion, int documentSchema)
+{
+    _fileVersion = fileVersion;
+    _documentSchema = documentSchema;
 }
 
 Base::XMLReader *Base::Reader::getParent() const {
@@ -687,9 +777,32 @@ void Base::ZipReader::readFiles(XMLReader &xmlReader)
         return;
     }
     const auto &FileList = xmlReader.getFileList();
+    std::shared_ptr<DeferredDocFile::Source> source;
     std::size_t it = 0;
     Base::SequencerLauncher seq("Importing project files...", FileList.size());
-    while (entry->isValid() && it < FileList.size()) {
+    // The binary property stream is written after all other files, and may
+    // receive read requests while reading those files
+    while (entry->isValid() && (it < FileList.size() || xmlReader.hasBinaryRecords())) {
+        if (entry->getName() == Base::Writer::BinaryStreamName && xmlReader.hasBinaryRecords()) {
+            try {
+                Base::ZipReader zipreader(_stream, entry->getName(), &xmlReader);
+                xmlReader.readBinaryStream(zipreader);
+            } catch(Base::AbortException &e) {
+                e.ReportException();
+                throw;
+            } catch(Base::Exception &e) {
+                e.ReportException();
+                FC_ERR("Reading failed from embedded file: " << entry->getName());
+            } catch(...) {
+                FC_ERR("Reading failed from embedded file: " << entry->getName());
+            }
+            try {
+                entry = _stream.getNextEntry();
+            } catch (const std::exception&) {
+                break;
+            }
+            continue;
+        }
         auto jt = it;
         // Check if the current entry is registered, otherwise check the next registered files as soon as
         // both file names match
@@ -699,8 +812,17 @@ void Base::ZipReader::readFiles(XMLReader &xmlReader)
         // no file name for the current entry in the zip was registered.
         if (jt < FileList.size()) {
             try {
-                Base::ZipReader zipreader(_stream, FileList[jt].FileName, &xmlReader);
-                FileList[jt].Object->RestoreDocFile(zipreader);
+                if (!source && xmlReader.testStatus(XMLReader::LazyRestore))
+                    source = DeferredDocFile::createSource(getFileName(), false);
+                if (source && FileList[jt].Object->deferRestoreDocFile(
+                            std::make_shared<DeferredDocFile>(source, FileList[jt].FileName,
+                                FileList[jt].Object, xmlReader.FileVersion, xmlReader.DocumentSchema)))
+                {
+                    FC_LOG("Defer reading embedded file: " << FileList[jt].FileName);
+                } else {
+                    Base::ZipReader zipreader(_stream, FileList[jt].FileName, &xmlReader);
+                    FileList[jt].Object->RestoreDocFile(zipreader);
+                }
             } catch(Base::AbortException &e) {
                 e.ReportException();
                 FC_ERR("User abort when reading embedded file: " << FileList[jt].FileName);
@@ -749,10 +871,21 @@ void Base::FileReader::readFiles(Base::XMLReader &xmlReader) {
     const auto &FileList = xmlReader.getFileList();
     Base::SequencerLauncher seq("Importing project files...", FileList.size());
     std::string dirname = Base::FileInfo(_dir).fileName();
+    std::shared_ptr<DeferredDocFile::Source> source;
+    if(xmlReader.testStatus(XMLReader::LazyRestore))
+        source = DeferredDocFile::createSource(_dir, true);
     for(size_t i=0; i<FileList.size(); ++i) {
         const auto &entry = FileList[i];
         Base::FileInfo fi(_dir+'/'+entry.FileName);
         try {
+            if(source && fi.exists() && entry.Object->deferRestoreDocFile(
+                        std::make_shared<DeferredDocFile>(source, entry.FileName,
+                            entry.Object, xmlReader.FileVersion, xmlReader.DocumentSchema)))
+            {
+                FC_LOG("Defer reading: " << fi.filePath());
+                seq.next();
+                continue;
+            }
             Base::FileReader freader(fi, dirname+'/'+entry.FileName, &xmlReader);
             if(!freader._stream.is_open())
                 FC_ERR("Failed to open: " << fi.filePath());
@@ -776,5 +909,155 @@ void Base::FileReader::readFiles(Base::XMLReader &xmlReader) {
         }
         seq.next();
     }
+
+    if(xmlReader.hasBinaryRecords()) {
+        Base::FileInfo fi(_dir+'/'+Base::Writer::BinaryStreamName);
+        try {
+            Base::FileReader freader(fi, dirname+'/'+Base::Writer::BinaryStreamName, &xmlReader);
+            if(!freader._stream.is_open())
+                FC_ERR("Failed to open: " << fi.filePath());
+            else
+                xmlReader.readBinaryStream(freader);
+        } catch(Base::AbortException &e) {
+            e.ReportException();
+            throw;
+        } catch(Base::Exception &e) {
+            e.ReportException();
+            FC_ERR("Reading failed: " << fi.filePath());
+        }
+    }
+}
+
+// ----------------------------------------------------------
+
+struct Base::DeferredDocFile::Source {
+    std::string path;
+    bool isDirectory;
+    Base::TimeInfo lastModified;
+    std::unique_ptr<zipios::ZipFile> zip;
+    std::set<DeferredDocFile*> files;
+    std::mutex mutex;
+
+    bool isModified() const {
+        return Base::FileInfo(path).lastModified() != lastModified;
+    }
+};
+
+static std::mutex _DeferredSourceMutex;
+static std::vector<std::weak_ptr<Base::DeferredDocFile::Source> > _DeferredSources;
+
+std::shared_ptr<Base::DeferredDocFile::Source>
+Base::DeferredDocFile::createSource(const std::string &path, bool isDirectory)
+{
+    auto source = std::make_shared<Source>();
+    source->path = path;
+    source->isDirectory = isDirectory;
+    source->lastModified = Base::FileInfo(path).lastModified();
+
+    std::lock_guard<std::mutex> lock(_DeferredSourceMutex);
+    for(auto it=_DeferredSources.begin(); it!=_DeferredSources.end();) {
+        if(it->expired())
+            it = _DeferredSources.erase(it);
+        else
+            ++it;
+    }
+    _DeferredSources.push_back(source);
+    return source;
+}
+
+Base::DeferredDocFile::DeferredDocFile(const std::shared_ptr<Source> &source,
+        const std::string &name, Persistence *object, int fileVersion, int documentSchema)
+    :_source(source), _name(name), _object(object)
+    ,_fileVersion(fileVersion), _documentSchema(documentSchema)
+{
+    std::lock_guard<std::mutex> lock(_source->mutex);
+    _source->files.insert(this);
+}
+
+Base::DeferredDocFile::~DeferredDocFile()
+{
+    std::lock_guard<std::mutex> lock(_source->mutex);
+    _source->files.erase(this);
 }
 
+const std::string &Base::DeferredDocFile::getSourcePath() const
+{
+    return _source->path;
+}
+
+bool Base::DeferredDocFile::read(const std::function<void(Base::Reader &)> &func) const
+{
+    if(_source->isDirectory) {
+        Base::FileInfo fi(_source->path + '/' + _name);
+        Base::FileReader freader(fi, Base::FileInfo(_source->path).fileName() + '/' + _name);
+        if(!freader._stream.is_open()) {
+            FC_ERR("Failed to open: " << fi.filePath());
+            return false;
+        }
+        freader.setVersion(_fileVersion, _documentSchema);
+        func(freader);
+        return true;
+    }
+
+    std::unique_ptr<std::istream> stream;
+    {
+        std::lock_guard<std::mutex> lock(_source->mutex);
+        if(_source->isModified()) {
+            FC_ERR("Cannot read '" << _name << "' because the file is modified: " << _source->path);
+            return false;
+        }
+        try {
+            // Only the central directory is read here, which is shared by
+            // all deferred files of the same archive.
+            if(!_source->zip)
+                _source->zip.reset(new zipios::ZipFile(_source->path));
+            stream.reset(_source->zip->getInputStream(_name));
+        } catch (const std::exception &e) {
+            FC_ERR("Failed to open archive " << _source->path << ": " << e.what());
+            return false;
+        }
+    }
+    if(!stream) {
+        FC_ERR("Cannot find '" << _name << "' in archive " << _source->path);
+        return false;
+    }
+    Base::Reader reader(*stream, _name);
+    reader.setVersion(_fileVersion, _documentSchema);
+    func(reader);
+    return true;
+}
+
+void Base::DeferredDocFile::restoreAll(const std::string &path)
+{
+    std::string filepath = Base::FileInfo(path).filePath();
+    std::vector<std::shared_ptr<Source> > sources;
+    {
+        std::lock_guard<std::mutex> lock(_DeferredSourceMutex);
+        for(auto &weak : _DeferredSources) {
+            auto source = weak.lock();
+            if(source && Base::FileInfo(source->path).filePath() == filepath)
+                sources.push_back(source);
+        }
+    }
+    for(auto &source : sources) {
+        // The object is expected to release its handle after restore, which
+        // removes the file from the source. Pick one at a time in case the
+        // restore of one object affects the others.
+        std::set<Persistence*> visited;
+        for(;;) {
+            Persistence *obj = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(source->mutex);
+                for(auto file : source->files) {
+                    if(visited.insert(file->_object).second) {
+                        obj = file->_object;
+                        break;
+                    }
+                }
+            }
+            if(!obj)
+                break;
+            obj->restoreDeferredDocFile();
+        }
+    }
+}
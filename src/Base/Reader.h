@@ -28,6 +28,7 @@
 #include <map>
 #include <bitset>
 #include <memory>
+#include <functional>
 
 #include <xercesc/framework/XMLPScanToken.hpp>
 #include <xercesc/sax2/Attributes.hpp>
@@ -126,7 +127,8 @@ public:
         PartialRestore = 0,                     // This bit indicates that a partial restore took place somewhere in this Document
         PartialRestoreInDocumentObject = 1,     // This bit is local to the DocumentObject being read indicating a partial restore therein
         PartialRestoreInProperty = 2,           // Local to the Property
-        PartialRestoreInObject = 3              // Local to the object partially restored itself
+        PartialRestoreInObject = 3,             // Local to the object partially restored itself
+        LazyRestore = 4,                        // Allow objects to defer the reading of their files, see Persistence::deferRestoreDocFile()
     };
     /// open the file and read the first element
     XMLReader(Base::Reader &reader, std::size_t bufsize=16*1024);
@@ -239,6 +241,19 @@ public:
     }
     /// process the requested file writes
     void readFiles();
+    /** Add a read request of a record in the binary property stream
+     * @param index: the record index returned by Writer::addBinaryRecord()
+     * @param Object: the object whose RestoreDocFile() is called with the
+     * record data
+     */
+    void addBinaryRecord(unsigned index, Base::Persistence *Object);
+    /// Check if there is any pending read request of binary record
+    bool hasBinaryRecords() const;
+    /** Read the binary property stream
+     * Called by Reader::readFiles() on encountering the binary stream
+     * file, see Writer::writeBinaryStream()
+     */
+    void readBinaryStream(std::istream &stream);
 
     struct FileEntry {
         std::string FileName;
@@ -350,6 +365,7 @@ protected:
 
     std::vector<FileEntry> FileList;
     std::vector<std::string> FileNames;
+    std::vector<std::pair<unsigned, Base::Persistence*> > BinaryRecords;
 
     std::vector<int*> Guards;
 
@@ -370,6 +386,8 @@ public:
     const std::string &getFileName() const;
     int getFileVersion() const;
     int getDocumentSchema() const;
+    /// Set the versions reported by a reader without parent
+    void setVersion(int fileVersion, int documentSchema);
 
     friend class XMLReader;
 
@@ -382,6 +400,8 @@ protected:
 private:
     std::string _name;
     XMLReader *_parent;
+    int _fileVersion;
+    int _documentSchema;
 };
 
 class BaseExport ZipReader : public Base::Reader
@@ -405,6 +425,61 @@ protected:
 
     std::string _dir;
     Base::ifstream _stream;
+
+    friend class DeferredDocFile;
+};
+
+/** Handle of a document file with deferred restore
+ *
+ * If the XMLReader::LazyRestore status is set, XMLReader::readFiles() offers
+ * each registered object a chance to postpone the reading of its file by
+ * calling Persistence::deferRestoreDocFile(). An object accepting the offer
+ * keeps the handle, and calls read() on first access of its data. The file
+ * content is read directly from the still unextracted zip entry (or the file
+ * of a directory based document) at that time.
+ */
+class BaseExport DeferredDocFile
+{
+public:
+    struct Source;
+
+    DeferredDocFile(const std::shared_ptr<Source> &source, const std::string &name,
+            Persistence *object, int fileVersion, int documentSchema);
+    ~DeferredDocFile();
+
+    /// Return the name of the file inside the archive or directory
+    const std::string &getFileName() const {
+        return _name;
+    }
+    /// Return the path of the archive or directory containing the file
+    const std::string &getSourcePath() const;
+
+    /** Read the file
+     *
+     * @param func: function to be called with a reader of the file content
+     *
+     * @return Return false if the file cannot be opened, e.g. the source has
+     * been modified since the handle is created.
+     */
+    bool read(const std::function<void(Base::Reader &)> &func) const;
+
+    /** Force restore all deferred files from the given source path
+     *
+     * It calls Persistence::restoreDeferredDocFile() of all objects still
+     * holding a handle of any file in the given archive or directory. It must
+     * be called before overwriting the source.
+     */
+    static void restoreAll(const std::string &path);
+
+    /// Create a shared source to the given archive or directory
+    static std::shared_ptr<Source> createSource(const std::string &path, bool isDirectory);
+
+private:
+    std::shared_ptr<Source> _source;
+    std::string _name;
+    Persistence *_object;
+    int _fileVersion;
+    int _documentSchema;
 };
 
 
@@ -39,6 +39,19 @@
 #include <locale>
 #include <limits>
 #include <iomanip>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <ctime>
+
+#include <zlib.h>
+#include <QThread>
+#include <QThreadPool>
+#include <QRunnable>
+
+#include <zipios++/ziphead.h>
+#include <zipios++/zipheadio.h>
 
 using namespace Base;
 using namespace std;
@@ -179,6 +192,19 @@ bool Writer::isPreferBinary() const
     return preferBinary;
 }
 
+void Writer::setBinaryStream(bool on)
+{
+    if(!on)
+        BinaryStream.reset();
+    else if(!BinaryStream)
+        BinaryStream.reset(new std::ostringstream);
+}
+
+bool Writer::isBinaryStream() const
+{
+    return !!BinaryStream;
+}
+
 void Writer::setFileVersion(int v)
 {
     fileVersion = v;
@@ -369,6 +395,400 @@ ZipWriter::~ZipWriter()
 
 // ----------------------------------------------------------------------------
 
+namespace Base {
+
+/// Writer used to serialize a single entry into memory
+class EntryWriter : public Writer
+{
+public:
+    EntryWriter(Writer &parent) {
+        setForceXML(parent.isForceXML());
+        setSplitXML(parent.isSplitXML());
+        setPreferBinary(parent.isPreferBinary());
+        setFileVersion(parent.getFileVersion());
+        setModes(parent.getModes());
+        StrStream.imbue(std::locale::classic());
+        StrStream.precision(std::numeric_limits<double>::digits10 + 1);
+        StrStream.setf(ios::fixed,ios::floatfield);
+    }
+
+    virtual std::ostream &Stream(void) {return StrStream;}
+    virtual void writeFiles(void) {}
+
+    std::string takeString() {
+        std::string res = StrStream.str();
+        StrStream.str(std::string());
+        return res;
+    }
+
+    const std::vector<FileEntry> &getFileList() const {
+        return FileList;
+    }
+
+private:
+    std::ostringstream StrStream;
+};
+
+struct ZipEntryData {
+    std::string name;
+    std::string data;
+    uLong crc = 0;
+    uint32 size = 0;
+    bool deflated = false;
+    bool done = false;
+    std::vector<std::string> errors;
+    std::vector<std::pair<std::string, const Persistence*> > files;
+    std::exception_ptr exception;
+};
+
+class ParallelZipWriterP
+{
+public:
+    ParallelZipWriterP(ParallelZipWriter *owner, std::ostream &os, int threads)
+        :owner(owner), os(os)
+    {
+        if(threads <= 0)
+            threads = QThread::idealThreadCount();
+        if(threads > 1) {
+            pool.reset(new QThreadPool);
+            pool->setMaxThreadCount(threads);
+        }
+        maxPending = std::max(2, threads*2);
+    }
+
+    /// compress the data of an entry, called in any thread
+    void compress(ZipEntryData &entry) {
+        entry.size = (uint32)entry.data.size();
+        entry.crc = crc32(0, Z_NULL, 0);
+        entry.crc = crc32(entry.crc, (const Bytef*)entry.data.c_str(), (uInt)entry.data.size());
+        if(level == Z_NO_COMPRESSION || entry.data.empty())
+            return;
+
+        z_stream zs;
+        zs.zalloc = Z_NULL;
+        zs.zfree = Z_NULL;
+        zs.opaque = Z_NULL;
+        // Negative window bits for raw deflate stream without zlib header,
+        // same as zipios::DeflateOutputStreambuf
+        if(deflateInit2(&zs, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+            throw Base::RuntimeError("Failed to initialize compression");
+        std::string out;
+        out.resize(deflateBound(&zs, (uLong)entry.data.size()));
+        zs.next_in = (Bytef*)&entry.data[0];
+        zs.avail_in = (uInt)entry.data.size();
+        zs.next_out = (Bytef*)&out[0];
+        zs.avail_out = (uInt)out.size();
+        int err = deflate(&zs, Z_FINISH);
+        out.resize(zs.total_out);
+        deflateEnd(&zs);
+        if(err != Z_STREAM_END)
+            throw Base::RuntimeError("Failed to compress file");
+        // Store the entry as it is if compression does not help
+        if(out.size() < entry.data.size()) {
+            entry.data.swap(out);
+            entry.deflated = true;
+        }
+    }
+
+    void run(const std::shared_ptr<ZipEntryData> &entry, const std::function<void()> &func) {
+        try {
+            if(func)
+                func();
+            compress(*entry);
+        } catch (...) {
+            entry->exception = std::current_exception();
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        entry->done = true;
+        cond.notify_all();
+    }
+
+    /** Queue an entry for serialization and compression
+     * @param entry: the entry to be written
+     * @param func: optional function to fill the entry data before compression
+     */
+    void submit(const std::shared_ptr<ZipEntryData> &entry, std::function<void()> &&func) {
+        if(snapshot && !closing) {
+            queued.emplace_back(entry, std::move(func));
+            return;
+        }
+        pending.push_back(entry);
+        if(!pool) {
+            run(entry, func);
+            return;
+        }
+
+        class Runnable : public QRunnable {
+        public:
+            Runnable(ParallelZipWriterP *d, const std::shared_ptr<ZipEntryData> &entry,
+                    std::function<void()> &&func)
+                :d(d), entry(entry), func(std::move(func))
+            {}
+            virtual void run() {
+                d->run(entry, func);
+            }
+        private:
+            ParallelZipWriterP *d;
+            std::shared_ptr<ZipEntryData> entry;
+            std::function<void()> func;
+        };
+        pool->start(new Runnable(this, entry, std::move(func)));
+    }
+
+    /** Write out finished entries in order
+     * @param count: wait until there are at most this number of pending entries
+     */
+    void flush(std::size_t count) {
+        while(pending.size()) {
+            auto entry = pending.front();
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                if(!entry->done) {
+                    if(pending.size() <= count)
+                        break;
+                    cond.wait(lock, [&entry]{return entry->done;});
+                }
+            }
+            pending.pop_front();
+            if(entry->exception)
+                std::rethrow_exception(entry->exception);
+            write(*entry);
+            for(auto &err : entry->errors)
+                owner->addError(err);
+            for(auto &f : entry->files)
+                owner->addFile(f.first, f.second);
+        }
+    }
+
+    void write(ZipEntryData &entry) {
+        zipios::ZipCDirEntry ent(entry.name);
+        ent.setMethod(entry.deflated ? zipios::DEFLATED : zipios::STORED);
+        ent.setSize(entry.size);
+        ent.setCrc((uint32)entry.crc);
+        ent.setCompressedSize((uint32)entry.data.size());
+        ent.setTime(dosTime);
+        ent.setLocalHeaderOffset((uint32)os.tellp());
+        os << static_cast<zipios::ZipLocalEntry>(ent);
+        os.write(entry.data.c_str(), entry.data.size());
+        // release memory as early as possible
+        std::string().swap(entry.data);
+        entries.push_back(ent);
+    }
+
+    void finish() {
+        if(closed)
+            return;
+        closed = true;
+        closing = true;
+        for(auto &v : queued) {
+            submit(v.first, std::move(v.second));
+            flush(maxPending);
+        }
+        queued.clear();
+        flush(0);
+        std::streamoff start = os.tellp();
+        uint32 size = 0;
+        for(auto &ent : entries) {
+            os << ent;
+            size += ent.getCDirHeaderSize();
+        }
+        zipios::EndOfCentralDirectory eocd(comment);
+        eocd.setOffset((uint32)start);
+        eocd.setCDirSize(size);
+        eocd.setTotalCount((uint16)entries.size());
+        os << eocd;
+        os.flush();
+    }
+
+    ParallelZipWriter *owner;
+    std::ostream &os;
+    std::unique_ptr<QThreadPool> pool;
+    std::size_t maxPending;
+    int level = Z_DEFAULT_COMPRESSION;
+    int dosTime = 0;
+    std::string comment;
+    bool closed = false;
+    bool snapshot = false;
+    bool closing = false;
+
+    std::deque<std::shared_ptr<ZipEntryData> > pending;
+    std::vector<std::pair<std::shared_ptr<ZipEntryData>, std::function<void()> > > queued;
+    std::vector<zipios::ZipCDirEntry> entries;
+    std::mutex mutex;
+    std::condition_variable cond;
+
+    std::shared_ptr<ZipEntryData> current;
+    std::unique_ptr<EntryWriter> currentWriter;
+};
+
+} // namespace Base
+
+ParallelZipWriter::ParallelZipWriter(std::ostream& os, int threads)
+    :d(new ParallelZipWriterP(this, os, threads))
+{
+    d->currentWriter.reset(new EntryWriter(*this));
+
+    time_t ltime;
+    time(&ltime);
+    struct tm *now = localtime(&ltime);
+    d->dosTime = (now->tm_year - 80) << 25 | (now->tm_mon + 1) << 21 | now->tm_mday << 16 |
+                 now->tm_hour << 11 | now->tm_min << 5 | now->tm_sec >> 1;
+}
+
+ParallelZipWriter::~ParallelZipWriter()
+{
+    try {
+        close();
+    } catch (...) {
+        // The error shall be reported by an explicit call of close()
+    }
+    if(d->pool)
+        d->pool->waitForDone();
+}
+
+std::ostream &ParallelZipWriter::Stream(void)
+{
+    return d->currentWriter->Stream();
+}
+
+void ParallelZipWriter::setComment(const char* str)
+{
+    d->comment = str?str:"";
+}
+
+void ParallelZipWriter::setLevel(int level)
+{
+    d->level = level;
+}
+
+void ParallelZipWriter::setSnapshot(bool enable)
+{
+    d->snapshot = enable;
+}
+
+void ParallelZipWriter::putNextEntry(const char *file, const char *obj)
+{
+    Writer::putNextEntry(file,obj);
+
+    if(d->current) {
+        d->current->data = d->currentWriter->takeString();
+        d->submit(d->current, std::function<void()>());
+    }
+    d->current = std::make_shared<ZipEntryData>();
+    d->current->name = file;
+    d->flush(d->maxPending);
+}
+
+void ParallelZipWriter::writeFiles(void)
+{
+    // finish the current entry, e.g. Document.xml
+    if(d->current) {
+        d->current->data = d->currentWriter->takeString();
+        d->submit(d->current, std::function<void()>());
+        d->current.reset();
+    }
+
+    // use a while loop because it is possible that while
+    // processing the files new ones can be added
+    size_t index = 0;
+    for(;;) {
+        for(;index < FileList.size(); ++index) {
+            FileEntry file = FileList.begin()[index];
+            auto entry = std::make_shared<ZipEntryData>();
+            entry->name = file.FileName;
+
+            std::shared_ptr<const Persistence> object;
+            if(file.Object->isSaveDocFileThreadSafe()) {
+                if(d->snapshot)
+                    object.reset(file.Object->createSaveSnapshot());
+                else if(d->pool) {
+                    // no ownership
+                    object.reset(file.Object, [](const Persistence*){});
+                }
+            }
+
+            if(object) {
+                auto writer = std::make_shared<EntryWriter>(*this);
+                writer->putNextEntry(file.FileName.c_str());
+                d->submit(entry, [entry, writer, object]() {
+                    object->SaveDocFile(*writer);
+                    entry->data = writer->takeString();
+                    entry->errors = writer->getErrors();
+                    for(auto &f : writer->getFileList())
+                        entry->files.emplace_back(f.FileName, f.Object);
+                });
+            } else {
+                // Serialize here through Stream(), and only compress in
+                // worker thread
+                Writer::putNextEntry(file.FileName.c_str());
+                indent = 0;
+                indBuf[0] = 0;
+                file.Object->SaveDocFile(*this);
+                entry->data = d->currentWriter->takeString();
+                d->submit(entry, std::function<void()>());
+            }
+            d->flush(d->maxPending);
+        }
+        d->flush(0);
+        if(index >= FileList.size())
+            break;
+    }
+}
+
+void ParallelZipWriter::close()
+{
+    if(d->current) {
+        d->current->data = d->currentWriter->takeString();
+        d->submit(d->current, std::function<void()>());
+        d->current.reset();
+    }
+    d->finish();
+}
+
+// ----------------------------------------------------------------------------
+
+const char Writer::BinaryStreamName[] = "Document.bin";
+
+static const char _BinaryStreamMagic[] = {'F','C','B','S'};
+static const uint32_t _BinaryStreamVersion = 1;
+
+unsigned Writer::addBinaryRecord(const Base::Persistence *Object)
+{
+    if(!BinaryStream)
+        throw Base::RuntimeError("Writer::addBinaryRecord(): binary stream not enabled");
+
+    EntryWriter writer(*this);
+    writer.setPreferBinary(true);
+    writer.putNextEntry(BinaryStreamName);
+    Object->SaveDocFile(writer);
+    for(auto &err : writer.getErrors())
+        addError(err);
+    if(writer.getFileList().size())
+        addError("Files are not supported by binary record");
+
+    std::string data = writer.takeString();
+    Base::OutputStream str(*BinaryStream);
+    str << (uint32_t)data.size();
+    BinaryStream->write(data.c_str(), data.size());
+    return BinaryRecordCount++;
+}
+
+void Writer::writeBinaryStream(const char *filename)
+{
+    if(!BinaryStream || !BinaryRecordCount)
+        return;
+    putNextEntry(filename);
+    Stream().write(_BinaryStreamMagic, sizeof(_BinaryStreamMagic));
+    Base::OutputStream str(Stream());
+    str << _BinaryStreamVersion << (uint32_t)BinaryRecordCount;
+    std::string data = BinaryStream->str();
+    Stream().write(data.c_str(), data.size());
+    BinaryStream.reset(new std::ostringstream);
+    BinaryRecordCount = 0;
+}
+
+// ----------------------------------------------------------------------------
+
 FileWriter::FileWriter(const char* DirName) : DirName(DirName)
 {
 }
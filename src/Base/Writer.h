@@ -80,6 +80,36 @@ public:
     void setFileVersion(int);
     int getFileVersion() const;
 
+    /** @name Binary property stream */
+    //@{
+    /** Enable the binary property stream
+     *
+     * If enabled, persistent objects may store their data as a record of a
+     * single binary file entry using addBinaryRecord(), instead of as XML or
+     * as a file entry of their own. The caller is responsible for calling
+     * writeBinaryStream() after all other files are written.
+     */
+    void setBinaryStream(bool on);
+    /// check whether the binary property stream is enabled
+    bool isBinaryStream() const;
+    /** Add a record to the binary property stream
+     * @param Object: the object to store. Its SaveDocFile() is called
+     * immediately with a binary preferred writer to produce the record data.
+     * @return Returns the index of the record, which is passed to
+     * XMLReader::addBinaryRecord() on restore.
+     */
+    unsigned addBinaryRecord(const Base::Persistence *Object);
+    /** Write the binary property stream as an additional file entry
+     *
+     * The stream starts with the magic bytes 'FCBS', followed by a 32 bit
+     * format version and the number of records. Each record is prefixed with
+     * its length in bytes. Nothing is written if there is no record.
+     */
+    void writeBinaryStream(const char *filename=BinaryStreamName);
+    /// The default file name of the binary property stream
+    static const char BinaryStreamName[];
+    //@}
+
     /// put the next entry with a give name
     virtual void putNextEntry(const char *filename, const char *objName=0);
 
@@ -185,6 +215,8 @@ protected:
 private:
     /// name for underlying file saves
     std::string ObjectName;
+    std::unique_ptr<std::ostringstream> BinaryStream;
+    unsigned BinaryRecordCount = 0;
     std::unique_ptr<std::ostream> CharStream;
     bool CharBase64 = false;
 };
@@ -215,6 +247,57 @@ private:
     zipios::ZipOutputStream ZipStream;
 };
 
+class ParallelZipWriterP;
+
+/** The ParallelZipWriter class
+ * Produces the same kind of zip archive as ZipWriter, but serializes and
+ * compresses the entries on a thread pool.
+ *
+ * Entries are compressed in the background while the caller continues to
+ * write the next one, and are assembled in order by the calling thread. The
+ * SaveDocFile() of an object is called in a worker thread only if the object
+ * reports Persistence::isSaveDocFileThreadSafe(), otherwise it is called in
+ * the calling thread.
+ *
+ * A compression level of zero stores the entries without compression.
+ */
+class BaseExport ParallelZipWriter : public Writer
+{
+public:
+    /** Constructor
+     * @param os: output stream
+     * @param threads: maximum number of worker threads. Zero means to use
+     * the number of processor cores, and one to do everything in the calling
+     * thread.
+     */
+    ParallelZipWriter(std::ostream &os, int threads=0);
+    virtual ~ParallelZipWriter();
+
+    virtual void writeFiles(void);
+
+    virtual std::ostream &Stream(void);
+
+    void setComment(const char* str);
+    void setLevel(int level);
+    virtual void putNextEntry(const char *filename, const char *objName=0);
+
+    /** Enable snapshot mode
+     *
+     * In snapshot mode, nothing is written to the output until close(). The
+     * XML entries and the files of objects that are not thread safe are
+     * serialized into memory. The other objects are copied with
+     * Persistence::createSaveSnapshot(). close() can then be called in
+     * another thread, while the original objects are being modified.
+     */
+    void setSnapshot(bool enable);
+
+    /// Write out all pending entries and the central directory
+    void close();
+
+private:
+    std::unique_ptr<ParallelZipWriterP> d;
+};
+
 /** The StringWriter class 
  * This is an important helper class implementation for the store and retrieval system
  * of objects in FreeCAD. 
@@ -53,6 +53,7 @@
 #include <App/Transactions.h>
 #include <App/AutoTransaction.h>
 #include <App/GeoFeatureGroupExtension.h>
+#include <App/RecomputeProfiler.h>
 
 #include "Application.h"
 #include "MainWindow.h"
@@ -128,6 +129,7 @@ struct DocumentP
     Connection connectTransactionRemove;
     Connection connectTouchedObject;
     Connection connectChangePropertyEditor;
+    Connection connectFinishSaveStatus;
 
     typedef boost::signals2::shared_connection_block ConnectionBlock;
     ConnectionBlock connectActObjectBlocker;
@@ -207,16 +209,24 @@ Document::Document(App::Document* pcDocument,Application * app)
         (boost::bind(&Gui::Document::slotTransactionAppend, this, _1, _2));
     d->connectTransactionRemove = pcDocument->signalTransactionRemove.connect
         (boost::bind(&Gui::Document::slotTransactionRemove, this, _1, _2));
+    d->connectFinishSaveStatus = pcDocument->signalFinishSaveStatus.connect
+        (boost::bind(&Gui::Document::slotFinishSaveStatus, this, _1, _2, _3, _4));
     // pointer to the python class
     // NOTE: As this Python object doesn't get returned to the interpreter we
     // mustn't increment it (Werner Jan-12-2006)
     _pcDocPy = new Gui::DocumentPy(this);
 
-    if (App::GetApplication().GetParameterGroupByPath
-        ("User parameter:BaseApp/Preferences/Document")->GetBool("UsingUndo",true)){
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Document");
+    if (hGrp->GetBool("UsingUndo",true)){
         d->_pcDocument->setUndoMode(1);
         // set the maximum stack size
-        d->_pcDocument->setMaxUndoStackSize(App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Document")->GetInt("MaxUndoSize",20));
+        d->_pcDocument->setMaxUndoStackSize(hGrp->GetInt("MaxUndoSize",20));
+        // set the memory limit of the stack in MB, and the size in KB above
+        // which a property change is kept compressed
+        d->_pcDocument->setUndoLimit((std::size_t)std::max(0L,hGrp->GetInt("MaxUndoMemory",0))*1024*1024);
+        d->_pcDocument->setUndoCompressThreshold(
+                (unsigned int)std::max(0L,hGrp->GetInt("UndoCompressThreshold",1024))*1024);
     }
 }
 
@@ -246,6 +256,7 @@ Document::~Document()
     d->connectTransactionRemove.disconnect();
     d->connectTouchedObject.disconnect();
     d->connectChangePropertyEditor.disconnect();
+    d->connectFinishSaveStatus.disconnect();
 
     // e.g. if document gets closed from within a Python command
     d->_isClosing = true;
@@ -745,6 +756,7 @@ void Document::slotChangedObject(const App::DocumentObject& Obj, const App::Prop
     ViewProvider* viewProvider = getViewProvider(&Obj);
     if (viewProvider) {
         try {
+            App::RecomputeProfiler::Scope profile(&Obj, "ViewProvider", "updateData", Prop.getName());
             viewProvider->update(&Prop);
         }
         catch(const Base::MemoryException& e) {
@@ -996,6 +1008,10 @@ bool Document::save(void)
                 }
             }
             Gui::WaitCursor wc;
+            // Save in a worker thread if requested. Failure is reported in
+            // slotFinishSaveStatus().
+            bool background = App::GetApplication().GetParameterGroupByPath
+                ("User parameter:BaseApp/Preferences/Document")->GetBool("BackgroundSave",false);
             // save all documents
             for(auto v : docs) {
                 auto doc = v.first;
@@ -1004,7 +1020,8 @@ bool Document::save(void)
                     App::AutoTransaction trans("Recompute");
                     Command::doCommand(Command::Doc,"App.getDocument(\"%s\").recompute()",doc->getName());
                 }
-                Command::doCommand(Command::Doc,"App.getDocument(\"%s\").save()",doc->getName());
+                Command::doCommand(Command::Doc,"App.getDocument(\"%s\").save(%s)",
+                        doc->getName(), background?"True":"False");
                 auto gdoc = Application::Instance->getDocument(doc);
                 if(gdoc) gdoc->setModified(false);
             }
@@ -2252,3 +2269,18 @@ void Document::slotChangePropertyEditor(const App::Document &doc, const App::Pro
     }
 }
 
+void Document::slotFinishSaveStatus(const App::Document &, const std::string &filename,
+        bool success, const std::string &message)
+{
+    if(success) {
+        getMainWindow()->showMessage(QObject::tr("Document saved to %1")
+                .arg(QString::fromUtf8(filename.c_str())), 3000);
+        return;
+    }
+    // The document is marked as saved when the background saving starts,
+    // so revert it here
+    setModified(true);
+    QMessageBox::critical(getMainWindow(), QObject::tr("Saving document failed"),
+        QString::fromUtf8(message.c_str()));
+}
+
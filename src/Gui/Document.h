@@ -91,6 +91,7 @@ protected:
     void slotSkipRecompute(const App::Document &doc, const std::vector<App::DocumentObject*> &objs);
     void slotTouchedObject(const App::DocumentObject &);
     void slotChangePropertyEditor(const App::Document&, const App::Property &);
+    void slotFinishSaveStatus(const App::Document&, const std::string&, bool, const std::string&);
     //@}
 
     void addViewProvider(Gui::ViewProviderDocumentObject*);
@@ -172,6 +172,7 @@ struct MainWindowP
     QTimer* statusTimer;
     QTimer* activityTimer;
     QTimer* visibleTimer;
+    QTimer* paramTimer;
     QMdiArea* mdiArea;
     QPointer<MDIView> activeView;
     QSignalMapper* windowMapper;
@@ -351,6 +352,13 @@ MainWindow::MainWindow(QWidget * parent, Qt::WindowFlags f)
     connect(d->visibleTimer, SIGNAL(timeout()),this, SLOT(showMainWindow()));
     d->visibleTimer->setSingleShot(true);
 
+    // save parameter timer
+    d->paramTimer = new QTimer(this);
+    d->paramTimer->setObjectName(QString::fromLatin1("paramTimer"));
+    connect(d->paramTimer, SIGNAL(timeout()),this, SLOT(flushParameters()));
+    d->paramTimer->setSingleShot(false);
+    d->paramTimer->start(1000);
+
     d->windowMapper = new QSignalMapper(this);
 
     // connection between workspace, window menu and tab bar
@@ -1299,6 +1307,18 @@ void MainWindow::_updateActions()
     d->actionUpdateDelay = 0;
 }
 
+void MainWindow::flushParameters()
+{
+    // Parameters are otherwise only saved on exit. Save them once there are
+    // no more changes within the given delay, so that a crash does not lose
+    // them, while a burst of changes (e.g. from a dialog) is saved only once.
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/General");
+    int delay = hGrp->GetInt("ParameterFlushDelay", 5000);
+    if (delay > 0)
+        App::GetApplication().GetUserParameter().FlushDeferred(delay);
+}
+
 void MainWindow::switchToTopLevelMode()
 {
     QList<QDockWidget*> dw = this->findChildren<QDockWidget*>();
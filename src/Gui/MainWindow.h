@@ -305,6 +305,10 @@ private Q_SLOTS:
      * \internal
      */
     void clearStatus();
+    /**
+     * Saves changed user parameters in the background after some idle time.
+     */
+    void flushParameters();
 
 Q_SIGNALS:
     void timeEvent();
@@ -787,7 +787,7 @@ void View3DInventorViewer::checkGroupOnTop(const SelectionChanges &Reason) {
         return;
     auto svp = vp;
     if(subname && *subname) {
-        auto sobj = obj->getSubObject(subname);
+        auto sobj = obj->getSubObjectCached(subname);
         if(!sobj || !sobj->getNameInDocument())
             return;
         if(sobj!=obj) {
@@ -546,7 +546,7 @@ bool ViewProviderDocumentObject::getDetailPath(const char *subname, SoFullPath *
     if(!dot) return false;
     auto obj = getObject();
     if(!obj || !obj->getNameInDocument()) return false;
-    auto sobj = obj->getSubObject(std::string(subname,dot-subname+1).c_str());
+    auto sobj = obj->getSubObjectCached(std::string(subname,dot-subname+1).c_str());
     if(!sobj) return false;
     auto vp = Application::Instance->getViewProvider(sobj);
     if(!vp) return false;
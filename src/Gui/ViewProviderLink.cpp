@@ -1913,16 +1913,18 @@ void ViewProviderLink::updateDataPrivate(App::LinkBaseExtension *ext, const App:
                 const auto &touched = 
                     prop==propScales?propScales->getTouchList():propPlacements->getTouchList();
                 if(touched.empty()) {
+                    // convert all placements in one batch
+                    auto mats = propPlacements->getMatrices(
+                            propScales?&propScales->getValues():0);
                     for(int i=0;i<linkView->getSize();++i) {
-                        Base::Matrix4D mat;
-                        if(propPlacements->getSize()>i) 
-                            mat = (*propPlacements)[i].toMatrix();
-                        if(propScales && propScales->getSize()>i) {
-                            Base::Matrix4D s;
-                            s.scale((*propScales)[i]);
-                            mat *= s;
+                        if(i<(int)mats.size())
+                            linkView->setTransform(i,mats[i]);
+                        else {
+                            Base::Matrix4D mat;
+                            if(propScales && propScales->getSize()>i)
+                                mat.scale((*propScales)[i]);
+                            linkView->setTransform(i,mat);
                         }
-                        linkView->setTransform(i,mat);
                     }
                 }else{
                     for(int i : touched) {
@@ -293,6 +293,7 @@ void PropertyMeshKernel::setValuePtr(MeshObject* mesh)
     // before calling hasSetValue()
     Base::Reference<MeshObject> tmp(_meshObject);
     aboutToSetValue();
+    resetDeferred();
     _meshObject = mesh;
     hasSetValue();
 }
@@ -300,12 +301,14 @@ void PropertyMeshKernel::setValuePtr(MeshObject* mesh)
 void PropertyMeshKernel::setValue(const MeshObject& mesh)
 {
     aboutToSetValue();
+    resetDeferred();
     *_meshObject = mesh;
     hasSetValue();
 }
 
 void PropertyMeshKernel::setValue(const MeshCore::MeshKernel& mesh)
 {
+    loadDeferred();
     aboutToSetValue();
     _meshObject->setKernel(mesh);
     hasSetValue();
@@ -313,6 +316,7 @@ void PropertyMeshKernel::setValue(const MeshCore::MeshKernel& mesh)
 
 void PropertyMeshKernel::swapMesh(MeshObject& mesh)
 {
+    loadDeferred();
     aboutToSetValue();
     _meshObject->swap(mesh);
     hasSetValue();
@@ -320,6 +324,7 @@ void PropertyMeshKernel::swapMesh(MeshObject& mesh)
 
 void PropertyMeshKernel::swapMesh(MeshCore::MeshKernel& mesh)
 {
+    loadDeferred();
     aboutToSetValue();
     _meshObject->swap(mesh);
     hasSetValue();
@@ -327,21 +332,25 @@ void PropertyMeshKernel::swapMesh(MeshCore::MeshKernel& mesh)
 
 const MeshObject& PropertyMeshKernel::getValue(void)const 
 {
+    loadDeferred();
     return *_meshObject;
 }
 
 const MeshObject* PropertyMeshKernel::getValuePtr(void)const 
 {
+    loadDeferred();
     return (MeshObject*)_meshObject;
 }
 
 const Data::ComplexGeoData* PropertyMeshKernel::getComplexData() const
 {
+    loadDeferred();
     return (MeshObject*)_meshObject;
 }
 
 Base::BoundBox3d PropertyMeshKernel::getBoundingBox() const
 {
+    loadDeferred();
     return _meshObject->getBoundBox();
 }
 
@@ -355,6 +364,7 @@ unsigned int PropertyMeshKernel::getMemSize (void) const
 
 MeshObject* PropertyMeshKernel::startEditing()
 {
+    loadDeferred();
     aboutToSetValue();
     return (MeshObject*)_meshObject;
 }
@@ -366,6 +376,7 @@ void PropertyMeshKernel::finishEditing()
 
 void PropertyMeshKernel::transformGeometry(const Base::Matrix4D &rclMat)
 {
+    loadDeferred();
     aboutToSetValue();
     _meshObject->transformGeometry(rclMat);
     hasSetValue();
@@ -373,6 +384,7 @@ void PropertyMeshKernel::transformGeometry(const Base::Matrix4D &rclMat)
 
 void PropertyMeshKernel::setPointIndices(const std::vector<std::pair<unsigned long, Base::Vector3f> >& inds)
 {
+    loadDeferred();
     aboutToSetValue();
     MeshCore::MeshKernel& kernel = _meshObject->getKernel();
     for (std::vector<std::pair<unsigned long, Base::Vector3f> >::const_iterator it = inds.begin(); it != inds.end(); ++it)
@@ -382,6 +394,7 @@ void PropertyMeshKernel::setPointIndices(const std::vector<std::pair<unsigned lo
 
 PyObject *PropertyMeshKernel::getPyObject(void)
 {
+    loadDeferred();
     if (!meshPyObject) {
         meshPyObject = new MeshPy(&*_meshObject);
         meshPyObject->setConst(); // set immutable
@@ -418,6 +431,7 @@ void PropertyMeshKernel::setPyObject(PyObject *value)
 void PropertyMeshKernel::Save (Base::Writer &writer) const
 {
     if (writer.isForceXML()>1) {
+        loadDeferred();
         writer.Stream() << writer.ind() << "<Mesh>" << std::endl;
         MeshCore::MeshOutput saver(_meshObject->getKernel());
         saver.SaveXML(writer);
@@ -431,6 +445,7 @@ void PropertyMeshKernel::Save (Base::Writer &writer) const
 void PropertyMeshKernel::Restore(Base::XMLReader &reader)
 {
     reader.readElement("Mesh");
+    resetDeferred();
     std::string file (reader.getAttribute("file") );
     
     if (file.empty()) {
@@ -456,6 +471,17 @@ void PropertyMeshKernel::Restore(Base::XMLReader &reader)
 
 void PropertyMeshKernel::SaveDocFile (Base::Writer &writer) const
 {
+    std::shared_ptr<Base::DeferredDocFile> deferred;
+    {
+        std::lock_guard<std::mutex> lock(_DeferredMutex);
+        deferred = _Deferred;
+    }
+    // The mesh is not touched since lazy restore, copy the file content as it is
+    if (deferred && deferred->read([&writer](Base::Reader &reader) {
+                                        writer.Stream() << reader.rdbuf();
+                                     }))
+        return;
+    loadDeferred();
     _meshObject->save(writer.Stream());
 }
 
@@ -466,8 +492,44 @@ void PropertyMeshKernel::RestoreDocFile(Base::Reader &reader)
     hasSetValue();
 }
 
+bool PropertyMeshKernel::deferRestoreDocFile(const std::shared_ptr<Base::DeferredDocFile> &file)
+{
+    std::lock_guard<std::mutex> lock(_DeferredMutex);
+    _Deferred = file;
+    return true;
+}
+
+void PropertyMeshKernel::restoreDeferredDocFile()
+{
+    loadDeferred();
+}
+
+void PropertyMeshKernel::loadDeferred() const
+{
+    std::lock_guard<std::mutex> lock(_DeferredMutex);
+    if (!_Deferred)
+        return;
+    // The mesh is considered as restored already, so do not signal any change
+    MeshObject *mesh = _meshObject;
+    if (!_Deferred->read([mesh](Base::Reader &reader) {
+        mesh->load(reader);
+    })) {
+        // Keep the handle, or else the next save would silently replace the
+        // mesh in the file with an empty one.
+        throw Base::FileException("Failed to restore mesh from", _Deferred->getSourcePath().c_str());
+    }
+    _Deferred.reset();
+}
+
+void PropertyMeshKernel::resetDeferred()
+{
+    std::lock_guard<std::mutex> lock(_DeferredMutex);
+    _Deferred.reset();
+}
+
 App::Property *PropertyMeshKernel::Copy(void) const
 {
+    loadDeferred();
     // Note: Copy the content, do NOT reference the same mesh object
     PropertyMeshKernel *prop = new PropertyMeshKernel();
     *(prop->_meshObject) = *(this->_meshObject);
@@ -477,8 +539,10 @@ App::Property *PropertyMeshKernel::Copy(void) const
 void PropertyMeshKernel::Paste(const App::Property &from)
 {
     // Note: Copy the content, do NOT reference the same mesh object
-    aboutToSetValue();
     const PropertyMeshKernel& prop = dynamic_cast<const PropertyMeshKernel&>(from);
+    prop.loadDeferred();
+    aboutToSetValue();
+    resetDeferred();
     *(this->_meshObject) = *(prop._meshObject);
     hasSetValue();
 }
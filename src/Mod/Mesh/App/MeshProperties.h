@@ -29,6 +29,7 @@
 #include <set>
 #include <string>
 #include <map>
+#include <mutex>
 
 #include <Base/Handle.h>
 #include <Base/Matrix.h>
@@ -187,14 +188,36 @@ public:
 
     void SaveDocFile (Base::Writer &writer) const;
     void RestoreDocFile(Base::Reader &reader);
+    virtual bool deferRestoreDocFile(const std::shared_ptr<Base::DeferredDocFile> &file) override;
+    virtual void restoreDeferredDocFile() override;
+    virtual bool isSaveDocFileThreadSafe() const override {
+        return true;
+    }
+    virtual Base::Persistence *createSaveSnapshot() const override {
+        return Copy();
+    }
 
     App::Property *Copy(void) const;
     void Paste(const App::Property &from);
+    virtual bool isDocFileSelfContained() const override {
+        return true;
+    }
     //@}
 
+private:
+    /** Read the mesh from the file deferred by lazy restore, if there is any
+     *
+     * It may be called concurrently, e.g. by background saving. The handle is
+     * kept, and an exception thrown, if the file cannot be read.
+     */
+    void loadDeferred() const;
+    void resetDeferred();
+
 private:
     Base::Reference<MeshObject> _meshObject;
     MeshPy* meshPyObject;
+    mutable std::shared_ptr<Base::DeferredDocFile> _Deferred;
+    mutable std::mutex _DeferredMutex;
 };
 
 } // namespace Mesh
@@ -23,6 +23,9 @@
 
 #include "PreCompiled.h"
 
+#include <cstring>
+#include <memory>
+
 #include <Base/VectorPy.h>
 #include <Base/Handle.h>
 #include <Base/Builder3D.h>
@@ -834,6 +837,74 @@ PyObject*  MeshPy::getPointNormals(PyObject *args)
     } PY_CATCH;
 }
 
+PyObject*  MeshPy::getPointArray(PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return NULL;
+
+    PY_TRY {
+        const MeshObject* mesh = getMeshObjectPtr();
+        std::vector<double> data;
+        data.reserve(mesh->countPoints() * 3);
+        for (MeshObject::const_point_iterator it = mesh->points_begin(); it != mesh->points_end(); ++it)
+            data.insert(data.end(), {it->x, it->y, it->z});
+
+        Py::Bytes bytes(reinterpret_cast<const char*>(data.data()),
+                        static_cast<Py_ssize_t>(data.size() * sizeof(double)));
+        Py::Object view(PyMemoryView_FromObject(bytes.ptr()), true);
+        Py::Tuple shape(2);
+        shape.setItem(0, Py::Long(static_cast<long>(mesh->countPoints())));
+        shape.setItem(1, Py::Long(3));
+        Py::Callable cast(view.getAttr("cast"));
+        return Py::new_reference_to(cast.apply(Py::TupleN(Py::String("d"), shape)));
+    } PY_CATCH;
+}
+
+PyObject*  MeshPy::setPointArray(PyObject *args)
+{
+    PyObject* obj;
+    if (!PyArg_ParseTuple(args, "O", &obj))
+        return NULL;
+
+    Py_buffer buf;
+    if (PyObject_GetBuffer(obj, &buf, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) < 0)
+        return NULL;
+    std::unique_ptr<Py_buffer, void(*)(Py_buffer*)> guard(&buf, PyBuffer_Release);
+
+    const char *format = buf.format ? buf.format : "B";
+    if (format[0] == '@' || format[0] == '=' || format[0] == '<')
+        ++format;
+    bool isFloat = buf.itemsize == sizeof(float) && strcmp(format, "f") == 0;
+    bool isDouble = buf.itemsize == sizeof(double) && strcmp(format, "d") == 0;
+    if (!isFloat && !isDouble) {
+        PyErr_SetString(PyExc_TypeError, "Expect a buffer of float or double");
+        return NULL;
+    }
+
+    MeshObject* mesh = getMeshObjectPtr();
+    unsigned long count = mesh->countPoints();
+    if (static_cast<unsigned long>(buf.len / buf.itemsize) != count * 3) {
+        PyErr_Format(PyExc_ValueError, "Expect a buffer of %lu points", count);
+        return NULL;
+    }
+
+    PY_TRY {
+        for (unsigned long i=0; i<count; i++) {
+            if (isFloat) {
+                const float *pnt = static_cast<const float*>(buf.buf) + i * 3;
+                mesh->setPoint(i, Base::Vector3d(pnt[0], pnt[1], pnt[2]));
+            }
+            else {
+                const double *pnt = static_cast<const double*>(buf.buf) + i * 3;
+                mesh->setPoint(i, Base::Vector3d(pnt[0], pnt[1], pnt[2]));
+            }
+        }
+        mesh->getKernel().RecalcBoundBox();
+    } PY_CATCH;
+
+    Py_Return;
+}
+
 PyObject* MeshPy::countSegments(PyObject *args)
 {
     if (!PyArg_ParseTuple(args, ""))
@@ -225,3 +225,122 @@ class PolynomialFitCases(unittest.TestCase):
 
     def tearDown(self):
         pass
+
+
+class MeshUndoCases(unittest.TestCase):
+    def setUp(self):
+        self.doc = FreeCAD.newDocument("MeshUndoTest")
+        self.doc.UndoMode = 1
+
+    def testCompressedUndo(self):
+        mesh = Mesh.createSphere(10.0,100)
+        moved = mesh.copy()
+        moved.translate(20,0,0)
+        feature = self.doc.addObject("Mesh::Feature","Mesh")
+        feature.Mesh = mesh
+        self.doc.UndoCompressThreshold = 0
+        self.doc.openTransaction("Move")
+        feature.Mesh = moved
+        self.doc.commitTransaction()
+        size = self.doc.UndoRedoMemSize
+        self.assertTrue(size > 0)
+        # keep the previous mesh compressed in the undo stack
+        self.doc.UndoCompressThreshold = 1024
+        self.doc.openTransaction("Restore")
+        feature.Mesh = mesh
+        self.doc.commitTransaction()
+        self.assertTrue(self.doc.UndoRedoMemSize - size < size)
+        self.doc.undo()
+        self.assertEqual(feature.Mesh.CountFacets, mesh.CountFacets)
+        self.assertAlmostEqual(feature.Mesh.BoundBox.XMin, moved.BoundBox.XMin, 4)
+        self.doc.undo()
+        self.assertAlmostEqual(feature.Mesh.BoundBox.XMin, mesh.BoundBox.XMin, 4)
+        self.doc.redo()
+        self.doc.redo()
+        self.assertAlmostEqual(feature.Mesh.BoundBox.XMin, mesh.BoundBox.XMin, 4)
+
+    def tearDown(self):
+        FreeCAD.closeDocument(self.doc.Name)
+
+
+class MeshLazyRestoreCases(unittest.TestCase):
+    def setUp(self):
+        self.doc = FreeCAD.newDocument("MeshLazyRestoreTest")
+        self.param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+        self.lazy = self.param.GetBool("LazyRestore", False)
+        tempPath = FreeCAD.ConfigGet("AppTempPath")
+        self.fileName = os.path.join(tempPath, "MeshLazyRestore.FCStd")
+        self.copyName = os.path.join(tempPath, "MeshLazyRestoreCopy.FCStd")
+
+    def testSaveUntouched(self):
+        mesh = Mesh.createSphere(10.0,50)
+        self.doc.addObject("Mesh::Feature","Mesh").Mesh = mesh
+        self.doc.saveAs(self.fileName)
+        FreeCAD.closeDocument(self.doc.Name)
+        self.param.SetBool("LazyRestore", True)
+        self.doc = FreeCAD.openDocument(self.fileName)
+        # save a copy without touching the mesh
+        self.doc.saveCopy(self.copyName)
+        self.assertEqual(self.doc.Mesh.Mesh.CountFacets, mesh.CountFacets)
+        FreeCAD.closeDocument(self.doc.Name)
+        self.doc = FreeCAD.openDocument(self.copyName)
+        self.assertEqual(self.doc.Mesh.Mesh.CountFacets, mesh.CountFacets)
+
+    def testReadFailure(self):
+        mesh = Mesh.createSphere(10.0,50)
+        self.doc.addObject("Mesh::Feature","Mesh").Mesh = mesh
+        self.doc.saveAs(self.fileName)
+        FreeCAD.closeDocument(self.doc.Name)
+        self.param.SetBool("LazyRestore", True)
+        self.doc = FreeCAD.openDocument(self.fileName)
+        # The deferred file refuses to read from a modified archive
+        mtime = os.path.getmtime(self.fileName)
+        os.utime(self.fileName, (mtime+100, mtime+100))
+        self.assertRaises(IOError, lambda: self.doc.Mesh.Mesh)
+        # Saving must not write an empty mesh in place of the unread one
+        self.assertRaises(IOError, self.doc.saveCopy, self.copyName)
+        # The mesh is still readable once the archive is restored
+        os.utime(self.fileName, (mtime, mtime))
+        self.assertEqual(self.doc.Mesh.Mesh.CountFacets, mesh.CountFacets)
+
+    def tearDown(self):
+        self.param.SetBool("LazyRestore", self.lazy)
+        FreeCAD.closeDocument(self.doc.Name)
+
+
+class MeshBufferCases(unittest.TestCase):
+    def setUp(self):
+        self.mesh = Mesh.createBox(1.0, 2.0, 3.0)
+
+    def testGetPointArray(self):
+        view = self.mesh.getPointArray()
+        self.assertEqual(view.format, 'd')
+        self.assertEqual(view.shape, (self.mesh.CountPoints, 3))
+        points = [[p.x, p.y, p.z] for p in self.mesh.Points]
+        self.assertEqual(view.tolist(), points)
+        # the array holds a copy of the points
+        self.assertTrue(view.readonly)
+        self.mesh.translate(1, 0, 0)
+        self.assertEqual(view.tolist(), points)
+
+    def testSetPointArray(self):
+        import array
+        count = self.mesh.CountPoints
+        facets = self.mesh.CountFacets
+        data = array.array('d', [2.0 * v for p in self.mesh.Points for v in (p.x, p.y, p.z)])
+        self.mesh.setPointArray(data)
+        self.assertEqual(self.mesh.CountPoints, count)
+        self.assertEqual(self.mesh.CountFacets, facets)
+        self.assertEqual(self.mesh.getPointArray().tolist(),
+                         [[data[i], data[i+1], data[i+2]] for i in range(0, len(data), 3)])
+        # the bounding box follows the points
+        self.assertAlmostEqual(self.mesh.BoundBox.XLength, 2.0, 4)
+        self.assertAlmostEqual(self.mesh.BoundBox.ZLength, 6.0, 4)
+
+        self.mesh.setPointArray(array.array('f', [0.0] * (count * 3)))
+        self.assertAlmostEqual(self.mesh.BoundBox.XLength, 0.0, 4)
+
+        with self.assertRaises(ValueError):
+            self.mesh.setPointArray(array.array('d', [0.0] * 3))
+        with self.assertRaises(TypeError):
+            self.mesh.setPointArray(array.array('i', [0] * (count * 3)))
@@ -26,6 +26,7 @@
 # include <BRepAlgoAPI_BooleanOperation.hxx>
 # include <BRepCheck_Analyzer.hxx>
 # include <Standard_Failure.hxx>
+# include <TopTools_ListOfShape.hxx>
 # include <memory>
 #endif
 
@@ -51,6 +52,14 @@ Boolean::Boolean(void)
     History.setSize(0);
 
     ADD_PROPERTY_TYPE(Refine,(0),"Boolean",(App::PropertyType)(App::Prop_None),"Refine shape (clean up redundant edges) after this boolean operation");
+    ADD_PROPERTY_TYPE(UseOBB,(false),"Boolean",App::Prop_None,
+        "Use oriented bound boxes to find interfering sub-shapes, which may be faster for rotated shapes");
+    ADD_PROPERTY_TYPE(Glue,((long)0),"Boolean",App::Prop_None,
+        "Speed up the operation on shapes that touch without intersecting.\n"
+        "Shift: faces of the shapes may partially coincide.\n"
+        "Full: the shapes only share whole sub-shapes.\n"
+        "The result is wrong if the shapes interfere otherwise.");
+    Glue.setEnums(BooleanOptions::GlueEnums);
 
     //init Refine property
     Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
@@ -73,6 +82,29 @@ const char *Boolean::opCode() const {
     return TOPOP_BOOLEAN;
 }
 
+BRepAlgoAPI_BooleanOperation* Boolean::buildOperation(BRepAlgoAPI_BooleanOperation *mk,
+        const TopoDS_Shape& base, const TopoDS_Shape& tool) const
+{
+    std::unique_ptr<BRepAlgoAPI_BooleanOperation> op(mk);
+#if OCC_VERSION_HEX < 0x060900
+    (void)base;
+    (void)tool;
+    throw Base::NotImplementedError("Boolean options are available only in OCC 6.9.0 and up.");
+#else
+    BooleanOptions options;
+    options.useOBB = UseOBB.getValue();
+    options.glue = Glue.getValue();
+    options.apply(*op);
+    TopTools_ListOfShape shapeArguments,shapeTools;
+    shapeArguments.Append(base);
+    shapeTools.Append(tool);
+    op->SetArguments(shapeArguments);
+    op->SetTools(shapeTools);
+    op->Build();
+    return op.release();
+#endif
+}
+
 App::DocumentObjectExecReturn *Boolean::execute(void)
 {
     try {
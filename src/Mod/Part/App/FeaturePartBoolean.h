@@ -43,6 +43,8 @@ public:
     App::PropertyLink Tool;
     PropertyShapeHistory History;
     App::PropertyBool Refine;
+    App::PropertyBool UseOBB;
+    App::PropertyEnumeration Glue;
 
     /** @name methods override Feature */
     //@{
@@ -58,6 +60,11 @@ public:
 
 protected:
     virtual BRepAlgoAPI_BooleanOperation* makeOperation(const TopoDS_Shape&, const TopoDS_Shape&) const = 0;
+    /** Set the arguments of a boolean operation, and build it with the
+     * options set in the properties of this feature
+     */
+    BRepAlgoAPI_BooleanOperation* buildOperation(BRepAlgoAPI_BooleanOperation *mk,
+            const TopoDS_Shape& base, const TopoDS_Shape& tool) const;
     virtual const char *opCode() const;
 };
 
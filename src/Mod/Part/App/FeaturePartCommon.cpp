@@ -57,7 +57,11 @@ const char *Common::opCode() const {
 BRepAlgoAPI_BooleanOperation* Common::makeOperation(const TopoDS_Shape& base, const TopoDS_Shape& tool) const
 {
     // Let's call algorithm computing a section operation:
+#if OCC_VERSION_HEX < 0x060900
     return new BRepAlgoAPI_Common(base, tool);
+#else
+    return buildOperation(new BRepAlgoAPI_Common, base, tool);
+#endif
 }
 
 // ----------------------------------------------------
@@ -74,6 +78,16 @@ MultiCommon::MultiCommon(void)
     History.setSize(0);
 
     ADD_PROPERTY_TYPE(Refine,(0),"Boolean",(App::PropertyType)(App::Prop_None),"Refine shape (clean up redundant edges) after this boolean operation");
+    ADD_PROPERTY_TYPE(UseOBB,(false),"Boolean",App::Prop_None,
+        "Use oriented bound boxes to find interfering sub-shapes, which may be faster for rotated shapes");
+    ADD_PROPERTY_TYPE(Glue,((long)0),"Boolean",App::Prop_None,
+        "Speed up the operation on shapes that touch without intersecting.\n"
+        "Shift: faces of the shapes may partially coincide.\n"
+        "Full: the shapes only share whole sub-shapes.\n"
+        "The result is wrong if the shapes interfere otherwise.");
+    Glue.setEnums(BooleanOptions::GlueEnums);
+    ADD_PROPERTY_TYPE(Prefilter,(false),"Boolean",App::Prop_None,
+        "Leave out shapes whose bound box does not touch the first shape from the operation");
 
     //init Refine property
     Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
@@ -214,7 +228,11 @@ App::DocumentObjectExecReturn *MultiCommon::execute(void)
     }
 
     TopoShape res(0,getDocument()->getStringHasher());
-    res.makEShape(TOPOP_COMMON,shapes);
+    BooleanOptions options;
+    options.useOBB = UseOBB.getValue();
+    options.glue = Glue.getValue();
+    options.prefilter = Prefilter.getValue();
+    res.makEBoolean(TOPOP_COMMON,shapes,options);
     if (res.isNull())
         throw Base::RuntimeError("Resulting shape is null");
 
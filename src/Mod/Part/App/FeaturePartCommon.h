@@ -56,6 +56,9 @@ public:
     App::PropertyLinkList Shapes;
     PropertyShapeHistory History;
     App::PropertyBool Refine;
+    App::PropertyBool UseOBB;
+    App::PropertyEnumeration Glue;
+    App::PropertyBool Prefilter;
 
     /** @name methods override feature */
     //@{
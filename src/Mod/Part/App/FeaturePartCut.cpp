@@ -47,5 +47,9 @@ const char *Cut::opCode() const {
 BRepAlgoAPI_BooleanOperation* Cut::makeOperation(const TopoDS_Shape& base, const TopoDS_Shape& tool) const
 {
     // Let's call algorithm computing a cut operation:
+#if OCC_VERSION_HEX < 0x060900
     return new BRepAlgoAPI_Cut(base, tool);
+#else
+    return buildOperation(new BRepAlgoAPI_Cut, base, tool);
+#endif
 }
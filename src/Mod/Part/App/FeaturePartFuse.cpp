@@ -55,7 +55,11 @@ Fuse::Fuse(void)
 BRepAlgoAPI_BooleanOperation* Fuse::makeOperation(const TopoDS_Shape& base, const TopoDS_Shape& tool) const
 {
     // Let's call algorithm computing a fuse operation:
+#if OCC_VERSION_HEX < 0x060900
     return new BRepAlgoAPI_Fuse(base, tool);
+#else
+    return buildOperation(new BRepAlgoAPI_Fuse, base, tool);
+#endif
 }
 
 // ----------------------------------------------------
@@ -72,6 +76,17 @@ MultiFuse::MultiFuse(void)
     History.setSize(0);
 
     ADD_PROPERTY_TYPE(Refine,(0),"Boolean",(App::PropertyType)(App::Prop_None),"Refine shape (clean up redundant edges) after this boolean operation");
+    ADD_PROPERTY_TYPE(UseOBB,(false),"Boolean",App::Prop_None,
+        "Use oriented bound boxes to find interfering sub-shapes, which may be faster for rotated shapes");
+    ADD_PROPERTY_TYPE(Glue,((long)0),"Boolean",App::Prop_None,
+        "Speed up the operation on shapes that touch without intersecting.\n"
+        "Shift: faces of the shapes may partially coincide.\n"
+        "Full: the shapes only share whole sub-shapes.\n"
+        "The result is wrong if the shapes interfere otherwise.");
+    Glue.setEnums(BooleanOptions::GlueEnums);
+    ADD_PROPERTY_TYPE(Prefilter,(false),"Boolean",App::Prop_None,
+        "Leave out shapes whose bound box does not touch any other shape from the\n"
+        "operation, and add them to the result as they are");
 
     //init Refine property
     Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
@@ -244,7 +259,11 @@ App::DocumentObjectExecReturn *MultiFuse::execute(void)
     }
 
     TopoShape res(0,getDocument()->getStringHasher());
-    res.makEShape(TOPOP_FUSE,shapes);
+    BooleanOptions options;
+    options.useOBB = UseOBB.getValue();
+    options.glue = Glue.getValue();
+    options.prefilter = Prefilter.getValue();
+    res.makEBoolean(TOPOP_FUSE,shapes,options);
     if (res.isNull())
         throw Base::RuntimeError("Resulting shape is null");
 
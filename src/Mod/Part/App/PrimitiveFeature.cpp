@@ -106,6 +106,19 @@ App::DocumentObjectExecReturn* Primitive::execute(void) {
     return Part::Feature::execute();
 }
 
+bool Primitive::isRecomputeThreadSafe() const
+{
+    // Attachment reads, and caches, the shapes of the support objects
+    if (!Support.getValues().empty())
+        return false;
+    auto self = const_cast<Primitive*>(this);
+    for (auto it=self->extensionBegin(); it!=self->extensionEnd(); ++it) {
+        if (it->second->isPythonExtension())
+            return false;
+    }
+    return true;
+}
+
 namespace Part {
     PYTHON_TYPE_DEF(PrimitivePy, PartFeaturePy)
     PYTHON_TYPE_IMP(PrimitivePy, PartFeaturePy)
@@ -45,6 +45,8 @@ public:
     App::DocumentObjectExecReturn *execute(void);
     short mustExecute() const;
     PyObject* getPyObject();
+    /// execute() only touches its own properties, unless attached
+    bool isRecomputeThreadSafe() const override;
     //@}
 
 protected:
@@ -81,7 +81,14 @@ using namespace Part;
 
 TYPESYSTEM_SOURCE(Part::PropertyPartShape , App::PropertyComplexGeoData);
 
+static bool isDirectAccess()
+{
+    return App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("DirectAccess", true);
+}
+
 PropertyPartShape::PropertyPartShape()
+    :_DirectAccess(true)
 {
 }
 
@@ -92,6 +99,7 @@ PropertyPartShape::~PropertyPartShape()
 void PropertyPartShape::setValue(const TopoShape& sh)
 {
     aboutToSetValue();
+    resetDeferred();
     _Shape = sh;
     auto obj = dynamic_cast<App::DocumentObject*>(getContainer());
     if(obj) {
@@ -109,6 +117,7 @@ void PropertyPartShape::setValue(const TopoShape& sh)
 void PropertyPartShape::setValue(const TopoDS_Shape& sh, bool resetElementMap)
 {
     aboutToSetValue();
+    resetDeferred();
     auto obj = dynamic_cast<App::DocumentObject*>(getContainer());
     if(obj)
         _Shape.Tag = obj->getID();
@@ -119,23 +128,27 @@ void PropertyPartShape::setValue(const TopoDS_Shape& sh, bool resetElementMap)
 
 const TopoDS_Shape& PropertyPartShape::getValue(void)const
 {
+    loadDeferred();
     return _Shape.getShape();
 }
 
 const TopoShape& PropertyPartShape::getShape() const
 {
+    loadDeferred();
     _Shape.initCache(-1);
     return this->_Shape;
 }
 
 const Data::ComplexGeoData* PropertyPartShape::getComplexData() const
 {
+    loadDeferred();
     _Shape.initCache(-1);
     return &(this->_Shape);
 }
 
 Base::BoundBox3d PropertyPartShape::getBoundingBox() const
 {
+    loadDeferred();
     Base::BoundBox3d box;
     if (_Shape.getShape().IsNull())
         return box;
@@ -162,6 +175,7 @@ Base::BoundBox3d PropertyPartShape::getBoundingBox() const
 
 void PropertyPartShape::transformGeometry(const Base::Matrix4D &rclTrf)
 {
+    loadDeferred();
     aboutToSetValue();
     _Shape.transformGeometry(rclTrf);
     hasSetValue();
@@ -169,6 +183,7 @@ void PropertyPartShape::transformGeometry(const Base::Matrix4D &rclTrf)
 
 PyObject *PropertyPartShape::getPyObject(void)
 {
+    loadDeferred();
     auto prop = static_cast<Base::PyObjectBase*>(Py::new_reference_to(shape2pyshape(_Shape)));
     if (prop) prop->setConst();
     return prop;
@@ -202,8 +217,11 @@ void PropertyPartShape::setPyObject(PyObject *value)
 
 App::Property *PropertyPartShape::Copy(void) const
 {
+    loadDeferred();
     PropertyPartShape *prop = new PropertyPartShape();
-    prop->_Shape = this->_Shape.makECopy();
+    // Share the shape, which is never modified in place once assigned to the
+    // property, so that the undo stack does not duplicate unchanged geometry.
+    prop->_Shape = this->_Shape;
     prop->_Ver = this->_Ver;
     return prop;
 }
@@ -212,6 +230,7 @@ void PropertyPartShape::Paste(const App::Property &from)
 {
     auto prop = Base::freecad_dynamic_cast<const PropertyPartShape>(&from);
     if(prop) {
+        prop->loadDeferred();
         setValue(prop->_Shape);
         _Ver = prop->_Ver;
     }
@@ -264,16 +283,19 @@ void PropertyPartShape::Save (Base::Writer &writer) const
     bool binary = writer.getMode("BinaryBrep");
     bool toXML = writer.getFileVersion()>1 && writer.isForceXML()>=(binary?3:2);
     if(!toXML) {
+        _DirectAccess = isDirectAccess();
         writer.Stream() << " file=\""
             << writer.addFile(getFileName(binary?".bin":".brp"), this)
             << "\"/>\n";
     } else if(binary) {
+        loadDeferred();
         writer.Stream() << " binary=\"1\">\n";
         TopoShape shape;
         shape.setShape(_Shape.getShape());
         shape.exportBinary(writer.beginCharStream(true));
         writer.endCharStream() <<  writer.ind() << "</Part>\n";
     } else {
+        loadDeferred();
         writer.Stream() << " brep=\"1\">\n";
         BRepTools_Write(_Shape.getShape(), writer.beginCharStream(false)<<'\n');
         writer.endCharStream() << '\n' << writer.ind() << "</Part>\n";
@@ -304,6 +326,7 @@ std::string PropertyPartShape::getElementMapVersion(bool restored) const {
 void PropertyPartShape::Restore(Base::XMLReader &reader)
 {
     reader.readElement("Part");
+    resetDeferred();
 
     auto owner = Base::freecad_dynamic_cast<App::DocumentObject>(getContainer());
     _Ver.clear();
@@ -434,6 +457,23 @@ void PropertyPartShape::SaveDocFile (Base::Writer &writer) const
     // if (_Shape.getShape().IsNull())
     //     return;
 
+    std::shared_ptr<Base::DeferredDocFile> deferred;
+    {
+        std::lock_guard<std::mutex> lock(_DeferredMutex);
+        deferred = _Deferred;
+    }
+    if(deferred) {
+        // The shape is not touched since lazy restore. Copy the file content
+        // as it is if it has the requested format.
+        bool binary = Base::FileInfo(deferred->getFileName()).hasExtension("bin");
+        if(binary == writer.getMode("BinaryBrep")
+                && deferred->read([&writer](Base::Reader &reader) {
+                                        writer.Stream() << reader.rdbuf();
+                                   }))
+            return;
+        loadDeferred();
+    }
+
     TopoDS_Shape myShape = _Shape.getShape();
     if(writer.getMode("BinaryBrep")) {
         TopoShape shape;
@@ -441,9 +481,7 @@ void PropertyPartShape::SaveDocFile (Base::Writer &writer) const
         shape.exportBinary(writer.Stream());
     }
     else {
-        bool direct = App::GetApplication().GetParameterGroupByPath
-            ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("DirectAccess", true);
-        if (!direct) {
+        if (!_DirectAccess) {
             // create a temporary file and copy the content to the zip stream
             // once the tmp. filename is known use always the same because otherwise
             // we may run into some problems on the Linux platform
@@ -497,21 +535,92 @@ void PropertyPartShape::SaveDocFile (Base::Writer &writer) const
     }
 }
 
+bool PropertyPartShape::isSaveDocFileThreadSafe() const
+{
+    // Writing through a temporary file is not thread safe
+    return _DirectAccess;
+}
+
+Base::Persistence *PropertyPartShape::createSaveSnapshot() const
+{
+    // Unlike Copy(), share the underlying shape, which is never modified in
+    // place once assigned. Code meshing a shape in place, such as the view
+    // provider, waits for any background saving to finish first.
+    PropertyPartShape *prop = new PropertyPartShape();
+    prop->_Shape = this->_Shape;
+    prop->_Ver = this->_Ver;
+    prop->_DirectAccess = this->_DirectAccess;
+    std::lock_guard<std::mutex> lock(_DeferredMutex);
+    prop->_Deferred = this->_Deferred;
+    return prop;
+}
+
 void PropertyPartShape::RestoreDocFile(Base::Reader &reader)
+{
+    TopoShape shape;
+    restoreShape(reader, shape, isDirectAccess());
+    std::string ver = _Ver;
+    setValue(shape);
+    _Ver = ver;
+}
+
+bool PropertyPartShape::deferRestoreDocFile(const std::shared_ptr<Base::DeferredDocFile> &file)
+{
+    std::lock_guard<std::mutex> lock(_DeferredMutex);
+    _Deferred = file;
+    _DirectAccess = isDirectAccess();
+    return true;
+}
+
+void PropertyPartShape::restoreDeferredDocFile()
+{
+    loadDeferred();
+}
+
+void PropertyPartShape::loadDeferred() const
+{
+    std::lock_guard<std::mutex> lock(_DeferredMutex);
+    if(!_Deferred)
+        return;
+
+    // The shape is considered as restored already. So do not signal any
+    // change here, just fill in the content.
+    auto self = const_cast<PropertyPartShape*>(this);
+    if(!_Deferred->read([self](Base::Reader &reader) {
+        TopoShape shape;
+        self->restoreShape(reader, shape, self->_DirectAccess);
+        auto owner = dynamic_cast<App::DocumentObject*>(self->getContainer());
+        if(owner)
+            shape.Tag = owner->getID();
+        self->_Shape = shape;
+    }))
+    {
+        // Keep the handle, or else the next save would silently replace the
+        // shape in the file with an empty one.
+        FC_THROWM(Base::FileException, "Failed to restore shape of "
+                << getFullName() << " from " << _Deferred->getSourcePath());
+    }
+    _Deferred.reset();
+}
+
+void PropertyPartShape::resetDeferred()
+{
+    std::lock_guard<std::mutex> lock(_DeferredMutex);
+    _Deferred.reset();
+}
+
+void PropertyPartShape::restoreShape(Base::Reader &reader, TopoShape &shape, bool direct)
 {
     // save the element map
     auto elementMap = _Shape.resetElementMap();
     auto hasher = _Shape.Hasher;
 
     Base::FileInfo brep(reader.getFileName());
-    TopoShape shape;
     if (brep.hasExtension("bin")) {
         shape.importBinary(reader);
     }
     else {
         TopoDS_Shape sh;
-        bool direct = App::GetApplication().GetParameterGroupByPath
-            ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("DirectAccess", true);
         if (!direct) {
             BRep_Builder builder;
             // create a temporary file and copy the content from the zip stream
@@ -559,12 +668,9 @@ void PropertyPartShape::RestoreDocFile(Base::Reader &reader)
         }
     }
 
-    std::string ver = _Ver;
     // restore the element map
     shape.Hasher = hasher;
     shape.resetElementMap(elementMap);
-    setValue(shape);
-    _Ver = ver;
 }
 
 // -------------------------------------------------------------------------
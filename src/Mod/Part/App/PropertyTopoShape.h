@@ -29,6 +29,7 @@
 #include <App/DocumentObject.h>
 #include <App/PropertyGeo.h>
 #include <map>
+#include <mutex>
 #include <vector>
 
 class BRepBuilderAPI_MakeShape;
@@ -84,6 +85,10 @@ public:
 
     void SaveDocFile (Base::Writer &writer) const;
     void RestoreDocFile(Base::Reader &reader);
+    virtual bool deferRestoreDocFile(const std::shared_ptr<Base::DeferredDocFile> &file) override;
+    virtual void restoreDeferredDocFile() override;
+    virtual bool isSaveDocFileThreadSafe() const override;
+    virtual Base::Persistence *createSaveSnapshot() const override;
 
     App::Property *Copy(void) const;
     void Paste(const App::Property &from);
@@ -96,9 +101,25 @@ public:
     virtual std::string getElementMapVersion(bool restored=false) const override;
     void resetElementMapVersion() {_Ver.clear();}
 
+private:
+    void restoreShape(Base::Reader &reader, TopoShape &shape, bool direct);
+    /** Read the shape from the file deferred by lazy restore, if there is any
+     *
+     * It may be called concurrently, e.g. by background saving. The handle is
+     * kept, and an exception thrown, if the file cannot be read.
+     */
+    void loadDeferred() const;
+    void resetDeferred();
+
 private:
     TopoShape _Shape;
     std::string _Ver;
+    mutable std::shared_ptr<Base::DeferredDocFile> _Deferred;
+    mutable std::mutex _DeferredMutex;
+    // The DirectAccess parameter, read in the main thread by Save() and
+    // deferRestoreDocFile(), because SaveDocFile() and loadDeferred() may be
+    // called from worker threads.
+    mutable bool _DirectAccess;
 };
 
 struct PartExport ShapeHistory {
@@ -40,6 +40,7 @@ class BRepFeat_MakePrism;
 class BRepOffsetAPI_MakePipeShell;
 class BRepOffsetAPI_DraftAngle;
 class BRepPrimAPI_MakeHalfSpace; 
+class BRepAlgoAPI_BuilderAlgo;
 class gp_Ax1;
 class gp_Ax2;
 class gp_Vec;
@@ -85,6 +86,38 @@ public:
    virtual ~BooleanException() throw() {}
 };
 
+/** Options of boolean operations
+ *
+ * The default options give the same result as OCCT does without any
+ * option set, except that the input shapes are never modified.
+ */
+struct PartExport BooleanOptions
+{
+    /// Additional tolerance for finding interferences, 0 to disable
+    double fuzzyValue = 0.0;
+    /// Use oriented bound boxes to filter interfering sub-shapes (OCCT 7.3 and up)
+    bool useOBB = false;
+    /** Speed up operations on shapes that touch but do not intersect
+     *
+     * 0: off, 1: shift (faces of the shapes may partially coincide), 2: full
+     * (the shapes only share whole sub-shapes). The result is wrong if the
+     * shapes interfere otherwise.
+     */
+    int glue = 0;
+    /// Do not modify the input shapes (OCCT 7.0 and up)
+    bool nonDestructive = true;
+    /** Exclude shapes whose bound box does not touch the first shape (cut
+     * and common), or any other shape (fuse), from the operation
+     */
+    bool prefilter = false;
+
+    /// Apply the options to a boolean operation before building it
+    void apply(BRepAlgoAPI_BuilderAlgo &mk) const;
+
+    /// Names of the glue options, for use in a property enumeration
+    static const char *GlueEnums[];
+};
+
 class PartExport ShapeSegment : public Data::Segment
 {
     TYPESYSTEM_HEADER();
@@ -415,6 +448,19 @@ public:
     TopoShape &makEShape(const char *maker, const std::vector<TopoShape> &shapes, 
             const char *op=0, double tol = 0.0);
     TopoShape &makEShape(const char *maker, const TopoShape &shape, const char *op=0, double tol = 0.0);
+    /** Make a boolean operation with options
+     *
+     * @param maker: one of TOPOP_FUSE, TOPOP_CUT, TOPOP_COMMON and TOPOP_SECTION
+     * @param shapes: the argument followed by the tool shapes
+     * @param options: boolean options
+     * @param op: optional string to be encoded into topo naming for indicating
+     *            the operation
+     *
+     * makEShape() with the same maker calls this function with default
+     * options and the given fuzzy value.
+     */
+    TopoShape &makEBoolean(const char *maker, const std::vector<TopoShape> &shapes,
+            const BooleanOptions &options, const char *op=0);
     TopoShape makEShape(const char *maker, const char *op=0, double tol = 0.0) const {
         return TopoShape(0,Hasher).makEShape(maker,*this,op,tol);
     }
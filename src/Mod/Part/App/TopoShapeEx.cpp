@@ -42,6 +42,7 @@
 # include <BRepAlgoAPI_Fuse.hxx>
 # include <BRepAlgo_Fuse.hxx>
 # include <BRepAlgoAPI_Section.hxx>
+# include <BRepAlgoAPI_BuilderAlgo.hxx>
 # include <BRepBndLib.hxx>
 # include <BRepBuilderAPI_FindPlane.hxx>
 # include <BRepLib_FindSurface.hxx>
@@ -170,6 +171,8 @@
 #include <boost/algorithm/string/predicate.hpp>
 #include <Base/Exception.h>
 #include <Base/Console.h>
+#include <Base/Parameter.h>
+#include <App/Application.h>
 
 
 #include "PartPyCXX.h"
@@ -1891,6 +1894,63 @@ TopoShape &TopoShape::makEShape(const char *maker,
         return *this;
     }
 
+    BooleanOptions options;
+    options.fuzzyValue = tol;
+    return makEBoolean(maker,shapes,options,op);
+}
+
+void BooleanOptions::apply(BRepAlgoAPI_BuilderAlgo &mk) const
+{
+#if OCC_VERSION_HEX >= 0x060900
+    mk.SetRunParallel(true);
+    if (fuzzyValue > 0.0)
+        mk.SetFuzzyValue(fuzzyValue);
+#endif
+#if OCC_VERSION_HEX >= 0x070000
+    mk.SetNonDestructive(nonDestructive ? Standard_True : Standard_False);
+    switch(glue) {
+    case 0:
+        mk.SetGlue(BOPAlgo_GlueOff);
+        break;
+    case 1:
+        mk.SetGlue(BOPAlgo_GlueShift);
+        break;
+    case 2:
+        mk.SetGlue(BOPAlgo_GlueFull);
+        break;
+    default:
+        FC_THROWM(Base::ValueError,"Invalid boolean glue option " << glue);
+    }
+#endif
+#if OCC_VERSION_HEX >= 0x070300
+    mk.SetUseOBB(useOBB ? Standard_True : Standard_False);
+#endif
+}
+
+const char *BooleanOptions::GlueEnums[] = {"Off", "Shift", "Full", nullptr};
+
+static Bnd_Box getBooleanBound(const TopoShape &shape, double tol)
+{
+    Bnd_Box bound;
+    BRepBndLib::Add(shape.getShape(), bound);
+    bound.SetGap(tol + Precision::Confusion());
+    return bound;
+}
+
+TopoShape &TopoShape::makEBoolean(const char *maker,
+        const std::vector<TopoShape> &shapes, const BooleanOptions &options, const char *op)
+{
+    if(!maker)
+        FC_THROWM(Base::CADKernelError,"no maker");
+
+    if(!op) op = maker;
+    _Shape.Nullify();
+    resetElementMap();
+
+    if(shapes.empty())
+        HANDLE_NULL_SHAPE;
+
+    double tol = options.fuzzyValue;
     std::vector<TopoShape> _shapes;
     if(strcmp(maker, TOPOP_FUSE)==0) {
         for(auto it=shapes.begin();it!=shapes.end();++it) {
@@ -1905,15 +1965,74 @@ TopoShape &TopoShape::makEShape(const char *maker,
                 _shapes.push_back(s);
         }
     }
-    const auto &inputs = _shapes.size()?_shapes:shapes;
-    if(inputs.empty())
+    const auto &expanded = _shapes.size()?_shapes:shapes;
+    if(expanded.empty())
         HANDLE_NULL_INPUT;
-    if(inputs.size()==1) {
-        *this = inputs[0];
+    if(expanded.size()==1) {
+        *this = expanded[0];
         FC_WARN("Boolean operation with only one shape input");
         return *this;
     }
 
+    // Fused shapes excluded from the operation by their bound box, which are
+    // added to the result afterwards
+    std::vector<TopoShape> excluded;
+    std::vector<TopoShape> filtered;
+#if OCC_VERSION_HEX > 0x060800
+    if(options.prefilter) {
+        for(auto &s : expanded) {
+            if(s.isNull())
+                HANDLE_NULL_INPUT;
+        }
+        std::vector<Bnd_Box> bounds;
+        bounds.reserve(expanded.size());
+        for(auto &s : expanded)
+            bounds.push_back(getBooleanBound(s,tol));
+        if(strcmp(maker, TOPOP_FUSE)==0) {
+            for(size_t i=0;i<expanded.size();++i) {
+                bool touched = false;
+                for(size_t j=0;j<expanded.size();++j) {
+                    if(i!=j && !bounds[i].IsOut(bounds[j])) {
+                        touched = true;
+                        break;
+                    }
+                }
+                if(touched)
+                    filtered.push_back(expanded[i]);
+                else
+                    excluded.push_back(expanded[i]);
+            }
+            if(filtered.size()==1) {
+                excluded.push_back(filtered.front());
+                filtered.clear();
+            }
+            if(filtered.empty()) {
+                // Nothing to fuse, just like BRepAlgoAPI_Fuse which returns
+                // a compound of the untouched input shapes
+                return makECompound(excluded,op,false);
+            }
+        } else if(strcmp(maker, TOPOP_CUT)==0 || strcmp(maker, TOPOP_COMMON)==0) {
+            filtered.push_back(expanded[0]);
+            for(size_t i=1;i<expanded.size();++i) {
+                if(!bounds[0].IsOut(bounds[i]))
+                    filtered.push_back(expanded[i]);
+            }
+            if(filtered.size()==1) {
+                // Nothing to cut. A common operation with no tool touching
+                // the argument is still done to give the empty result.
+                if(strcmp(maker, TOPOP_CUT)==0) {
+                    *this = filtered[0];
+                    return *this;
+                }
+                filtered.clear();
+            }
+        }
+        if(filtered.size()==expanded.size())
+            filtered.clear();
+    }
+#endif
+    const auto &inputs = filtered.size()?filtered:expanded;
+
 #if OCC_VERSION_HEX <= 0x060800
     if (tol > 0.0)
         Standard_Failure::Raise("Fuzzy Booleans are not supported in this version of OCCT");
@@ -1978,12 +2097,7 @@ TopoShape &TopoShape::makEShape(const char *maker,
     else
         FC_THROWM(Base::CADKernelError,"Unknown maker");
         
-# if OCC_VERSION_HEX >= 0x060900
-    mk->SetRunParallel(true);
-# endif
-#if OCC_VERSION_HEX >= 0x070000
-    mk->SetNonDestructive(Standard_True);
-#endif
+    options.apply(*mk);
     TopTools_ListOfShape shapeArguments,shapeTools;
 
     int i=-1;
@@ -2000,10 +2114,17 @@ TopoShape &TopoShape::makEShape(const char *maker,
     }
     mk->SetArguments(shapeArguments);
     mk->SetTools(shapeTools);
-    if (tol > 0.0)
-        mk->SetFuzzyValue(tol);
     mk->Build();
-    return makEShape(*mk,shapes,op);
+    if(excluded.empty())
+        return makEShape(*mk,filtered.empty()?shapes:filtered,op);
+
+    // Add the fused shapes that are excluded from the operation
+    TopoShape res(Tag,Hasher);
+    res.makEShape(*mk,inputs,op);
+    std::vector<TopoShape> pieces;
+    expandCompound(res,pieces);
+    pieces.insert(pieces.end(),excluded.begin(),excluded.end());
+    return makECompound(pieces,op,false);
 #endif
 }
 
@@ -723,24 +723,36 @@ PyObject*  TopoShapePy::check(PyObject *args)
     return IncRef();
 }
 
-static PyObject *makeShape(const char *op,const TopoShape &shape, PyObject *args) {
-    double tol=0;
+static PyObject *makeShape(const char *op,const TopoShape &shape, PyObject *args, PyObject *kwds=0) {
+    static char *kwlist[] = {"shapes", "tolerance", "useOBB", "glue", "nonDestructive", "prefilter", NULL};
+    BooleanOptions options;
     PyObject *pcObj;
-    if (!PyArg_ParseTuple(args, "O|d", &pcObj,&tol))
+    PyObject *useOBB = Py_False;
+    PyObject *nonDestructive = Py_True;
+    PyObject *prefilter = Py_False;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|dO!iO!O!", kwlist, &pcObj, &options.fuzzyValue,
+                &PyBool_Type, &useOBB, &options.glue, &PyBool_Type, &nonDestructive, &PyBool_Type, &prefilter))
         return 0;
+    options.useOBB = PyObject_IsTrue(useOBB) ? true : false;
+    options.nonDestructive = PyObject_IsTrue(nonDestructive) ? true : false;
+    options.prefilter = PyObject_IsTrue(prefilter) ? true : false;
     PY_TRY {
         std::vector<TopoShape> shapes;
         shapes.push_back(shape);
         getPyShapes(pcObj,shapes);
-        return Py::new_reference_to(shape2pyshape(TopoShape().makEShape(op,shapes,0,tol)));
+        return Py::new_reference_to(shape2pyshape(TopoShape().makEBoolean(op,shapes,options)));
     } PY_CATCH_OCC
 }
 
-PyObject*  TopoShapePy::fuse(PyObject *args)
+PyObject*  TopoShapePy::fuse(PyObject *args, PyObject *kwds)
 {
 #if !defined(FC_NO_ELEMENT_MAP) && (OCC_VERSION_HEX>=0x060900)
-    return makeShape(TOPOP_FUSE,*getTopoShapePtr(),args);
+    return makeShape(TOPOP_FUSE,*getTopoShapePtr(),args,kwds);
 #else
+    if (kwds && PyDict_Size(kwds)) {
+        PyErr_SetString(PyExc_TypeError, "boolean options are not supported");
+        return 0;
+    }
     PyObject *pcObj;
     if (PyArg_ParseTuple(args, "O!", &(TopoShapePy::Type), &pcObj)) {
         TopoDS_Shape shape = static_cast<TopoShapePy*>(pcObj)->getTopoShapePtr()->getShape();
@@ -830,11 +842,15 @@ PyObject*  TopoShapePy::oldFuse(PyObject *args)
     } PY_CATCH_OCC
 }
 
-PyObject*  TopoShapePy::common(PyObject *args)
+PyObject*  TopoShapePy::common(PyObject *args, PyObject *kwds)
 {
 #if !defined(FC_NO_ELEMENT_MAP) && (OCC_VERSION_HEX>=0x060900)
-    return makeShape(TOPOP_COMMON,*getTopoShapePtr(),args);
+    return makeShape(TOPOP_COMMON,*getTopoShapePtr(),args,kwds);
 #else
+    if (kwds && PyDict_Size(kwds)) {
+        PyErr_SetString(PyExc_TypeError, "boolean options are not supported");
+        return 0;
+    }
     PyObject *pcObj;
     if (PyArg_ParseTuple(args, "O!", &(TopoShapePy::Type), &pcObj)) {
         TopoDS_Shape shape = static_cast<TopoShapePy*>(pcObj)->getTopoShapePtr()->getShape();
@@ -983,11 +999,15 @@ PyObject*  TopoShapePy::slices(PyObject *args)
     } PY_CATCH_OCC
 }
 
-PyObject*  TopoShapePy::cut(PyObject *args)
+PyObject*  TopoShapePy::cut(PyObject *args, PyObject *kwds)
 {
 #if !defined(FC_NO_ELEMENT_MAP) && (OCC_VERSION_HEX>=0x060900)
-    return makeShape(TOPOP_CUT,*getTopoShapePtr(),args);
+    return makeShape(TOPOP_CUT,*getTopoShapePtr(),args,kwds);
 #else
+    if (kwds && PyDict_Size(kwds)) {
+        PyErr_SetString(PyExc_TypeError, "boolean options are not supported");
+        return 0;
+    }
     PyObject *pcObj;
     if (PyArg_ParseTuple(args, "O!", &(TopoShapePy::Type), &pcObj)) {
         TopoDS_Shape shape = static_cast<TopoShapePy*>(pcObj)->getTopoShapePtr()->getShape();
@@ -146,6 +146,7 @@ PyMOD_INIT_FUNC(PartGui)
     PartGui::SoBrepEdgeSet                  ::initClass();
     PartGui::SoBrepPointSet                 ::initClass();
     PartGui::SoFCControlPoints              ::initClass();
+    PartGui::SoFCShapeLevelOfDetail         ::initClass();
     PartGui::ViewProviderPartExt            ::init();
     PartGui::ViewProviderPart               ::init();
     PartGui::ViewProviderEllipsoid          ::init();
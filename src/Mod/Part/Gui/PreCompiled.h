@@ -123,6 +123,7 @@
 #include <TopExp_Explorer.hxx>
 #include <TopLoc_Location.hxx>
 
+#include <BRep_Builder.hxx>
 #include <BRep_Tool.hxx>
 #include <BRepTools.hxx>
 #include <BRepAdaptor_Surface.hxx>
@@ -180,6 +181,9 @@
 #ifndef __Qt4All__
 # include <Gui/Qt4All.h>
 #endif
+#include <QCryptographicHash>
+#include <QFutureWatcher>
+#include <QtConcurrentRun>
 
 // GL
 // Include glext before InventorAll
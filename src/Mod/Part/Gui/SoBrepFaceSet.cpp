@@ -183,6 +183,17 @@ SoBrepFaceSet::~SoBrepFaceSet()
 {
 }
 
+bool SoBrepFaceSet::hasRenderContext()
+{
+    SelContextPtr ctx2;
+    SelContextPtr ctx = Gui::SoFCSelectionRoot::getRenderContext(this,selContext,ctx2);
+    if(ctx2)
+        return true;
+    if(selContext2->checkGlobal(ctx))
+        ctx = selContext2;
+    return ctx && (ctx->selectionIndex.size() || ctx->highlightIndex>=0);
+}
+
 void SoBrepFaceSet::doAction(SoAction* action)
 {
     if (action->getTypeId() == Gui::SoHighlightElementAction::getClassTypeId()) {
@@ -86,6 +86,13 @@ public:
 
     SoMFInt32 partIndex;
 
+    /** Check if there is any selection or highlight to render
+     *
+     * Only valid during rendering, as the selection context depends on the
+     * current render path.
+     */
+    bool hasRenderContext();
+
 protected:
     virtual ~SoBrepFaceSet();
     virtual void GLRender(SoGLRenderAction *action);
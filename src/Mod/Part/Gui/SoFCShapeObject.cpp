@@ -44,11 +44,15 @@
 # include <Inventor/bundles/SoTextureCoordinateBundle.h>
 # include <Inventor/elements/SoCoordinateElement.h>
 # include <Inventor/elements/SoGLCacheContextElement.h>
+# include <Inventor/elements/SoModelMatrixElement.h>
+# include <Inventor/elements/SoViewportRegionElement.h>
+# include <Inventor/elements/SoViewVolumeElement.h>
 # include <Inventor/errors/SoReadError.h>
 # include <Inventor/misc/SoState.h>
 #endif
 
 #include "SoFCShapeObject.h"
+#include "SoBrepFaceSet.h"
 
 using namespace PartGui;
 
@@ -184,3 +188,149 @@ void SoFCControlPoints::computeBBox(SoAction *action, SbBox3f &box, SbVec3f &cen
         center.setValue(0.0f,0.0f,0.0f);
     }
 }
+
+// ------------------------------------------------------------------
+
+SO_NODE_SOURCE(SoFCShapeLevelOfDetail);
+
+void SoFCShapeLevelOfDetail::initClass()
+{
+    SO_NODE_INIT_CLASS(SoFCShapeLevelOfDetail, SoGroup, "Group");
+}
+
+SoFCShapeLevelOfDetail::SoFCShapeLevelOfDetail()
+{
+    SO_NODE_CONSTRUCTOR(SoFCShapeLevelOfDetail);
+
+    SO_NODE_ADD_FIELD(bbox, (SbBox3f()));
+    SO_NODE_ADD_FIELD(screenArea, (0.0f));
+
+    detailFaceSet = 0;
+}
+
+SoFCShapeLevelOfDetail::~SoFCShapeLevelOfDetail()
+{
+    if (detailFaceSet)
+        detailFaceSet->unref();
+}
+
+void SoFCShapeLevelOfDetail::setDetailFaceSet(SoBrepFaceSet *faceset)
+{
+    if (faceset)
+        faceset->ref();
+    if (detailFaceSet)
+        detailFaceSet->unref();
+    detailFaceSet = faceset;
+}
+
+int SoFCShapeLevelOfDetail::whichToRender(SoGLRenderAction *action) const
+{
+    if (getNumChildren() < 2 || screenArea.getValue() <= 0.0f)
+        return 0;
+    SbBox3f box = bbox.getValue();
+    if (box.isEmpty())
+        return 0;
+
+    SoState *state = action->getState();
+    // The choice depends on the camera, so do not let a parent cache it
+    SoGLCacheContextElement::shouldAutoCache(state, SoGLCacheContextElement::DONT_AUTO_CACHE);
+
+    // Selection and preselection are keyed by the detail face set, and
+    // picking reports its elements, so show them on the detail level
+    if (detailFaceSet && detailFaceSet->hasRenderContext())
+        return 0;
+
+    box.transform(SoModelMatrixElement::get(state));
+    const SbViewVolume &vv = SoViewVolumeElement::get(state);
+    if (vv.getProjectionType() == SbViewVolume::PERSPECTIVE
+            && box.intersect(vv.getProjectionPoint()))
+        return 0;
+
+    SbVec3f bmin, bmax;
+    box.getBounds(bmin, bmax);
+    SbBox2f projected;
+    for (int i=0; i<8; ++i) {
+        SbVec3f corner(i&1 ? bmax[0] : bmin[0],
+                       i&2 ? bmax[1] : bmin[1],
+                       i&4 ? bmax[2] : bmin[2]);
+        SbVec3f screen;
+        vv.projectToScreen(corner, screen);
+        projected.extendBy(SbVec2f(screen[0], screen[1]));
+    }
+    float width, height;
+    projected.getSize(width, height);
+    const SbVec2s &size = SoViewportRegionElement::get(state).getViewportSizePixels();
+    float area = width * size[0] * height * size[1];
+    return area < screenArea.getValue() ? 1 : 0;
+}
+
+void SoFCShapeLevelOfDetail::traverseChild(SoAction *action, int idx)
+{
+    int numindices;
+    const int *indices;
+    switch (action->getPathCode(numindices, indices)) {
+    case SoAction::IN_PATH:
+        this->children->traverseInPath(action, numindices, indices);
+        break;
+    case SoAction::OFF_PATH:
+        if (idx < getNumChildren() && getChild(idx)->affectsState())
+            this->children->traverse(action, idx);
+        break;
+    default:
+        if (idx < getNumChildren())
+            this->children->traverse(action, idx);
+        break;
+    }
+}
+
+void SoFCShapeLevelOfDetail::doAction(SoAction *action)
+{
+    traverseChild(action, 0);
+}
+
+void SoFCShapeLevelOfDetail::GLRender(SoGLRenderAction *action)
+{
+    traverseChild(action, whichToRender(action));
+}
+
+void SoFCShapeLevelOfDetail::GLRenderBelowPath(SoGLRenderAction *action)
+{
+    int idx = whichToRender(action);
+    if (idx >= getNumChildren())
+        return;
+    SoNode *child = getChild(idx);
+    action->pushCurPath(idx, child);
+    if (!action->abortNow())
+        child->GLRenderBelowPath(action);
+    action->popCurPath();
+}
+
+void SoFCShapeLevelOfDetail::callback(SoCallbackAction *action)
+{
+    doAction(action);
+}
+
+void SoFCShapeLevelOfDetail::getBoundingBox(SoGetBoundingBoxAction *action)
+{
+    doAction(action);
+}
+
+void SoFCShapeLevelOfDetail::getMatrix(SoGetMatrixAction *action)
+{
+    doAction(action);
+}
+
+void SoFCShapeLevelOfDetail::handleEvent(SoHandleEventAction *action)
+{
+    doAction(action);
+}
+
+void SoFCShapeLevelOfDetail::pick(SoPickAction *action)
+{
+    doAction(action);
+}
+
+void SoFCShapeLevelOfDetail::getPrimitiveCount(SoGetPrimitiveCountAction *action)
+{
+    doAction(action);
+}
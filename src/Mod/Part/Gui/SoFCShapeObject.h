@@ -25,13 +25,18 @@
 
 #include <Inventor/fields/SoSFUInt32.h>
 #include <Inventor/fields/SoSFColor.h>
+#include <Inventor/fields/SoSFBox3f.h>
+#include <Inventor/fields/SoSFFloat.h>
 #include <Inventor/fields/SoSubField.h>
 #include <Inventor/nodes/SoSubNode.h>
 #include <Inventor/nodes/SoShape.h>
+#include <Inventor/nodes/SoGroup.h>
 #include <Inventor/elements/SoReplacedElement.h>
 
 namespace PartGui {
 
+class SoBrepFaceSet;
+
 class PartGuiExport SoFCControlPoints : public SoShape {
     typedef SoShape inherited;
 
@@ -57,6 +62,51 @@ private:
     void drawControlPoints(const SbVec3f *,int32_t) const;
 };
 
+/** Group node to render a coarser representation of small shapes
+ *
+ * The first child holds the full detail representation and the second one a
+ * coarser one. The second child is rendered if the projected area of \a bbox
+ * on screen is less than \a screenArea pixels, and the face set of the first
+ * child has no selection or highlight to show. Unlike SoLOD, all other
+ * actions, e.g. picking and selection, only traverse the first child.
+ */
+class PartGuiExport SoFCShapeLevelOfDetail : public SoGroup {
+    typedef SoGroup inherited;
+
+    SO_NODE_HEADER(SoFCShapeLevelOfDetail);
+
+public:
+    static void initClass();
+    SoFCShapeLevelOfDetail();
+
+    /// Bounding box of the children, in local coordinates
+    SoSFBox3f bbox;
+    /// Screen area in pixels below which the coarse child is rendered, 0 to disable
+    SoSFFloat screenArea;
+
+    virtual void doAction(SoAction *action);
+    virtual void GLRender(SoGLRenderAction *action);
+    virtual void GLRenderBelowPath(SoGLRenderAction *action);
+    virtual void callback(SoCallbackAction *action);
+    virtual void getBoundingBox(SoGetBoundingBoxAction *action);
+    virtual void getMatrix(SoGetMatrixAction *action);
+    virtual void handleEvent(SoHandleEventAction *action);
+    virtual void pick(SoPickAction *action);
+    virtual void getPrimitiveCount(SoGetPrimitiveCountAction *action);
+
+    /// Set the face set of the first child, which holds the selection context
+    void setDetailFaceSet(SoBrepFaceSet *faceset);
+
+protected:
+    virtual ~SoFCShapeLevelOfDetail();
+
+private:
+    int whichToRender(SoGLRenderAction *action) const;
+    void traverseChild(SoAction *action, int idx);
+
+    SoBrepFaceSet *detailFaceSet;
+};
+
 } // namespace PartGui
 
 
@@ -0,0 +1,297 @@
+/****************************************************************************
+ *   Copyright (c) 2020 FreeCAD Developers                                  *
+ *                                                                          *
+ *   This file is part of the FreeCAD CAx development system.               *
+ *                                                                          *
+ *   This library is free software; you can redistribute it and/or          *
+ *   modify it under the terms of the GNU Library General Public            *
+ *   License as published by the Free Software Foundation; either           *
+ *   version 2 of the License, or (at your option) any later version.       *
+ *                                                                          *
+ *   This library  is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *   GNU Library General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU Library General Public      *
+ *   License along with this library; see the file COPYING.LIB. If not,     *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,          *
+ *   Suite 330, Boston, MA  02111-1307, USA                                 *
+ *                                                                          *
+ ****************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <iomanip>
+# include <ostream>
+# include <BRepTools_ShapeSet.hxx>
+# include <TopLoc_Location.hxx>
+# include <TopoDS_Shape.hxx>
+# include <QCryptographicHash>
+#endif
+
+#include <Base/Console.h>
+#include <Base/FileInfo.h>
+#include <Base/Parameter.h>
+#include <Base/Stream.h>
+#include <Base/TimeInfo.h>
+#include <App/Application.h>
+
+#include "TessellationCache.h"
+
+FC_LOG_LEVEL_INIT("Part", true, true);
+
+using namespace PartGui;
+
+namespace {
+
+// Increase whenever the content of ShapeTessellation or its meaning changes
+const uint32_t CacheVersion = 1;
+const char CacheMagic[4] = {'F','C','T','C'};
+
+/// Output stream buffer feeding the data into a hash
+class HashStreambuf : public std::streambuf
+{
+public:
+    HashStreambuf()
+        :hash(QCryptographicHash::Sha1)
+    {
+        setp(buffer, buffer+sizeof(buffer));
+    }
+
+    std::string result() {
+        sync();
+        return std::string(hash.result().toHex().constData());
+    }
+
+protected:
+    int overflow(int c) override {
+        sync();
+        if (c != traits_type::eof()) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    int sync() override {
+        if (pptr() != pbase())
+            hash.addData(pbase(), static_cast<int>(pptr()-pbase()));
+        setp(buffer, buffer+sizeof(buffer));
+        return 0;
+    }
+
+private:
+    QCryptographicHash hash;
+    char buffer[4096];
+};
+
+template<class T>
+void writeArray(std::ostream &s, const std::vector<T> &values)
+{
+    uint32_t count = static_cast<uint32_t>(values.size());
+    s.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    if (count)
+        s.write(reinterpret_cast<const char*>(values.data()), sizeof(T)*count);
+}
+
+template<class T>
+bool readArray(std::istream &s, std::vector<T> &values, std::size_t maxCount)
+{
+    uint32_t count = 0;
+    if (!s.read(reinterpret_cast<char*>(&count), sizeof(count)) || count > maxCount)
+        return false;
+    values.resize(count);
+    return !count || s.read(reinterpret_cast<char*>(values.data()), sizeof(T)*count);
+}
+
+ParameterGrp::handle getParameter()
+{
+    return App::GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Mod/Part");
+}
+
+} // anonymous namespace
+
+TessellationCache::TessellationCache()
+    :usedSize(-1)
+{
+    path = App::Application::getUserAppDataDir() + "TessellationCache";
+}
+
+TessellationCache &TessellationCache::instance()
+{
+    static TessellationCache *_instance;
+    if (!_instance)
+        _instance = new TessellationCache;
+    return *_instance;
+}
+
+bool TessellationCache::isEnabled() const
+{
+    return getParameter()->GetBool("TessellationCache", true);
+}
+
+std::string TessellationCache::getShapeHash(const TopoDS_Shape &shape) const
+{
+    HashStreambuf buf;
+    std::ostream s(&buf);
+    try {
+        // Same format as used for saving the shape in a document, i.e.
+        // without any triangulation. The placement is excluded because it
+        // does not affect the content of the Inventor nodes.
+        TopoDS_Shape sh = shape.Located(TopLoc_Location());
+        BRepTools_ShapeSet shapeSet(Standard_False);
+        shapeSet.Add(sh);
+        shapeSet.Write(s);
+        shapeSet.Write(sh, s);
+    }
+    catch (...) {
+        return std::string();
+    }
+    s.flush();
+    return buf.result();
+}
+
+std::string TessellationCache::getKey(const std::string &shapeHash, double deflection,
+        double angularDeflection, bool normalsFromUV) const
+{
+    if (shapeHash.empty())
+        return std::string();
+    HashStreambuf buf;
+    std::ostream s(&buf);
+    s << shapeHash << ' ' << std::setprecision(17) << deflection << ' '
+      << angularDeflection << ' ' << normalsFromUV << ' ' << CacheVersion;
+    s.flush();
+    return buf.result();
+}
+
+std::string TessellationCache::getFileName(const std::string &key) const
+{
+    return path + "/" + key + ".tess";
+}
+
+bool TessellationCache::load(const std::string &key, ShapeTessellation &res) const
+{
+    if (key.empty())
+        return false;
+
+    Base::FileInfo fi(getFileName(key));
+    if (!fi.isReadable())
+        return false;
+
+    Base::ifstream file(fi, std::ios::in | std::ios::binary);
+    char magic[sizeof(CacheMagic)];
+    uint32_t version = 0;
+    int32_t nodeStart = 0;
+    if (!file.read(magic, sizeof(magic))
+            || !std::equal(magic, magic+sizeof(magic), CacheMagic)
+            || !file.read(reinterpret_cast<char*>(&version), sizeof(version))
+            || version != CacheVersion
+            || !file.read(reinterpret_cast<char*>(&nodeStart), sizeof(nodeStart)))
+    {
+        FC_WARN("Invalid tessellation cache file " << fi.filePath());
+        return false;
+    }
+
+    // Guard against allocating huge memory for a corrupted file
+    std::size_t maxCount = fi.size();
+    if (!readArray(file, res.verts, maxCount)
+            || !readArray(file, res.norms, maxCount)
+            || !readArray(file, res.faceIndex, maxCount)
+            || !readArray(file, res.partIndex, maxCount)
+            || !readArray(file, res.lineIndex, maxCount)
+            || nodeStart < 0 || nodeStart > (int32_t)res.verts.size())
+    {
+        FC_WARN("Invalid tessellation cache file " << fi.filePath());
+        res = ShapeTessellation();
+        return false;
+    }
+    res.nodeStart = nodeStart;
+    FC_LOG("Tessellation cache hit " << key);
+    return true;
+}
+
+void TessellationCache::save(const std::string &key, const ShapeTessellation &res)
+{
+    if (key.empty())
+        return;
+
+    Base::FileInfo dir(path);
+    if (!dir.exists() && !dir.createDirectory()) {
+        FC_WARN("Cannot create tessellation cache directory " << path);
+        return;
+    }
+
+    // Write to a temporary file first, so that a concurrently running
+    // application never sees a partially written entry.
+    std::string fileName = getFileName(key);
+    Base::FileInfo tmp(fileName + ".tmp");
+    {
+        Base::ofstream file(tmp, std::ios::out | std::ios::binary | std::ios::trunc);
+        int32_t nodeStart = res.nodeStart;
+        file.write(CacheMagic, sizeof(CacheMagic));
+        file.write(reinterpret_cast<const char*>(&CacheVersion), sizeof(CacheVersion));
+        file.write(reinterpret_cast<const char*>(&nodeStart), sizeof(nodeStart));
+        writeArray(file, res.verts);
+        writeArray(file, res.norms);
+        writeArray(file, res.faceIndex);
+        writeArray(file, res.partIndex);
+        writeArray(file, res.lineIndex);
+        if (!file) {
+            FC_WARN("Failed to write tessellation cache file " << tmp.filePath());
+            file.close();
+            tmp.deleteFile();
+            return;
+        }
+    }
+    Base::FileInfo target(fileName);
+    if (target.exists())
+        target.deleteFile();
+    if (!tmp.renameFile(fileName.c_str())) {
+        tmp.deleteFile();
+        return;
+    }
+
+    if (usedSize >= 0)
+        usedSize += target.size();
+    prune();
+}
+
+void TessellationCache::prune()
+{
+    long long limit = getParameter()->GetInt("TessellationCacheSize", 256) * 1024LL * 1024LL;
+    if (usedSize >= 0 && usedSize <= limit)
+        return;
+
+    // Scan the directory on first use in a session, and whenever the limit is
+    // exceeded. Remove the oldest entries until only three quarters of the
+    // limit are used, so that this does not happen on each save.
+    std::vector<Base::FileInfo> files;
+    usedSize = 0;
+    for (auto &fi : Base::FileInfo(path).getDirectoryContent()) {
+        if (fi.isFile() && fi.hasExtension("tess")) {
+            usedSize += fi.size();
+            files.push_back(fi);
+        }
+    }
+    if (usedSize <= limit)
+        return;
+
+    std::vector<std::pair<uint64_t, std::size_t> > times;
+    times.reserve(files.size());
+    for (std::size_t i=0; i<files.size(); ++i)
+        times.emplace_back(files[i].lastModified().getSeconds(), i);
+    std::sort(times.begin(), times.end());
+    for (auto &v : times) {
+        if (usedSize <= limit/4*3)
+            break;
+        auto &fi = files[v.second];
+        long long size = fi.size();
+        if (fi.deleteFile())
+            usedSize -= size;
+    }
+    FC_LOG("Tessellation cache pruned to " << usedSize << " bytes");
+}
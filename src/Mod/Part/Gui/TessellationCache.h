@@ -0,0 +1,93 @@
+/****************************************************************************
+ *   Copyright (c) 2020 FreeCAD Developers                                  *
+ *                                                                          *
+ *   This file is part of the FreeCAD CAx development system.               *
+ *                                                                          *
+ *   This library is free software; you can redistribute it and/or          *
+ *   modify it under the terms of the GNU Library General Public            *
+ *   License as published by the Free Software Foundation; either           *
+ *   version 2 of the License, or (at your option) any later version.       *
+ *                                                                          *
+ *   This library  is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *   GNU Library General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU Library General Public      *
+ *   License along with this library; see the file COPYING.LIB. If not,     *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,          *
+ *   Suite 330, Boston, MA  02111-1307, USA                                 *
+ *                                                                          *
+ ****************************************************************************/
+
+#ifndef PARTGUI_TESSELLATIONCACHE_H
+#define PARTGUI_TESSELLATIONCACHE_H
+
+#include <string>
+#include <vector>
+#include <Inventor/SbVec3f.h>
+
+class TopoDS_Shape;
+
+namespace PartGui {
+
+/// Triangulation of a shape in the layout of the Inventor nodes of ViewProviderPartExt
+struct ShapeTessellation
+{
+    std::vector<SbVec3f> verts;
+    std::vector<SbVec3f> norms;
+    std::vector<int32_t> faceIndex;
+    std::vector<int32_t> partIndex;
+    std::vector<int32_t> lineIndex;
+    int nodeStart = 0;
+};
+
+/** Persistent cache of shape triangulations
+ *
+ * The triangulations are stored in the user data directory, one file per
+ * entry, named after a hash of the shape content (excluding its placement)
+ * and the meshing parameters. So an unchanged shape, e.g. of a reopened
+ * document, can be shown without meshing it again.
+ *
+ * The cache is controlled by the parameters TessellationCache and
+ * TessellationCacheSize (in MB) in BaseApp/Preferences/Mod/Part. The
+ * oldest entries are removed once the cache grows over the size limit.
+ */
+class PartGuiExport TessellationCache
+{
+public:
+    static TessellationCache &instance();
+
+    /// Check if the cache is enabled
+    bool isEnabled() const;
+
+    /** Return a hash of the shape content excluding its placement
+     *
+     * The hash is computed from the BRep content of the shape, which is
+     * relatively cheap compared to meshing, but not for free. Only call it if
+     * the shape is to be meshed. Returns an empty string on error.
+     */
+    std::string getShapeHash(const TopoDS_Shape &shape) const;
+
+    /// Return the key of a shape with the given hash meshed with the given parameters
+    std::string getKey(const std::string &shapeHash, double deflection,
+            double angularDeflection, bool normalsFromUV) const;
+
+    /// Read a cached triangulation, return false if there is none
+    bool load(const std::string &key, ShapeTessellation &res) const;
+    /// Store a triangulation in the cache
+    void save(const std::string &key, const ShapeTessellation &res);
+
+private:
+    TessellationCache();
+    std::string getFileName(const std::string &key) const;
+    void prune();
+
+private:
+    std::string path;
+    long long usedSize;
+};
+
+} //namespace PartGui
+
+#endif // PARTGUI_TESSELLATIONCACHE_H
@@ -24,13 +24,17 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <functional>
+# include <memory>
 # include <sstream>
 # include <Bnd_Box.hxx>
 # include <Poly_Polygon3D.hxx>
 # include <BRepBndLib.hxx>
+# include <BRepBuilderAPI_Copy.hxx>
 # include <BRepBuilderAPI_MakeVertex.hxx>
 # include <BRepExtrema_DistShapeShape.hxx>
 # include <BRepMesh_IncrementalMesh.hxx>
+# include <BRep_Builder.hxx>
 # include <BRep_Tool.hxx>
 # include <BRepTools.hxx>
 # include <BRepAdaptor_Curve.hxx>
@@ -95,6 +99,8 @@
 # include <Inventor/nodes/SoLightModel.h>
 # include <QAction>
 # include <QMenu>
+# include <QFutureWatcher>
+# include <QtConcurrentRun>
 #endif
 
 #include <boost/algorithm/string/predicate.hpp>
@@ -124,7 +130,9 @@
 #include "SoBrepPointSet.h"
 #include "SoBrepEdgeSet.h"
 #include "SoBrepFaceSet.h"
+#include "SoFCShapeObject.h"
 #include "TaskFaceColors.h"
+#include "TessellationCache.h"
 
 #include <Mod/Part/App/PartFeature.h>
 #include <Mod/Part/App/PrimitiveFeature.h>
@@ -239,6 +247,7 @@ ViewProviderPartExt::ViewProviderPartExt()
 {
     UpdatingColor = false;
     VisualTouched = true;
+    tessellationJob = nullptr;
     forceUpdateCount = 0;
     NormalsFromUV = true;
 
@@ -307,6 +316,16 @@ ViewProviderPartExt::ViewProviderPartExt()
     nodeset = new SoBrepPointSet();
     nodeset->ref();
 
+    coarseCoords = new SoCoordinate3();
+    coarseCoords->ref();
+    coarseNorm = new SoNormal;
+    coarseNorm->ref();
+    coarseFaceset = new SoBrepFaceSet();
+    coarseFaceset->ref();
+    pcFaceLOD = new SoFCShapeLevelOfDetail();
+    pcFaceLOD->ref();
+    pcFaceLOD->setDetailFaceSet(faceset);
+
     pcFaceBind = new SoMaterialBinding();
     pcFaceBind->ref();
 
@@ -358,6 +377,11 @@ ViewProviderPartExt::~ViewProviderPartExt()
     normb->unref();
     lineset->unref();
     nodeset->unref();
+    coarseCoords->unref();
+    coarseNorm->unref();
+    coarseFaceset->unref();
+    pcFaceLOD->unref();
+    cancelTessellation();
 }
 
 void ViewProviderPartExt::onChanged(const App::Property* prop)
@@ -579,9 +603,20 @@ void ViewProviderPartExt::attach(App::DocumentObject *pcFeat)
     SoDrawStyle* pcFaceStyle = new SoDrawStyle();
     pcFaceStyle->style = SoDrawStyle::FILLED;
     pcFlatRoot->addChild(pcFaceStyle);
-    pcFlatRoot->addChild(norm);
-    pcFlatRoot->addChild(normb);
-    pcFlatRoot->addChild(faceset);
+    pcFlatRoot->addChild(pcFaceLOD);
+
+    // faces in full detail, and a coarse level for when they are small on screen
+    auto* pcDetailFaces = new SoGroup();
+    pcDetailFaces->addChild(norm);
+    pcDetailFaces->addChild(normb);
+    pcDetailFaces->addChild(faceset);
+    pcFaceLOD->addChild(pcDetailFaces);
+    auto* pcCoarseFaces = new SoGroup();
+    pcCoarseFaces->addChild(coarseCoords);
+    pcCoarseFaces->addChild(coarseNorm);
+    pcCoarseFaces->addChild(normb);
+    pcCoarseFaces->addChild(coarseFaceset);
+    pcFaceLOD->addChild(pcCoarseFaces);
 
     // edges and points
     pcWireframeRoot->addChild(wireframe);
@@ -1472,56 +1507,115 @@ void ViewProviderPartExt::unsetEdit(int ModNum)
     }
 }
 
-void ViewProviderPartExt::updateVisual()
+// Meshing stores the triangulation in the faces of the shape. A background
+// saving of any document may be writing the same faces, because the save
+// snapshot shares the shape, so wait for it before meshing in place.
+static void waitForBackgroundSave()
 {
-    Gui::SoUpdateVBOAction action;
-    action.apply(this->faceset);
-
-    // Clear selection
-    Gui::SoSelectionElementAction saction(Gui::SoSelectionElementAction::None);
-    saction.apply(this->faceset);
-    saction.apply(this->lineset);
-    saction.apply(this->nodeset);
+    for (auto doc : App::GetApplication().getDocuments()) {
+        if (doc->isSavingInBackground())
+            doc->waitForBackgroundSave();
+    }
+}
 
-    // Clear highlighting
-    Gui::SoHighlightElementAction haction;
-    haction.apply(this->faceset);
-    haction.apply(this->lineset);
-    haction.apply(this->nodeset);
+void ViewProviderPartExt::updateVisual()
+{
+    cancelTessellation();
+    VisualTouched = false;
 
+    ShapeTessellation res;
     TopoDS_Shape cShape = Part::Feature::getShape(getObject());
     if (cShape.IsNull()) {
-        coords  ->point      .setNum(0);
-        norm    ->vector     .setNum(0);
-        faceset ->coordIndex .setNum(0);
-        faceset ->partIndex  .setNum(0);
-        lineset ->coordIndex .setNum(0);
-        nodeset ->startIndex .setValue(0);
-        VisualTouched = false;
+        applyTessellation(res);
+        applyCoarseTessellation(res);
         return;
     }
 
     // time measurement and book keeping
     Base::TimeInfo start_time;
-    int numTriangles=0,numNodes=0,numNorms=0,numFaces=0,numEdges=0,numLines=0;
-    std::set<int> faceEdges;
 
+    Bnd_Box bounds;
+    Standard_Real deflection;
     try {
         // calculating the deflection value
-        Bnd_Box bounds;
         BRepBndLib::Add(cShape, bounds);
         bounds.SetGap(0.0);
         Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
         bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
-        Standard_Real deflection = ((xMax-xMin)+(yMax-yMin)+(zMax-zMin))/300.0 *
+        deflection = ((xMax-xMin)+(yMax-yMin)+(zMax-zMin))/300.0 *
             Deviation.getValue();
+    }
+    catch (...) {
+        FC_ERR("Cannot compute Inventor representation for the shape of " << pcObject->getFullName());
+        return;
+    }
+    Standard_Real AngDeflectionRads = AngularDeflection.getValue() / 180.0 * M_PI;
 
+    ParameterGrp::handle hPart = App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Part");
+    bool parallel = hPart->GetBool("ParallelTessellation", true);
+    bool meshed = BRepTools::Triangulation(cShape, deflection);
+
+    // Deflection of the coarse level shown if the shape is small on screen
+    double coarseDeflection = 0.0;
+    if (hPart->GetBool("LevelOfDetail", true))
+        coarseDeflection = deflection * std::max(1.0, hPart->GetFloat("LODDeviationFactor", 8.0));
+
+    // Try the persistent cache before meshing the shape
+    std::string shapeHash, cacheKey;
+    auto &cache = TessellationCache::instance();
+    if (!meshed && cache.isEnabled()) {
+        shapeHash = cache.getShapeHash(cShape);
+        cacheKey = cache.getKey(shapeHash, deflection, AngDeflectionRads, NormalsFromUV);
+        if (cache.load(cacheKey, res)) {
+            applyTessellation(res);
+            updateCoarseLevel(cShape, shapeHash, res, coarseDeflection, AngDeflectionRads, parallel);
+            return;
+        }
+    }
+
+    // Shapes with many faces that are not yet meshed with the requested
+    // deflection are meshed in a worker thread. The current representation
+    // is kept until the result is ready.
+    if (!meshed && hPart->GetBool("AsyncTessellation", true)
+            && hasManyFaces(cShape, hPart->GetInt("AsyncTessellationMinFaces", 50)))
+    {
+        startTessellation(cShape, shapeHash, deflection, coarseDeflection,
+                          AngDeflectionRads, parallel, bounds);
+        return;
+    }
+
+    waitForBackgroundSave();
+    if (!tessellate(cShape, deflection, AngDeflectionRads, NormalsFromUV, parallel, res)) {
+        FC_ERR("Cannot compute Inventor representation for the shape of " << pcObject->getFullName());
+        return;
+    }
+    applyTessellation(res);
+    cache.save(cacheKey, res);
+    updateCoarseLevel(cShape, shapeHash, res, coarseDeflection, AngDeflectionRads, parallel);
+
+#   ifdef FC_DEBUG
+        // printing some information
+        Base::Console().Log("ViewProvider update time: %f s\n",Base::TimeInfo::diffTimeF(start_time,Base::TimeInfo()));
+        Base::Console().Log("Shape tria info: Faces:%d Nodes:%d Triangles:%d IdxVec:%d\n",
+                (int)res.partIndex.size(),(int)res.verts.size(),(int)res.faceIndex.size()/4,(int)res.lineIndex.size());
+#   endif
+}
+
+bool ViewProviderPartExt::tessellate(TopoDS_Shape cShape, double deflection, double AngDeflectionRads,
+                                     bool normalsFromUV, bool parallel, ShapeTessellation &res)
+{
+    int numTriangles=0,numNodes=0,numNorms=0,numFaces=0;
+    std::set<int> faceEdges;
+
+    try {
         // create or use the mesh on the data structure
 #if OCC_VERSION_HEX >= 0x060600
-        Standard_Real AngDeflectionRads = AngularDeflection.getValue() / 180.0 * M_PI;
         BRepMesh_IncrementalMesh(cShape,deflection,Standard_False,
-                AngDeflectionRads,Standard_True);
+                AngDeflectionRads,parallel?Standard_True:Standard_False);
 #else
+        (void)AngDeflectionRads;
+        (void)parallel;
         BRepMesh_IncrementalMesh(cShape,deflection);
 #endif
         // We must reset the location here because the transformation data
@@ -1559,7 +1653,6 @@ void ViewProviderPartExt::updateVisual()
         // count and index the edges
         for (int i=1; i <= edgeMap.Extent(); i++) {
             edgeIdxSet.insert(i);
-            numEdges++;
 
             const TopoDS_Edge& aEdge = TopoDS::Edge(edgeMap(i));
             TopLoc_Location aLoc;
@@ -1586,20 +1679,17 @@ void ViewProviderPartExt::updateVisual()
         TopExp::MapShapes(cShape, TopAbs_VERTEX, vertexMap);
         numNodes += vertexMap.Extent();
 
-        // create memory for the nodes and indexes
-        coords  ->point      .setNum(numNodes);
-        norm    ->vector     .setNum(numNorms);
-        faceset ->coordIndex .setNum(numTriangles*4);
-        faceset ->partIndex  .setNum(numFaces);
+        // create memory for the nodes and indexes, and preset the normal
+        // vector with null vector
+        res.verts.resize(numNodes);
+        res.norms.assign(numNorms, SbVec3f(0.0,0.0,0.0));
+        res.faceIndex.resize(numTriangles*4);
+        res.partIndex.resize(numFaces);
         // get the raw memory for fast fill up
-        SbVec3f* verts = coords  ->point       .startEditing();
-        SbVec3f* norms = norm    ->vector      .startEditing();
-        int32_t* index = faceset ->coordIndex  .startEditing();
-        int32_t* parts = faceset ->partIndex   .startEditing();
-
-        // preset the normal vector with null vector
-        for (int i=0;i < numNorms;i++)
-            norms[i]= SbVec3f(0.0,0.0,0.0);
+        SbVec3f* verts = res.verts.data();
+        SbVec3f* norms = res.norms.data();
+        int32_t* index = res.faceIndex.data();
+        int32_t* parts = res.partIndex.data();
 
         int ii = 0,faceNodeOffset=0,faceTriaOffset=0;
         for (int i=1; i <= faceMap.Extent(); i++, ii++) {
@@ -1628,7 +1718,7 @@ void ViewProviderPartExt::updateVisual()
             const Poly_Array1OfTriangle& Triangles = mesh->Triangles();
             const TColgp_Array1OfPnt& Nodes = mesh->Nodes();
             TColgp_Array1OfDir Normals (Nodes.Lower(), Nodes.Upper());
-            if (NormalsFromUV)
+            if (normalsFromUV)
                 getNormals(actFace, mesh, Normals);
             
             for (int g=1;g<=nbTriInFace;g++) {
@@ -1648,7 +1738,7 @@ void ViewProviderPartExt::updateVisual()
 
                 // get the 3 normals of this triangle
                 gp_Vec NV1, NV2, NV3;
-                if (NormalsFromUV) {
+                if (normalsFromUV) {
                     NV1.SetXYZ(Normals(N1).XYZ());
                     NV2.SetXYZ(Normals(N2).XYZ());
                     NV3.SetXYZ(Normals(N3).XYZ());
@@ -1668,7 +1758,7 @@ void ViewProviderPartExt::updateVisual()
                     V1.Transform(myTransf);
                     V2.Transform(myTransf);
                     V3.Transform(myTransf);
-                    if (NormalsFromUV) {
+                    if (normalsFromUV) {
                         NV1.Transform(myTransf);
                         NV2.Transform(myTransf);
                         NV3.Transform(myTransf);
@@ -1774,7 +1864,7 @@ void ViewProviderPartExt::updateVisual()
             }
         }
 
-        nodeset->startIndex.setValue(faceNodeOffset);
+        res.nodeStart = faceNodeOffset;
         for (int i=0; i<vertexMap.Extent(); i++) {
             const TopoDS_Vertex& aVertex = TopoDS::Vertex(vertexMap(i+1));
             gp_Pnt pnt = BRep_Tool::Pnt(aVertex);
@@ -1785,38 +1875,311 @@ void ViewProviderPartExt::updateVisual()
         for (int i = 0; i< numNorms ;i++)
             norms[i].normalize();
         
-        std::vector<int32_t> lineSetCoords;
         for (std::map<int, std::vector<int32_t> >::iterator it = lineSetMap.begin(); it != lineSetMap.end(); ++it) {
-            lineSetCoords.insert(lineSetCoords.end(), it->second.begin(), it->second.end());
-            lineSetCoords.push_back(-1);
+            res.lineIndex.insert(res.lineIndex.end(), it->second.begin(), it->second.end());
+            res.lineIndex.push_back(-1);
         }
+    }
+    catch (...) {
+        return false;
+    }
+    return true;
+}
 
-        // preset the index vector size
-        numLines =  lineSetCoords.size();
-        lineset ->coordIndex .setNum(numLines);
-        int32_t* lines = lineset ->coordIndex  .startEditing();
+static void setFaceNodes(SoCoordinate3 *coords, SoNormal *norm, SoBrepFaceSet *faceset,
+                         const ShapeTessellation &res)
+{
+    coords  ->point      .setNum((int)res.verts.size());
+    norm    ->vector     .setNum((int)res.norms.size());
+    faceset ->coordIndex .setNum((int)res.faceIndex.size());
+    faceset ->partIndex  .setNum((int)res.partIndex.size());
+    if (!res.verts.empty())
+        coords->point.setValues(0, (int)res.verts.size(), res.verts.data());
+    if (!res.norms.empty())
+        norm->vector.setValues(0, (int)res.norms.size(), res.norms.data());
+    if (!res.faceIndex.empty())
+        faceset->coordIndex.setValues(0, (int)res.faceIndex.size(), res.faceIndex.data());
+    if (!res.partIndex.empty())
+        faceset->partIndex.setValues(0, (int)res.partIndex.size(), res.partIndex.data());
+}
 
-        int l=0;
-        for (std::vector<int32_t>::const_iterator it=lineSetCoords.begin();it!=lineSetCoords.end();++it,l++)
-            lines[l] = *it;
+void ViewProviderPartExt::applyTessellation(const ShapeTessellation &res)
+{
+    Gui::SoUpdateVBOAction action;
+    action.apply(this->faceset);
+
+    // Clear selection
+    Gui::SoSelectionElementAction saction(Gui::SoSelectionElementAction::None);
+    saction.apply(this->faceset);
+    saction.apply(this->lineset);
+    saction.apply(this->nodeset);
 
-        // end the editing of the nodes
-        coords  ->point       .finishEditing();
-        norm    ->vector      .finishEditing();
-        faceset ->coordIndex  .finishEditing();
-        faceset ->partIndex   .finishEditing();
-        lineset ->coordIndex  .finishEditing();
+    // Clear highlighting
+    Gui::SoHighlightElementAction haction;
+    haction.apply(this->faceset);
+    haction.apply(this->lineset);
+    haction.apply(this->nodeset);
+
+    setFaceNodes(coords, norm, faceset, res);
+    lineset ->coordIndex .setNum((int)res.lineIndex.size());
+    if (!res.lineIndex.empty())
+        lineset->coordIndex.setValues(0, (int)res.lineIndex.size(), res.lineIndex.data());
+    nodeset ->startIndex .setValue(res.nodeStart);
+}
+
+void ViewProviderPartExt::applyCoarseTessellation(const ShapeTessellation &res)
+{
+    Gui::SoUpdateVBOAction action;
+    action.apply(this->coarseFaceset);
+
+    setFaceNodes(coarseCoords, coarseNorm, coarseFaceset, res);
+
+    SbBox3f bbox;
+    for (auto &v : res.verts)
+        bbox.extendBy(v);
+    pcFaceLOD->bbox.setValue(bbox);
+    if (res.faceIndex.empty()) {
+        pcFaceLOD->screenArea.setValue(0.0f);
+    }
+    else {
+        ParameterGrp::handle hPart = App::GetApplication().GetParameterGroupByPath
+            ("User parameter:BaseApp/Preferences/Mod/Part");
+        pcFaceLOD->screenArea.setValue((float)hPart->GetFloat("LODScreenArea", 10000.0));
+    }
+}
+
+void ViewProviderPartExt::refreshElementColors()
+{
+    // The element colors are applied according to the number of parts
+    setHighlightedFaces(DiffuseColor.getValues());
+    setHighlightedEdges(LineColorArray.getValues());
+    setHighlightedPoints(PointColorArray.getValues());
+    if (this->faceset->partIndex.getNum() >
+        this->pcShapeMaterial->diffuseColor.getNum()) {
+        this->pcFaceBind->value = SoMaterialBinding::OVERALL;
+    }
+}
+
+bool ViewProviderPartExt::hasManyFaces(const TopoDS_Shape &shape, int limit)
+{
+    int count = 0;
+    for (TopExp_Explorer xp(shape, TopAbs_FACE); xp.More(); xp.Next()) {
+        if (++count >= limit)
+            return true;
+    }
+    return false;
+}
+
+class ViewProviderPartExt::TessellationJob : public QFutureWatcher<bool>
+{
+};
+
+// BRepMesh stores the triangulation in the shape. Mesh a copy in the worker
+// thread, so that it does not race with other users of the shape in the GUI
+// thread. The copy has the same topology, so the element indices stay valid.
+static TopoDS_Shape copyForMeshing(const TopoDS_Shape &shape)
+{
+    try {
+        BRepBuilderAPI_Copy copier(shape);
+        return copier.Shape();
     }
     catch (...) {
+        return TopoDS_Shape();
+    }
+}
+
+// Assign the triangulation of a shape meshed by copyForMeshing() to the
+// original shape. The next update then finds the shape already meshed, and
+// other users of the shape, e.g. picking, measurement and export, get the
+// triangulation too. Both shapes have the same topology, so their faces and
+// edges are explored in the same order.
+static void transferTriangulation(const TopoDS_Shape &from, const TopoDS_Shape &to)
+{
+    TopTools_IndexedMapOfShape fromFaces, toFaces;
+    TopExp::MapShapes(from, TopAbs_FACE, fromFaces);
+    TopExp::MapShapes(to, TopAbs_FACE, toFaces);
+    if (fromFaces.Extent() != toFaces.Extent())
+        return;
+
+    BRep_Builder builder;
+    for (int i=1; i <= fromFaces.Extent(); i++) {
+        const TopoDS_Face &fromFace = TopoDS::Face(fromFaces(i));
+        const TopoDS_Face &toFace = TopoDS::Face(toFaces(i));
+        TopLoc_Location loc;
+        Handle(Poly_Triangulation) mesh = BRep_Tool::Triangulation(fromFace, loc);
+        if (mesh.IsNull())
+            continue;
+        builder.UpdateFace(toFace, mesh);
+
+        // The edges keep their discretization as polygons on the triangulation.
+        // Seam edges have one for each side.
+        TopExp_Explorer xpFrom(fromFace, TopAbs_EDGE), xpTo(toFace, TopAbs_EDGE);
+        for (; xpFrom.More() && xpTo.More(); xpFrom.Next(), xpTo.Next()) {
+            const TopoDS_Edge &fromEdge = TopoDS::Edge(xpFrom.Current());
+            const TopoDS_Edge &toEdge = TopoDS::Edge(xpTo.Current());
+            if (BRep_Tool::IsClosed(fromEdge, fromFace)) {
+                Handle(Poly_PolygonOnTriangulation) forward = BRep_Tool::PolygonOnTriangulation(
+                        TopoDS::Edge(fromEdge.Oriented(TopAbs_FORWARD)), mesh, loc);
+                Handle(Poly_PolygonOnTriangulation) reversed = BRep_Tool::PolygonOnTriangulation(
+                        TopoDS::Edge(fromEdge.Oriented(TopAbs_REVERSED)), mesh, loc);
+                if (!forward.IsNull() && !reversed.IsNull())
+                    builder.UpdateEdge(toEdge, forward, reversed, mesh, loc);
+            }
+            else {
+                Handle(Poly_PolygonOnTriangulation) poly =
+                    BRep_Tool::PolygonOnTriangulation(fromEdge, mesh, loc);
+                if (!poly.IsNull())
+                    builder.UpdateEdge(toEdge, poly, mesh, loc);
+            }
+        }
+    }
+}
+
+void ViewProviderPartExt::runTessellation(const TopoDS_Shape &shape, double deflection,
+        double AngDeflectionRads, bool parallel,
+        const std::function<void(const ShapeTessellation &)> &done)
+{
+    // The worker owns everything it works on, so that a job superseded by a
+    // newer one or by the deletion of this view provider can safely run to
+    // its end. Its result is then simply discarded.
+    auto res = std::make_shared<ShapeTessellation>();
+    bool normalsFromUV = NormalsFromUV;
+    TessellationJob *job = new TessellationJob;
+    tessellationJob = job;
+    QObject::connect(job, &QFutureWatcherBase::finished, [this, job, res, done]() {
+        job->deleteLater();
+        if (tessellationJob != job)
+            return;
+        tessellationJob = nullptr;
+        if (!job->result()) {
+            FC_ERR("Cannot compute Inventor representation for the shape of " << pcObject->getFullName());
+            return;
+        }
+        done(*res);
+    });
+    job->setFuture(QtConcurrent::run([shape, deflection, AngDeflectionRads, normalsFromUV, parallel, res]() {
+        return tessellate(shape, deflection, AngDeflectionRads, normalsFromUV, parallel, *res);
+    }));
+}
+
+void ViewProviderPartExt::startTessellation(const TopoDS_Shape &shape, const std::string &shapeHash,
+                                            double deflection, double coarseDeflection,
+                                            double AngDeflectionRads, bool parallel,
+                                            const Bnd_Box &bounds)
+{
+    if (!coords->point.getNum() && !bounds.IsVoid()) {
+        // Nothing shown yet, use the bounding box as placeholder
+        ShapeTessellation box;
+        Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+        bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+        for (int i=0; i<8; i++) {
+            box.verts.push_back(SbVec3f((float)(i&1?xMax:xMin),
+                                        (float)(i&2?yMax:yMin),
+                                        (float)(i&4?zMax:zMin)));
+        }
+        for (int i=0; i<8; i++) {
+            for (int bit=1; bit<8; bit<<=1) {
+                if (!(i&bit)) {
+                    box.lineIndex.push_back(i);
+                    box.lineIndex.push_back(i|bit);
+                    box.lineIndex.push_back(-1);
+                }
+            }
+        }
+        box.nodeStart = 8;
+        applyTessellation(box);
+    }
+
+    TopoDS_Shape copy = copyForMeshing(shape);
+    if (copy.IsNull()) {
         FC_ERR("Cannot compute Inventor representation for the shape of " << pcObject->getFullName());
+        return;
     }
 
-#   ifdef FC_DEBUG
-        // printing some information
-        Base::Console().Log("ViewProvider update time: %f s\n",Base::TimeInfo::diffTimeF(start_time,Base::TimeInfo()));
-        Base::Console().Log("Shape tria info: Faces:%d Edges:%d Nodes:%d Triangles:%d IdxVec:%d\n",numFaces,numEdges,numNodes,numTriangles,numLines);
-#   endif
-    VisualTouched = false;
+    auto &cache = TessellationCache::instance();
+    std::string cacheKey = cache.getKey(shapeHash, deflection, AngDeflectionRads, NormalsFromUV);
+    auto finish = [this, cacheKey, shape, copy](const ShapeTessellation &res) {
+        waitForBackgroundSave();
+        transferTriangulation(copy, shape);
+        applyTessellation(res);
+        TessellationCache::instance().save(cacheKey, res);
+        if ((int)res.faceIndex.size()/4 < getLODMinTriangles())
+            applyCoarseTessellation(ShapeTessellation());
+        refreshElementColors();
+    };
+
+    ShapeTessellation coarse;
+    std::string coarseKey;
+    if (coarseDeflection > 0.0) {
+        coarseKey = cache.getKey(shapeHash, coarseDeflection, AngDeflectionRads, NormalsFromUV);
+        if (cache.load(coarseKey, coarse)) {
+            applyCoarseTessellation(coarse);
+        }
+        else {
+            // Mesh the coarse level first, and show it in place of the
+            // full detail until that one is ready. Meshing the same shape
+            // again with a smaller deflection refines the triangulation.
+            runTessellation(copy, coarseDeflection, AngDeflectionRads, parallel,
+                [=](const ShapeTessellation &res) {
+                    applyCoarseTessellation(res);
+                    TessellationCache::instance().save(coarseKey, res);
+                    applyTessellation(res);
+                    refreshElementColors();
+                    runTessellation(copy, deflection, AngDeflectionRads, parallel, finish);
+                });
+            return;
+        }
+    }
+    runTessellation(copy, deflection, AngDeflectionRads, parallel, finish);
+}
+
+void ViewProviderPartExt::updateCoarseLevel(const TopoDS_Shape &shape, std::string shapeHash,
+                                            const ShapeTessellation &detail, double coarseDeflection,
+                                            double AngDeflectionRads, bool parallel)
+{
+    // The coarse level is only worth its memory for finely meshed shapes.
+    // It is generated lazily, the full detail is shown until it is ready.
+    ShapeTessellation res;
+    applyCoarseTessellation(res);
+    if (coarseDeflection <= 0.0 || (int)detail.faceIndex.size()/4 < getLODMinTriangles())
+        return;
+
+    std::string cacheKey;
+    auto &cache = TessellationCache::instance();
+    if (cache.isEnabled()) {
+        if (shapeHash.empty())
+            shapeHash = cache.getShapeHash(shape);
+        cacheKey = cache.getKey(shapeHash, coarseDeflection, AngDeflectionRads, NormalsFromUV);
+        if (cache.load(cacheKey, res)) {
+            applyCoarseTessellation(res);
+            return;
+        }
+    }
+
+    TopoDS_Shape copy = copyForMeshing(shape);
+    if (copy.IsNull())
+        return;
+    runTessellation(copy, coarseDeflection, AngDeflectionRads, parallel,
+        [this, cacheKey](const ShapeTessellation &res) {
+            applyCoarseTessellation(res);
+            TessellationCache::instance().save(cacheKey, res);
+        });
+}
+
+int ViewProviderPartExt::getLODMinTriangles()
+{
+    return App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Part")->GetInt("LODMinTriangles", 2000);
+}
+
+void ViewProviderPartExt::cancelTessellation()
+{
+    // A running BRepMesh cannot be interrupted, just forget about its result
+    if (tessellationJob) {
+        tessellationJob->disconnect();
+        delete tessellationJob;
+        tessellationJob = nullptr;
+    }
 }
 
 void ViewProviderPartExt::forceUpdate(bool enable) {
@@ -32,6 +32,7 @@
 #include <TColgp_Array1OfDir.hxx>
 #include <App/PropertyUnits.h>
 #include <Gui/ViewProviderGeometryObject.h>
+#include <functional>
 #include <map>
 #include <Mod/Part/App/PartFeature.h>
 
@@ -55,12 +56,15 @@ class SoNormal;
 class SoNormalBinding;
 class SoMaterialBinding;
 class SoIndexedLineSet;
+class Bnd_Box;
 
 namespace PartGui {
 
 class SoBrepFaceSet;
 class SoBrepEdgeSet;
 class SoBrepPointSet;
+class SoFCShapeLevelOfDetail;
+struct ShapeTessellation;
 
 class PartGuiExport ViewProviderPartExt : public Gui::ViewProviderGeometryObject
 {
@@ -173,8 +177,15 @@ protected:
     virtual void onChanged(const App::Property* prop);
     bool loadParameter();
     void updateVisual();
-    void getNormals(const TopoDS_Face&  theFace, const Handle(Poly_Triangulation)& aPolyTri,
-                    TColgp_Array1OfDir& theNormals);
+    static void getNormals(const TopoDS_Face&  theFace, const Handle(Poly_Triangulation)& aPolyTri,
+                           TColgp_Array1OfDir& theNormals);
+    /// Triangulate the shape, thread safe as long as nobody else accesses the shape
+    static bool tessellate(TopoDS_Shape shape, double deflection, double angularDeflection,
+                           bool normalsFromUV, bool parallel, ShapeTessellation &res);
+    /// Replace the content of the Inventor nodes with the triangulation
+    void applyTessellation(const ShapeTessellation &res);
+    /// Replace the coarse level of the faces, an empty triangulation disables it
+    void applyCoarseTessellation(const ShapeTessellation &res);
 
     virtual bool hasBaseFeature() const;
 
@@ -201,6 +212,29 @@ protected:
 
 
 private:
+    static bool hasManyFaces(const TopoDS_Shape &shape, int limit);
+    static int getLODMinTriangles();
+    void runTessellation(const TopoDS_Shape &shape, double deflection, double angularDeflection,
+                         bool parallel, const std::function<void(const ShapeTessellation &)> &done);
+    void startTessellation(const TopoDS_Shape &shape, const std::string &shapeHash,
+                           double deflection, double coarseDeflection, double angularDeflection,
+                           bool parallel, const Bnd_Box &bounds);
+    void updateCoarseLevel(const TopoDS_Shape &shape, std::string shapeHash,
+                           const ShapeTessellation &detail, double coarseDeflection,
+                           double angularDeflection, bool parallel);
+    void cancelTessellation();
+    void refreshElementColors();
+
+private:
+    class TessellationJob;
+    TessellationJob *tessellationJob;
+
+    // coarse level of the faces
+    SoFCShapeLevelOfDetail * pcFaceLOD;
+    SoCoordinate3     * coarseCoords;
+    SoNormal          * coarseNorm;
+    SoBrepFaceSet     * coarseFaceset;
+
     // settings stuff
     int forceUpdateCount;
     static App::PropertyFloatConstraint::Constraints sizeRange;
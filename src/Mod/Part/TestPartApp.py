@@ -52,6 +52,86 @@ class PartTestCases(unittest.TestCase):
         #self.Doc.addObject("Part::Feature","Face").Shape = result
         #self.assertTrue(isinstance(result.Surface, Part.BSplineSurface))
 
+    def testLazyRestore(self):
+        box = self.Doc.addObject("Part::Box","Box")
+        self.Doc.recompute()
+        volume = box.Shape.Volume
+        tempPath = FreeCAD.ConfigGet("AppTempPath")
+        fileName = os.path.join(tempPath, "PartLazyRestore.FCStd")
+        copyName = os.path.join(tempPath, "PartLazyRestoreCopy.FCStd")
+        self.Doc.saveAs(fileName)
+        FreeCAD.closeDocument(self.Doc.Name)
+        param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+        lazy = param.GetBool("LazyRestore", False)
+        param.SetBool("LazyRestore", True)
+        try:
+            doc = FreeCAD.openDocument(fileName)
+            # save a copy without touching the shape, then overwrite the original
+            doc.saveCopy(copyName)
+            doc.save()
+            self.assertAlmostEqual(doc.Box.Shape.Volume, volume)
+            FreeCAD.closeDocument(doc.Name)
+            doc = FreeCAD.openDocument(copyName)
+            self.assertAlmostEqual(doc.Box.Shape.Volume, volume)
+            FreeCAD.closeDocument(doc.Name)
+        finally:
+            param.SetBool("LazyRestore", lazy)
+        self.Doc = FreeCAD.newDocument("PartTest")
+
+    def testElementMapCopyOnWrite(self):
+        box = self.Doc.addObject("Part::Box","Box")
+        self.Doc.recompute()
+        count = box.Shape.ElementMapSize
+        # the returned shape shares the element map with the property
+        shape = box.Shape
+        shape.setElementName("Face1", "CopyOnWrite")
+        self.assertEqual(shape.getElementName(";CopyOnWrite"), "Face1")
+        self.assertEqual(shape.ElementMapSize, count+1)
+        self.assertEqual(box.Shape.getElementName(";CopyOnWrite"), ";CopyOnWrite")
+        self.assertEqual(box.Shape.ElementMapSize, count)
+
+    def testUndoSharesShape(self):
+        self.Doc.UndoMode = 1
+        feature = self.Doc.addObject("Part::Feature","Shape")
+        shape = Part.makeBox(1, 1, 1)
+        feature.Shape = shape
+        self.Doc.openTransaction("Change")
+        feature.Shape = Part.makeSphere(1)
+        self.Doc.commitTransaction()
+        self.Doc.undo()
+        # the undo record shares the shape instead of copying it
+        self.assertTrue(feature.Shape.isSame(shape))
+        self.assertAlmostEqual(feature.Shape.Volume, 1)
+
+    def testParallelRecompute(self):
+        param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+        parallel = param.GetBool("ParallelRecompute", False)
+        param.SetBool("ParallelRecompute", True)
+        try:
+            boxes = []
+            for i in range(10):
+                box = self.Doc.addObject("Part::Box","Box")
+                box.Placement = FreeCAD.Placement(App.Vector(i*20, 0, 0), FreeCAD.Rotation())
+                boxes.append(box)
+            # attached primitives are recomputed in the main thread
+            cylinder = self.Doc.addObject("Part::Cylinder","Cylinder")
+            cylinder.Support = [(boxes[0], "Face6")]
+            cylinder.MapMode = "FlatFace"
+            fuse = self.Doc.addObject("Part::MultiFuse","Fuse")
+            fuse.Shapes = boxes
+            self.Doc.recompute()
+            for box in boxes + [cylinder, fuse]:
+                self.assertTrue(box.isValid())
+            self.assertAlmostEqual(fuse.Shape.Volume, 10000)
+            self.assertAlmostEqual(cylinder.Placement.Base.z, 10)
+
+            for box in boxes:
+                box.Length = 5
+            self.Doc.recompute()
+            self.assertAlmostEqual(fuse.Shape.Volume, 5000)
+        finally:
+            param.SetBool("ParallelRecompute", parallel)
+
     def tearDown(self):
         #closing doc
         FreeCAD.closeDocument("PartTest")
@@ -151,3 +231,95 @@ class PartTestBSplineCurve(unittest.TestCase):
     def tearDown(self):
         #closing doc
         FreeCAD.closeDocument("PartTest")
+
+class PartTestBooleanOptions(unittest.TestCase):
+    # Each boolean is done with the default options and with the options
+    # that are expected to speed it up, which must give the same result.
+
+    def runBoolean(self, func, options):
+        results = [func(), func(**options)]
+        self.assertTrue(results[1].isValid())
+        self.assertAlmostEqual(results[0].Volume, results[1].Volume, 6)
+        self.assertEqual(len(results[0].Solids), len(results[1].Solids))
+        return results[1]
+
+    def testCutHoles(self):
+        # Plate with a grid of holes, and tools far away from the plate
+        plate = Part.makeBox(110, 110, 5)
+        tools = []
+        for i in range(10):
+            for j in range(10):
+                tools.append(Part.makeCylinder(3, 7, App.Vector(10+i*10, 10+j*10, -1)))
+                tools.append(Part.makeCylinder(3, 7, App.Vector(10+i*10, 10+j*10, 100)))
+        res = self.runBoolean(lambda **kw: plate.cut(tools, **kw),
+                              {'prefilter':True, 'useOBB':True})
+        self.assertEqual(len(res.Faces), 106)
+
+    def testCutNothing(self):
+        box = Part.makeBox(10, 10, 10)
+        tools = [Part.makeSphere(1, App.Vector(20+i*3, 0, 0)) for i in range(20)]
+        res = box.cut(tools, prefilter=True)
+        self.assertTrue(res.isEqual(box))
+
+    def testFuseTouching(self):
+        # Row of boxes sharing whole faces, and boxes not touching any other shape
+        boxes = [Part.makeBox(1, 1, 1, App.Vector(i, 0, 0)) for i in range(30)]
+        boxes += [Part.makeBox(1, 1, 1, App.Vector(i*2, 5, 0)) for i in range(10)]
+        res = self.runBoolean(lambda **kw: boxes[0].fuse(boxes[1:], **kw),
+                              {'glue':1, 'prefilter':True})
+        self.assertAlmostEqual(res.Volume, 40)
+        self.assertEqual(len(res.Solids), 11)
+
+    def testCommonRotated(self):
+        # Rotated shapes, for which oriented bound boxes are much tighter
+        box = Part.makeBox(100, 1, 1)
+        box.rotate(App.Vector(), App.Vector(0,0,1), 45)
+        tools = []
+        for i in range(20):
+            tool = Part.makeBox(100, 1, 1, App.Vector(0, 2+i*2, 0))
+            tool.rotate(App.Vector(), App.Vector(0,0,1), 45)
+            tools.append(tool)
+        tools.append(Part.makeSphere(5, App.Vector(30, 30, 0)))
+        self.runBoolean(lambda **kw: box.common(tools, **kw),
+                        {'useOBB':True, 'prefilter':True})
+
+    def testInvalidGlue(self):
+        box = Part.makeBox(1, 1, 1)
+        with self.assertRaises(Exception):
+            box.fuse(Part.makeBox(1, 1, 1, App.Vector(1, 0, 0)), glue=3)
+
+    def testFeatureOptions(self):
+        doc = FreeCAD.newDocument("PartBooleanOptions")
+        try:
+            boxes = []
+            for i in range(4):
+                box = doc.addObject("Part::Feature", "Box")
+                box.Shape = Part.makeBox(1, 1, 1, App.Vector(i, 0, 0))
+                boxes.append(box)
+            far = doc.addObject("Part::Feature", "Far")
+            far.Shape = Part.makeBox(1, 1, 1, App.Vector(0, 5, 0))
+            fuse = doc.addObject("Part::MultiFuse", "Fuse")
+            fuse.Shapes = boxes + [far]
+            # The options are saved with the feature and off by default, so
+            # that the result does not depend on the user settings
+            self.assertEqual((fuse.UseOBB, fuse.Glue, fuse.Prefilter), (False, 'Off', False))
+            doc.recompute()
+            volume = fuse.Shape.Volume
+            self.assertEqual(len(fuse.Shape.Solids), 2)
+            fuse.Glue = 'Full'
+            fuse.Prefilter = True
+            doc.recompute()
+            self.assertTrue(fuse.isValid())
+            self.assertAlmostEqual(fuse.Shape.Volume, volume)
+            self.assertEqual(len(fuse.Shape.Solids), 2)
+
+            cut = doc.addObject("Part::Cut", "Cut")
+            cut.Base = boxes[0]
+            cut.Tool = far
+            self.assertEqual((cut.UseOBB, cut.Glue), (False, 'Off'))
+            cut.UseOBB = True
+            doc.recompute()
+            self.assertTrue(cut.isValid())
+            self.assertAlmostEqual(cut.Shape.Volume, 1)
+        finally:
+            FreeCAD.closeDocument(doc.Name)
@@ -58,6 +58,16 @@ Boolean::Boolean()
     Type.setEnums(TypeEnums);
 
     ADD_PROPERTY_TYPE(Refine,(0),"Part Design",(App::PropertyType)(App::Prop_None),"Refine shape (clean up redundant edges) after adding/subtracting");
+    ADD_PROPERTY_TYPE(UseOBB,(false),"Part Design",App::Prop_None,
+        "Use oriented bound boxes to find interfering sub-shapes, which may be faster for rotated shapes");
+    ADD_PROPERTY_TYPE(Glue,((long)0),"Part Design",App::Prop_None,
+        "Speed up the operation on shapes that touch without intersecting.\n"
+        "Shift: faces of the shapes may partially coincide.\n"
+        "Full: the shapes only share whole sub-shapes.\n"
+        "The result is wrong if the shapes interfere otherwise.");
+    Glue.setEnums(Part::BooleanOptions::GlueEnums);
+    ADD_PROPERTY_TYPE(Prefilter,(false),"Part Design",App::Prop_None,
+        "Leave out tools whose bound box does not touch the body from the operation");
     Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
         .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/PartDesign");
     this->Refine.setValue(hGrp->GetBool("RefineModel", false));
@@ -104,6 +114,10 @@ App::DocumentObjectExecReturn *Boolean::execute(void)
     if(!baseBody)
          return new App::DocumentObjectExecReturn("Cannot do boolean on feature which is not in a body");
 
+    Part::BooleanOptions options;
+    options.useOBB = UseOBB.getValue();
+    options.glue = Glue.getValue();
+    options.prefilter = Prefilter.getValue();
     TopoShape result(0,getDocument()->getStringHasher());
     for (auto tool : tools)
     {
@@ -125,7 +139,7 @@ App::DocumentObjectExecReturn *Boolean::execute(void)
             continue;
 
         try {
-            result.makEShape(op,{baseTopShape,shape});
+            result.makEBoolean(op,{baseTopShape,shape},options);
         }catch (Standard_Failure&) {
             return new App::DocumentObjectExecReturn((type + " of tools failed").c_str());
         }
@@ -136,8 +150,8 @@ App::DocumentObjectExecReturn *Boolean::execute(void)
         baseTopShape = result; // Use result of this operation for fuse/cut of next body
     }
 
-    if (this->Refine.getValue())
-        result = result.makERefine();
+    if (this->Refine.getValue())
+        result = result.makERefine();
 
     this->Shape.setValue(result);
     return App::DocumentObject::StdReturn;
@@ -47,6 +47,9 @@ public:
     App::PropertyEnumeration    Type;
 
     App::PropertyBool Refine;
+    App::PropertyBool UseOBB;
+    App::PropertyEnumeration Glue;
+    App::PropertyBool Prefilter;
 
    /** @name methods override feature */
     //@{
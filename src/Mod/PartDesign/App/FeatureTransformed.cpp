@@ -36,6 +36,12 @@
 # include <Bnd_Box.hxx>
 #endif
 
+#if OCC_VERSION_HEX >= 0x070200
+# include <Bnd_OBB.hxx>
+#endif
+
+#include <QtConcurrentMap>
+
 
 #include "FeatureTransformed.h"
 #include "FeatureMultiTransform.h"
@@ -58,6 +64,57 @@ FC_LOG_LEVEL_INIT("PartDesign",true,true)
 
 using namespace PartDesign;
 using namespace Part;
+
+namespace {
+
+// Bound used to reject transformed copies that cannot intersect the support.
+// The bound of a copy is obtained by transforming the bound of the original
+// instead of measuring the copy itself.
+#if OCC_VERSION_HEX >= 0x070200
+typedef Bnd_OBB ToolBound;
+
+void addBound(const TopoDS_Shape &shape, ToolBound &bound)
+{
+    BRepBndLib::AddOBB(shape, bound);
+    bound.Enlarge(Precision::Confusion());
+}
+
+ToolBound transformBound(const ToolBound &bound, const gp_Trsf &trsf)
+{
+    if (bound.IsVoid())
+        return bound;
+    double scale = Abs(trsf.ScaleFactor());
+    return Bnd_OBB(gp_Pnt(bound.Center()).Transformed(trsf),
+                   gp_Dir(bound.XDirection()).Transformed(trsf),
+                   gp_Dir(bound.YDirection()).Transformed(trsf),
+                   gp_Dir(bound.ZDirection()).Transformed(trsf),
+                   bound.XHSize()*scale, bound.YHSize()*scale, bound.ZHSize()*scale);
+}
+#else
+typedef Bnd_Box ToolBound;
+
+void addBound(const TopoDS_Shape &shape, ToolBound &bound)
+{
+    BRepBndLib::Add(shape, bound);
+    bound.SetGap(Precision::Confusion());
+}
+
+ToolBound transformBound(const ToolBound &bound, const gp_Trsf &trsf)
+{
+    return bound.Transformed(trsf);
+}
+#endif
+
+struct ToolCopy {
+    std::size_t index;
+    TopoDS_Shape shape;
+
+    explicit ToolCopy(std::size_t index)
+        :index(index)
+    {}
+};
+
+} // anonymous namespace
 
 namespace PartDesign {
 
@@ -349,6 +406,29 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
     // Original separately. This way it is easier to discover what feature causes a fuse/cut
     // to fail. The downside is that performance suffers when there are many originals. But it seems
     // safe to assume that in most cases there are few originals and many transformations
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+        .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/PartDesign");
+    if (originalShapes.size() && hGrp->GetBool("FastPattern", true)) {
+        rejectedMap rejects;
+        TopoShape fastSupport = support;
+        bool done = false;
+        try {
+            done = makePatternFast(fastSupport, originalShapes, fuses, transformations, rejects);
+            if (!done)
+                FC_LOG("Fast pattern gives a different result, fall back to single instance method");
+        } catch (Standard_Failure &e) {
+            FC_LOG("Fast pattern failed: " << (e.GetMessageString() ? e.GetMessageString() : ""));
+        } catch (Base::Exception &e) {
+            FC_LOG("Fast pattern failed: " << e.what());
+        }
+        if (done) {
+            support = fastSupport;
+            result = support;
+            rejected = std::move(rejects);
+            originalShapes.clear();
+        }
+    }
+
     int i=0;
     for (TopoShape &shape : originalShapes) {
         auto &sub = originalSubs[i];
@@ -477,6 +557,120 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
     return App::DocumentObject::StdReturn;
 }
 
+bool Transformed::makePatternFast(TopoShape &support, const std::vector<TopoShape> &originalShapes,
+        const std::vector<bool> &fuses, const std::vector<gp_Trsf> &transformations,
+        rejectedMap &rejects)
+{
+    std::ostringstream ss;
+    for (std::size_t i=0; i<originalShapes.size(); ++i) {
+        const TopoShape &shape = originalShapes[i];
+        bool fuse = fuses[i];
+
+        ToolBound supportBound;
+        addBound(support.getShape(), supportBound);
+        ToolBound bound;
+        addBound(shape.getShape(), bound);
+
+        // Skip first transformation, which is always the identity transformation
+        std::vector<ToolBound> bounds;
+        bounds.reserve(transformations.size());
+        for (std::size_t idx=1; idx<transformations.size(); ++idx)
+            bounds.push_back(transformBound(bound, transformations[idx]));
+
+        // Like the single instance method, which checks each copy against the
+        // support grown by the previously fused copies, keep any copy to be
+        // fused that touches another kept copy.
+        std::vector<bool> keep(bounds.size(), false);
+        std::vector<std::size_t> pending;
+        for (std::size_t j=0; j<bounds.size(); ++j) {
+            if (!supportBound.IsOut(bounds[j])) {
+                keep[j] = true;
+                if (fuse)
+                    pending.push_back(j);
+            }
+        }
+        while (!pending.empty()) {
+            std::size_t k = pending.back();
+            pending.pop_back();
+            for (std::size_t j=0; j<bounds.size(); ++j) {
+                if (!keep[j] && !bounds[k].IsOut(bounds[j])) {
+                    keep[j] = true;
+                    pending.push_back(j);
+                }
+            }
+        }
+
+        std::vector<ToolCopy> copies;
+        for (std::size_t j=0; j<keep.size(); ++j) {
+            if (keep[j])
+                copies.emplace_back(j+1);
+        }
+
+        // The single instance method rejects a copy to be cut that does not
+        // intersect the support cut by the previous copies. Checking against
+        // the support before any cut gives the same result only if the kept
+        // copies do not overlap each other.
+        if (!fuse) {
+            for (std::size_t j=1; j<copies.size(); ++j) {
+                const ToolBound &copyBound = bounds[copies[j].index-1];
+                for (std::size_t k=0; k<j; ++k) {
+                    if (!bounds[copies[k].index-1].IsOut(copyBound))
+                        return false;
+                }
+            }
+        }
+
+        // Copying the geometry is thread safe, unlike the element mapping
+        // done in makETransform() below
+        if (CopyShape.getValue()) {
+            const TopoDS_Shape &source = shape.getShape();
+            QtConcurrent::blockingMap(copies, [&source](ToolCopy &copy) {
+                copy.shape = BRepBuilderAPI_Copy(source).Shape();
+            });
+        }
+
+        std::vector<TopoShape> shapes;
+        shapes.reserve(copies.size()+1);
+        shapes.push_back(support);
+        for (auto &copy : copies) {
+            ss.str("");
+            ss << 'I' << copy.index;
+            TopoShape shapeCopy(shape);
+            if (!copy.shape.IsNull())
+                shapeCopy.setShape(copy.shape, false);
+            shapeCopy = shapeCopy.makETransform(transformations[copy.index], ss.str().c_str());
+            if (!fuse && !Part::checkIntersection(support.getShape(), shapeCopy.getShape(), false, true))
+                keep[copy.index-1] = false;
+            else
+                shapes.push_back(shapeCopy);
+        }
+
+        std::vector<gp_Trsf> culled;
+        for (std::size_t j=0; j<keep.size(); ++j) {
+            if (!keep[j])
+                culled.push_back(transformations[j+1]);
+        }
+        if (culled.size())
+            rejects.emplace_back(shape, culled);
+        if (shapes.size() < 2)
+            continue;
+
+        TopoShape result;
+        if (fuse) {
+            result.makEFuse(shapes);
+            // A copy whose bound touches the support while the copy itself
+            // does not gives an extra solid here
+            if (result.countSubShapes(TopAbs_SOLID) != 1)
+                return false;
+            support = getSolid(result);
+        } else {
+            result.makECut(shapes);
+            support = result;
+        }
+    }
+    return true;
+}
+
 TopoShape Transformed::refineShapeIfActive(const TopoShape& oldShape) const
 {
     if (this->Refine.getValue()) 
@@ -104,6 +104,18 @@ protected:
     void divideTools(const std::vector<TopoDS_Shape> &toolsIn, std::vector<TopoDS_Shape> &individualsOut,
 		     TopoDS_Compound &compoundOut) const; 
 
+    /** Apply the transformed copies of each original with a single boolean operation
+     *
+     * Copies whose bound does not touch the support are rejected without
+     * copying them, and the geometry of the others is copied in parallel.
+     * Copies to be cut that do not intersect the support are rejected as well.
+     * Returns false if the result differs from the one of applying copies
+     * one by one, in which case the caller shall fall back to the latter.
+     */
+    bool makePatternFast(TopoShape &support, const std::vector<TopoShape> &originalShapes,
+            const std::vector<bool> &fuses, const std::vector<gp_Trsf> &transformations,
+            rejectedMap &rejects);
+
     virtual void setupObject () override;
 
     rejectedMap rejected;
@@ -138,6 +138,50 @@ class TestLinearPattern(unittest.TestCase):
         self.Doc.recompute()
         self.assertAlmostEqual(self.LinearPattern.Shape.Volume, 1e4)
 
+    def testFastPatternRejection(self):
+        # L shaped support, leaving an empty corner inside its bounding box
+        self.Body = self.Doc.addObject('PartDesign::Body','Body')
+        self.Box = self.Doc.addObject('PartDesign::AdditiveBox','Box')
+        self.Body.addObject(self.Box)
+        self.Box.Length=30.00
+        self.Box.Width=10.00
+        self.Box.Height=10.00
+        self.Box2 = self.Doc.addObject('PartDesign::AdditiveBox','Box2')
+        self.Body.addObject(self.Box2)
+        self.Box2.Length=10.00
+        self.Box2.Width=20.00
+        self.Box2.Height=10.00
+        self.Pocket = self.Doc.addObject('PartDesign::SubtractiveBox','Pocket')
+        self.Body.addObject(self.Pocket)
+        self.Pocket.Length=4.00
+        self.Pocket.Width=4.00
+        self.Pocket.Height=20.00
+        self.Pocket.Placement = FreeCAD.Placement(FreeCAD.Vector(2, 12, -5), FreeCAD.Rotation())
+        self.Doc.recompute()
+        # the last two copies are in the empty corner
+        self.LinearPattern = self.Doc.addObject("PartDesign::LinearPattern","LinearPattern")
+        self.LinearPattern.Originals = [self.Pocket]
+        self.LinearPattern.Direction = (self.Doc.X_Axis,[""])
+        self.LinearPattern.Length = 20.0
+        self.LinearPattern.Occurrences = 3
+        self.Body.addObject(self.LinearPattern)
+        param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/PartDesign")
+        fast = param.GetBool("FastPattern", True)
+        results = []
+        try:
+            for enable in (True, False):
+                param.SetBool("FastPattern", enable)
+                self.LinearPattern.touch()
+                self.Doc.recompute()
+                shape = self.LinearPattern.Shape
+                results.append((shape.Volume, len(shape.Solids), self.LinearPattern.isValid()))
+        finally:
+            param.SetBool("FastPattern", fast)
+        self.assertAlmostEqual(results[0][0], results[1][0])
+        self.assertAlmostEqual(results[1][0], 4000 - 160)
+        self.assertEqual(results[0][1:], results[1][1:])
+        self.assertEqual(results[1][1:], (1, False))
+
     def tearDown(self):
         #closing doc
         FreeCAD.closeDocument("PartDesignTestLinearPattern")
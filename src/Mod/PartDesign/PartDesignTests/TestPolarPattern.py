@@ -138,6 +138,53 @@ class TestPolarPattern(unittest.TestCase):
         self.Doc.recompute()
         self.assertAlmostEqual(self.PolarPattern.Shape.Volume, 4000)
 
+    def testFastPatternRejection(self):
+        # Support covering three quadrants around the Z axis, leaving the
+        # third one empty inside its bounding box
+        self.Body = self.Doc.addObject('PartDesign::Body','Body')
+        self.Box = self.Doc.addObject('PartDesign::AdditiveBox','Box')
+        self.Body.addObject(self.Box)
+        self.Box.Length=40.00
+        self.Box.Width=20.00
+        self.Box.Height=10.00
+        self.Box.Placement = FreeCAD.Placement(FreeCAD.Vector(-20, 0, 0), FreeCAD.Rotation())
+        self.Box2 = self.Doc.addObject('PartDesign::AdditiveBox','Box2')
+        self.Body.addObject(self.Box2)
+        self.Box2.Length=20.00
+        self.Box2.Width=20.00
+        self.Box2.Height=10.00
+        self.Box2.Placement = FreeCAD.Placement(FreeCAD.Vector(0, -20, 0), FreeCAD.Rotation())
+        self.Pocket = self.Doc.addObject('PartDesign::SubtractiveBox','Pocket')
+        self.Body.addObject(self.Pocket)
+        self.Pocket.Length=4.00
+        self.Pocket.Width=4.00
+        self.Pocket.Height=20.00
+        self.Pocket.Placement = FreeCAD.Placement(FreeCAD.Vector(5, 5, -5), FreeCAD.Rotation())
+        self.Doc.recompute()
+        # the copy rotated by 180 degrees is in the empty quadrant
+        self.PolarPattern = self.Doc.addObject("PartDesign::PolarPattern","PolarPattern")
+        self.PolarPattern.Originals = [self.Pocket]
+        self.PolarPattern.Axis = (self.Doc.Z_Axis,[""])
+        self.PolarPattern.Angle = 360
+        self.PolarPattern.Occurrences = 4
+        self.Body.addObject(self.PolarPattern)
+        param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/PartDesign")
+        fast = param.GetBool("FastPattern", True)
+        results = []
+        try:
+            for enable in (True, False):
+                param.SetBool("FastPattern", enable)
+                self.PolarPattern.touch()
+                self.Doc.recompute()
+                shape = self.PolarPattern.Shape
+                results.append((shape.Volume, len(shape.Solids), self.PolarPattern.isValid()))
+        finally:
+            param.SetBool("FastPattern", fast)
+        self.assertAlmostEqual(results[0][0], results[1][0])
+        self.assertAlmostEqual(results[1][0], 12000 - 3*160)
+        self.assertEqual(results[0][1:], results[1][1:])
+        self.assertEqual(results[1][1:], (1, False))
+
     def tearDown(self):
         #closing doc
         FreeCAD.closeDocument("PartDesignTestPolarPattern")
@@ -23,6 +23,9 @@
 
 #include "PreCompiled.h"
 
+#include <cstring>
+#include <memory>
+
 #include "Mod/Points/App/Points.h"
 #include <Base/Builder3D.h>
 #include <Base/VectorPy.h>
@@ -101,6 +104,9 @@ PyObject* PointsPy::read(PyObject * args)
     if (!PyArg_ParseTuple(args, "s",&Name))
         return NULL;                         
 
+    if (!checkBufferExports())
+        return 0;
+
     PY_TRY {
         getPointKernelPtr()->load(Name);
     } PY_CATCH;
@@ -145,6 +151,43 @@ PyObject* PointsPy::addPoints(PyObject * args)
     if (!PyArg_ParseTuple(args, "O", &obj))
         return 0;
 
+    if (!checkBufferExports())
+        return 0;
+
+    if (PyObject_CheckBuffer(obj)) {
+        Py_buffer buf;
+        if (PyObject_GetBuffer(obj, &buf, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) < 0)
+            return 0;
+        std::unique_ptr<Py_buffer, void(*)(Py_buffer*)> guard(&buf, PyBuffer_Release);
+        const char *format = buf.format ? buf.format : "B";
+        if (format[0] == '@' || format[0] == '=' || format[0] == '<')
+            ++format;
+        bool isFloat = buf.itemsize == sizeof(float) && strcmp(format, "f") == 0;
+        bool isDouble = buf.itemsize == sizeof(double) && strcmp(format, "d") == 0;
+        if (!isFloat && !isDouble) {
+            PyErr_SetString(PyExc_TypeError, "Expect a buffer of float or double");
+            return 0;
+        }
+        Py_ssize_t count = buf.len / buf.itemsize;
+        if (count % 3) {
+            PyErr_SetString(PyExc_ValueError, "Expect a buffer of 3 values per point");
+            return 0;
+        }
+        PointKernel* kernel = getPointKernelPtr();
+        kernel->reserve(kernel->size() + count / 3);
+        if (isFloat) {
+            const float *data = static_cast<const float*>(buf.buf);
+            for (Py_ssize_t i = 0; i < count; i += 3)
+                kernel->push_back(Base::Vector3d(data[i], data[i+1], data[i+2]));
+        }
+        else {
+            const double *data = static_cast<const double*>(buf.buf);
+            for (Py_ssize_t i = 0; i < count; i += 3)
+                kernel->push_back(Base::Vector3d(data[i], data[i+1], data[i+2]));
+        }
+        Py_Return;
+    }
+
     try {
         Py::Sequence list(obj);
         union PyType_Object pyType = {&(Base::VectorPy::Type)};
@@ -242,6 +285,94 @@ Py::List PointsPy::getPoints(void) const
     return PointList;
 }
 
+bool PointsPy::checkBufferExports() const
+{
+    if (bufferExports > 0) {
+        PyErr_SetString(PyExc_BufferError, "Existing exports of data: object cannot be re-sized");
+        return false;
+    }
+    return true;
+}
+
+#if PY_MAJOR_VERSION >= 3
+int PointsPy::getBuffer(PyObject *self, Py_buffer *view, int flags)
+{
+    PointsPy *pyself = static_cast<PointsPy*>(self);
+    if (!pyself->isValid()) {
+        PyErr_SetString(PyExc_ReferenceError, "This object is already deleted most likely through closing a document. This reference is no longer valid!");
+        view->obj = 0;
+        return -1;
+    }
+
+    bool readonly = pyself->isConst();
+    if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE && readonly) {
+        PyErr_SetString(PyExc_BufferError, "This object is immutable, you can not set any attribute or call a non const method");
+        view->obj = 0;
+        return -1;
+    }
+
+    // Shape and strides are kept in the same allocation as the copy of the
+    // points (if any), and released in releaseBuffer()
+    std::size_t count = pyself->getPointKernelPtr()->size();
+    std::size_t extra = readonly ? count * 3 : 0;
+    float *data = 0;
+    Py_ssize_t *info = 0;
+    try {
+        info = new Py_ssize_t[4 + (extra * sizeof(float) + sizeof(Py_ssize_t) - 1) / sizeof(Py_ssize_t)];
+    }
+    catch (const std::bad_alloc&) {
+        PyErr_NoMemory();
+        view->obj = 0;
+        return -1;
+    }
+
+    const std::vector<PointKernel::value_type> &points = pyself->getPointKernelPtr()->getBasicPoints();
+    if (readonly) {
+        // A read-only points object is usually owned by a document object,
+        // whose value may be reassigned while the buffer is still alive. So
+        // export a copy instead of the internal storage.
+        data = reinterpret_cast<float*>(info + 4);
+        float *copy = data;
+        for (const auto &pnt : points) {
+            *copy++ = pnt.x;
+            *copy++ = pnt.y;
+            *copy++ = pnt.z;
+        }
+    }
+    else {
+        data = count ? const_cast<float*>(&points[0].x) : 0;
+        ++pyself->bufferExports;
+    }
+
+    info[0] = static_cast<Py_ssize_t>(count);
+    info[1] = 3;
+    info[2] = readonly ? 3 * sizeof(float) : sizeof(PointKernel::value_type);
+    info[3] = sizeof(float);
+
+    view->buf = data;
+    view->obj = self;
+    Py_INCREF(self);
+    view->len = static_cast<Py_ssize_t>(count * 3 * sizeof(float));
+    view->readonly = readonly ? 1 : 0;
+    view->itemsize = sizeof(float);
+    view->format = (flags & PyBUF_FORMAT) == PyBUF_FORMAT ? const_cast<char*>("f") : 0;
+    view->ndim = 2;
+    view->shape = (flags & PyBUF_ND) == PyBUF_ND ? info : 0;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? info + 2 : 0;
+    view->suboffsets = 0;
+    view->internal = info;
+    return 0;
+}
+
+void PointsPy::releaseBuffer(PyObject *self, Py_buffer *view)
+{
+    PointsPy *pyself = static_cast<PointsPy*>(self);
+    if (!view->readonly)
+        --pyself->bufferExports;
+    delete [] static_cast<Py_ssize_t*>(view->internal);
+}
+#endif
+
 PyObject *PointsPy::getCustomAttributes(const char* /*attr*/) const
 {
     return 0;
@@ -0,0 +1,62 @@
+#   (c) 2026 FreeCAD contributors      LGPL
+
+import FreeCAD, unittest, Points
+import array
+
+
+#---------------------------------------------------------------------------
+# define the functions to test the FreeCAD points module
+#---------------------------------------------------------------------------
+
+
+class PointsBufferCases(unittest.TestCase):
+    def setUp(self):
+        self.doc = FreeCAD.newDocument("PointsBufferTest")
+
+    def testAddPoints(self):
+        pts = Points.Points()
+        pts.addPoints(array.array('d', [0,1,2, 3,4,5]))
+        pts.addPoints(array.array('f', [6,7,8]))
+        self.assertEqual(pts.CountPoints, 3)
+        self.assertEqual(pts.Points[2], FreeCAD.Vector(6,7,8))
+        with self.assertRaises(ValueError):
+            pts.addPoints(array.array('d', [0,1]))
+        with self.assertRaises(TypeError):
+            pts.addPoints(array.array('i', [0,1,2]))
+        # lists of vectors are still accepted
+        pts.addPoints([FreeCAD.Vector(9,10,11)])
+        self.assertEqual(pts.CountPoints, 4)
+
+    def testSharedBuffer(self):
+        pts = Points.Points()
+        pts.addPoints(array.array('d', range(6)))
+        view = memoryview(pts)
+        self.assertEqual(view.format, 'f')
+        self.assertEqual(view.shape, (2,3))
+        self.assertFalse(view.readonly)
+        self.assertEqual(view.tolist(), [[0,1,2],[3,4,5]])
+        # the view shares memory with the points
+        view[1,2] = 10.0
+        self.assertEqual(pts.Points[1], FreeCAD.Vector(3,4,10))
+        # the points cannot be resized while the view exists
+        with self.assertRaises(BufferError):
+            pts.addPoints([FreeCAD.Vector()])
+        view.release()
+        pts.addPoints([FreeCAD.Vector()])
+        self.assertEqual(pts.CountPoints, 3)
+
+    def testReadOnlyBuffer(self):
+        pts = Points.Points()
+        pts.addPoints(array.array('d', range(6)))
+        feature = self.doc.addObject("Points::Feature", "Points")
+        feature.Points = pts
+        view = memoryview(feature.Points)
+        self.assertTrue(view.readonly)
+        self.assertEqual(view.tolist(), [[0,1,2],[3,4,5]])
+        # the view holds a copy, which survives a change of the property
+        feature.Points = Points.Points()
+        self.assertEqual(view.tolist(), [[0,1,2],[3,4,5]])
+        view.release()
+
+    def tearDown(self):
+        FreeCAD.closeDocument(self.doc.Name)
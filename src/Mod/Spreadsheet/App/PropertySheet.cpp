@@ -25,8 +25,7 @@
 #ifndef _PreComp_
 #endif
 
-#include <boost/range/adaptor/map.hpp>
-#include <boost/range/algorithm/copy.hpp>
+#include <algorithm>
 #include <boost/assign.hpp>
 #include <boost/bind.hpp>
 #include <boost/regex.hpp>
@@ -55,7 +54,7 @@ TYPESYSTEM_SOURCE(Spreadsheet::PropertySheet , App::PropertyExpressionContainer)
 
 void PropertySheet::clear()
 {
-    std::map<CellAddress, Cell* >::iterator i = data.begin();
+    CellStore::const_iterator i = data.begin();
 
     /* Clear cells */
     while (i != data.end()) {
@@ -73,6 +72,9 @@ void PropertySheet::clear()
     cellToPropertyNameMap.clear();
     documentObjectToCellMap.clear();
     cellToDocumentObjectMap.clear();
+    cellGraph.clear();
+    cyclicEdges.clear();
+    nextCellOrder = 0;
     aliasProp.clear();
     revAliasProp.clear();
 
@@ -81,22 +83,12 @@ void PropertySheet::clear()
 
 Cell *PropertySheet::getValue(CellAddress key)
 {
-    std::map<CellAddress, Cell*>::const_iterator i = data.find(key);
-
-    if (i == data.end())
-        return 0;
-    else
-        return i->second;
+    return data.get(key);
 }
 
 const Cell *PropertySheet::getValue(CellAddress key) const
 {
-    std::map<CellAddress, Cell*>::const_iterator i = data.find(key);
-
-    if (i == data.end())
-        return 0;
-    else
-        return i->second;
+    return data.get(key);
 }
 
 
@@ -146,7 +138,7 @@ std::set<CellAddress> PropertySheet::getUsedCells() const
 {
     std::set<CellAddress> usedSet;
 
-    for (std::map<CellAddress, Cell*>::const_iterator i = data.begin(); i != data.end(); ++i) {
+    for (CellStore::const_iterator i = data.begin(); i != data.end(); ++i) {
         if (i->second->isUsed())
             usedSet.insert(i->first);
     }
@@ -202,6 +194,91 @@ Cell * PropertySheet::createCell(CellAddress address)
     return cell;
 }
 
+CellStore::const_iterator::const_iterator(const CellStore *store, int row, int col)
+    : store(store), row(row), col(col), value(CellAddress(), nullptr)
+{
+    seek();
+}
+
+void CellStore::const_iterator::seek()
+{
+    const auto &rows = store->rows;
+    for (; row < static_cast<int>(rows.size()); ++row, col = 0) {
+        const auto &chunks = rows[row];
+        while (col < static_cast<int>(chunks.size()) * ChunkSize) {
+            const auto &chunk = chunks[col / ChunkSize];
+            if (!chunk) {
+                col = (col / ChunkSize + 1) * ChunkSize;
+                continue;
+            }
+            Cell *cell = (*chunk)[col % ChunkSize];
+            if (cell) {
+                value.first = CellAddress(row, col);
+                value.second = cell;
+                return;
+            }
+            ++col;
+        }
+    }
+    col = 0;
+}
+
+CellStore::const_iterator CellStore::find(CellAddress address) const
+{
+    if (!get(address))
+        return end();
+    return const_iterator(this, address.row(), address.col());
+}
+
+Cell *CellStore::get(CellAddress address) const
+{
+    int row = address.row();
+    int col = address.col();
+    if (row < 0 || col < 0 || row >= static_cast<int>(rows.size()))
+        return nullptr;
+    const auto &chunks = rows[row];
+    if (col / ChunkSize >= static_cast<int>(chunks.size()) || !chunks[col / ChunkSize])
+        return nullptr;
+    return (*chunks[col / ChunkSize])[col % ChunkSize];
+}
+
+Cell *&CellStore::operator[](CellAddress address)
+{
+    int row = address.row();
+    int col = address.col();
+    if (row < 0 || col < 0 || row >= CellAddress::MAX_ROWS || col >= CellAddress::MAX_COLUMNS)
+        throw Base::IndexError("Invalid cell address");
+    if (row >= static_cast<int>(rows.size()))
+        rows.resize(row + 1);
+    auto &chunks = rows[row];
+    if (col / ChunkSize >= static_cast<int>(chunks.size()))
+        chunks.resize(col / ChunkSize + 1);
+    auto &chunk = chunks[col / ChunkSize];
+    if (!chunk) {
+        chunk.reset(new Chunk);
+        chunk->fill(nullptr);
+    }
+    return (*chunk)[col % ChunkSize];
+}
+
+void CellStore::erase(CellAddress address)
+{
+    int row = address.row();
+    int col = address.col();
+    if (row < 0 || col < 0 || row >= static_cast<int>(rows.size()))
+        return;
+    auto &chunks = rows[row];
+    if (col / ChunkSize >= static_cast<int>(chunks.size()) || !chunks[col / ChunkSize])
+        return;
+    auto &chunk = chunks[col / ChunkSize];
+    (*chunk)[col % ChunkSize] = nullptr;
+    for (auto cell : *chunk) {
+        if (cell)
+            return;
+    }
+    chunk.reset();
+}
+
 PropertySheet::PropertySheet(Sheet *_owner)
     : owner(_owner)
     , updateCount(0)
@@ -216,11 +293,14 @@ PropertySheet::PropertySheet(const PropertySheet &other)
     , cellToPropertyNameMap(other.cellToPropertyNameMap)
     , documentObjectToCellMap(other.documentObjectToCellMap)
     , cellToDocumentObjectMap(other.cellToDocumentObjectMap)
+    , cellGraph(other.cellGraph)
+    , cyclicEdges(other.cyclicEdges)
+    , nextCellOrder(other.nextCellOrder)
     , aliasProp(other.aliasProp)
     , revAliasProp(other.revAliasProp)
     , updateCount(other.updateCount)
 {
-    std::map<CellAddress, Cell* >::const_iterator i = other.data.begin();
+    CellStore::const_iterator i = other.data.begin();
 
     /* Copy cells */
     while (i != other.data.end()) {
@@ -245,7 +325,7 @@ void PropertySheet::Paste(const Property &from)
 
     AtomicPropertyChange signaller(*this);
 
-    std::map<CellAddress, Cell* >::iterator icurr = data.begin();
+    CellStore::const_iterator icurr = data.begin();
 
     /* Mark all first */
     while (icurr != data.end()) {
@@ -253,9 +333,9 @@ void PropertySheet::Paste(const Property &from)
         ++icurr;
     }
 
-    std::map<CellAddress, Cell* >::const_iterator ifrom = froms.data.begin();
+    CellStore::const_iterator ifrom = froms.data.begin();
     while (ifrom != froms.data.end()) {
-        std::map<CellAddress, Cell* >::iterator i = data.find(ifrom->first);
+        CellStore::const_iterator i = data.find(ifrom->first);
 
         if (i != data.end()) {
             *(data[ifrom->first]) = *(ifrom->second); // Exists; assign cell directly
@@ -276,7 +356,7 @@ void PropertySheet::Paste(const Property &from)
         Cell * cell = icurr->second;
 
         if (cell->isMarked()) {
-            std::map<CellAddress, Cell* >::iterator next = icurr;
+            CellStore::const_iterator next = icurr;
 
             ++next;
             clear(icurr->first);
@@ -295,7 +375,7 @@ void PropertySheet::Save(Base::Writer &writer) const
     // Save cell contents
     int count = 0;
 
-    std::map<CellAddress, Cell*>::const_iterator ci = data.begin();
+    CellStore::const_iterator ci = data.begin();
     while (ci != data.end()) {
         if (ci->second->isUsed())
             ++count;
@@ -456,13 +536,13 @@ Cell * PropertySheet::cellAt(CellAddress address)
 
     // address actually inside a merged cell
     if (j != mergedCells.end()) {
-        std::map<CellAddress, Cell*>::const_iterator i = data.find(j->second);
+        CellStore::const_iterator i = data.find(j->second);
         assert(i != data.end());
 
         return i->second;
     }
 
-    std::map<CellAddress, Cell*>::const_iterator i = data.find(address);
+    CellStore::const_iterator i = data.find(address);
 
     if (i == data.end())
         return 0;
@@ -476,13 +556,13 @@ const Cell * PropertySheet::cellAt(CellAddress address) const
 
     // address actually inside a merged cell
     if (j != mergedCells.end()) {
-        std::map<CellAddress, Cell*>::const_iterator i = data.find(j->second);
+        CellStore::const_iterator i = data.find(j->second);
         assert(i != data.end());
 
         return i->second;
     }
 
-    std::map<CellAddress, Cell*>::const_iterator i = data.find(address);
+    CellStore::const_iterator i = data.find(address);
 
     if (i == data.end())
         return 0;
@@ -495,7 +575,7 @@ Cell * PropertySheet::nonNullCellAt(CellAddress address)
     std::map<CellAddress, CellAddress>::const_iterator j = mergedCells.find(address);
 
     if (j != mergedCells.end()) {
-        std::map<CellAddress, Cell*>::const_iterator i = data.find(j->second);
+        CellStore::const_iterator i = data.find(j->second);
 
         if (i == data.end())
             return createCell(address);
@@ -503,7 +583,7 @@ Cell * PropertySheet::nonNullCellAt(CellAddress address)
             return i->second;
     }
 
-    std::map<CellAddress, Cell*>::const_iterator i = data.find(address);
+    CellStore::const_iterator i = data.find(address);
 
     if (i == data.end())
         return createCell(address);
@@ -610,7 +690,7 @@ void PropertySheet::setSpans(CellAddress address, int rows, int columns)
 
 void PropertySheet::clear(CellAddress address)
 {
-    std::map<CellAddress, Cell*>::iterator i = data.find(address);
+    CellStore::const_iterator i = data.find(address);
 
     if (i == data.end())
         return;
@@ -641,8 +721,8 @@ void PropertySheet::clear(CellAddress address)
 
 void PropertySheet::moveCell(CellAddress currPos, CellAddress newPos, std::map<App::ObjectIdentifier, App::ObjectIdentifier> & renames)
 {
-    std::map<CellAddress, Cell*>::const_iterator i = data.find(currPos);
-    std::map<CellAddress, Cell*>::const_iterator j = data.find(newPos);
+    CellStore::const_iterator i = data.find(currPos);
+    CellStore::const_iterator j = data.find(newPos);
 
     AtomicPropertyChange signaller(*this);
 
@@ -700,7 +780,8 @@ void PropertySheet::insertRows(int row, int count)
     std::map<App::ObjectIdentifier, App::ObjectIdentifier> renames;
 
     /* Copy all keys from cells map */
-    boost::copy( data | boost::adaptors::map_keys, std::back_inserter(keys));
+    for (auto &d : data)
+        keys.push_back(d.first);
 
     /* Sort them */
     std::sort(keys.begin(), keys.end(), boost::bind(&PropertySheet::rowSortFunc, this, _1, _2));
@@ -710,7 +791,7 @@ void PropertySheet::insertRows(int row, int count)
 
     AtomicPropertyChange signaller(*this);
     for (std::vector<CellAddress>::const_reverse_iterator i = keys.rbegin(); i != keys.rend(); ++i) {
-        std::map<CellAddress, Cell*>::iterator j = data.find(*i);
+        CellStore::const_iterator j = data.find(*i);
 
         assert(j != data.end());
 
@@ -751,7 +832,8 @@ void PropertySheet::removeRows(int row, int count)
     std::map<App::ObjectIdentifier, App::ObjectIdentifier> renames;
 
     /* Copy all keys from cells map */
-    boost::copy(data | boost::adaptors::map_keys, std::back_inserter(keys));
+    for (auto &d : data)
+        keys.push_back(d.first);
 
     /* Sort them */
     std::sort(keys.begin(), keys.end(), boost::bind(&PropertySheet::rowSortFunc, this, _1, _2));
@@ -761,7 +843,7 @@ void PropertySheet::removeRows(int row, int count)
 
     AtomicPropertyChange signaller(*this);
     for (std::vector<CellAddress>::const_iterator i = keys.begin(); i != keys.end(); ++i) {
-        std::map<CellAddress, Cell*>::iterator j = data.find(*i);
+        CellStore::const_iterator j = data.find(*i);
 
         assert(j != data.end());
 
@@ -792,7 +874,8 @@ void PropertySheet::insertColumns(int col, int count)
     std::map<App::ObjectIdentifier, App::ObjectIdentifier> renames;
 
     /* Copy all keys from cells map */
-    boost::copy(data | boost::adaptors::map_keys, std::back_inserter(keys));
+    for (auto &d : data)
+        keys.push_back(d.first);
 
     /* Sort them */
     std::sort(keys.begin(), keys.end());
@@ -802,7 +885,7 @@ void PropertySheet::insertColumns(int col, int count)
 
     AtomicPropertyChange signaller(*this);
     for (std::vector<CellAddress>::const_reverse_iterator i = keys.rbegin(); i != keys.rend(); ++i) {
-        std::map<CellAddress, Cell*>::iterator j = data.find(*i);
+        CellStore::const_iterator j = data.find(*i);
 
         assert(j != data.end());
 
@@ -843,7 +926,8 @@ void PropertySheet::removeColumns(int col, int count)
     std::map<App::ObjectIdentifier, App::ObjectIdentifier> renames;
 
     /* Copy all keys from cells map */
-    boost::copy(data | boost::adaptors::map_keys, std::back_inserter(keys));
+    for (auto &d : data)
+        keys.push_back(d.first);
 
     /* Sort them */
     std::sort(keys.begin(), keys.end(), boost::bind(&PropertySheet::colSortFunc, this, _1, _2));
@@ -853,7 +937,7 @@ void PropertySheet::removeColumns(int col, int count)
 
     AtomicPropertyChange signaller(*this);
     for (std::vector<CellAddress>::const_iterator i = keys.begin(); i != keys.end(); ++i) {
-        std::map<CellAddress, Cell*>::iterator j = data.find(*i);
+        CellStore::const_iterator j = data.find(*i);
 
         assert(j != data.end());
 
@@ -1010,6 +1094,13 @@ void PropertySheet::addDependencies(CellAddress key)
 
             // Also an alias?
             if (docObj==owner && props.first.size()) {
+                // Reference to a cell of this sheet?
+                if (props.first[0] >= 'A' && props.first[0] <= 'Z') {
+                    CellAddress addr = stringToAddress(props.first.c_str(), true);
+                    if (addr.isValid() && addr.toString() == props.first)
+                        addCellEdge(addr, key);
+                }
+
                 std::map<std::string, CellAddress>::const_iterator j = revAliasProp.find(props.first);
 
                 if (j != revAliasProp.end()) {
@@ -1019,6 +1110,7 @@ void PropertySheet::addDependencies(CellAddress key)
                     // Insert into maps
                     propertyNameToCellMap[propName].insert(key);
                     cellToPropertyNameMap[key].insert(propName);
+                    addCellEdge(j->second, key);
                 }
             }
         }
@@ -1035,6 +1127,8 @@ void PropertySheet::addDependencies(CellAddress key)
 
 void PropertySheet::removeDependencies(CellAddress key)
 {
+    removeCellEdges(key);
+
     /* Remove from Property <-> Key maps */
 
     std::map<CellAddress, std::set< std::string > >::iterator i1 = cellToPropertyNameMap.find(key);
@@ -1080,6 +1174,205 @@ void PropertySheet::removeDependencies(CellAddress key)
     }
 }
 
+PropertySheet::CellNode &PropertySheet::getCellNode(CellAddress key)
+{
+    auto res = cellGraph.emplace(key, CellNode());
+    if (res.second)
+        res.first->second.order = nextCellOrder++;
+    return res.first->second;
+}
+
+/**
+  * Add an edge to the cell dependency graph, i.e. cell \a to depends on cell \a from.
+  *
+  * The topological order of the graph is maintained incrementally (Pearce &
+  * Kelly, "A Dynamic Topological Sort Algorithm for Directed Acyclic
+  * Graphs"), so that only the cells between the orders of the two ends of the
+  * new edge are visited and reordered. An edge closing a dependency loop is
+  * recorded in cyclicEdges and excluded from the order.
+  */
+
+void PropertySheet::addCellEdge(CellAddress from, CellAddress to)
+{
+    CellNode &fromNode = getCellNode(from);
+    CellNode &toNode = getCellNode(to);
+
+    if (!fromNode.dependants.insert(to).second)
+        return;
+    toNode.inputs.insert(from);
+
+    if (from == to) {
+        cyclicEdges.emplace(from, to);
+        return;
+    }
+
+    const int lower = toNode.order;
+    const int upper = fromNode.order;
+    if (upper < lower)
+        return;
+
+    // Find cells depending on 'to' that are currently ordered before 'from'
+    std::vector<CellAddress> forward;
+    CellSet visited;
+    std::vector<CellAddress> stack(1, to);
+    visited.insert(to);
+    while (stack.size()) {
+        CellAddress addr = stack.back();
+        stack.pop_back();
+        forward.push_back(addr);
+        for (auto &dep : cellGraph[addr].dependants) {
+            if (isCyclicEdge(addr, dep))
+                continue;
+            if (dep == from) {
+                // 'from' depends on 'to', so the new edge closes a loop
+                cyclicEdges.emplace(from, to);
+                return;
+            }
+            if (cellGraph[dep].order < upper && visited.insert(dep).second)
+                stack.push_back(dep);
+        }
+    }
+
+    // Find cells 'from' depends on that are currently ordered after 'to'
+    std::vector<CellAddress> backward;
+    visited.clear();
+    stack.push_back(from);
+    visited.insert(from);
+    while (stack.size()) {
+        CellAddress addr = stack.back();
+        stack.pop_back();
+        backward.push_back(addr);
+        for (auto &input : cellGraph[addr].inputs) {
+            if (!isCyclicEdge(input, addr)
+                    && cellGraph[input].order > lower
+                    && visited.insert(input).second)
+                stack.push_back(input);
+        }
+    }
+
+    // Reassign the orders occupied by the affected cells so that all cells
+    // found backward come before those found forward
+    auto compare = [this](const CellAddress &a, const CellAddress &b) {
+        return cellGraph[a].order < cellGraph[b].order;
+    };
+    std::sort(forward.begin(), forward.end(), compare);
+    std::sort(backward.begin(), backward.end(), compare);
+
+    std::vector<int> orders;
+    orders.reserve(forward.size() + backward.size());
+    for (auto &addr : backward)
+        orders.push_back(cellGraph[addr].order);
+    for (auto &addr : forward)
+        orders.push_back(cellGraph[addr].order);
+    std::sort(orders.begin(), orders.end());
+
+    auto iter = orders.begin();
+    for (auto &addr : backward)
+        cellGraph[addr].order = *iter++;
+    for (auto &addr : forward)
+        cellGraph[addr].order = *iter++;
+}
+
+/**
+  * Remove all edges of the cell dependency graph to the cell at \a key, i.e. the
+  * inputs of the cell.
+  */
+
+void PropertySheet::removeCellEdges(CellAddress key)
+{
+    auto it = cellGraph.find(key);
+    if (it == cellGraph.end())
+        return;
+
+    for (auto &input : it->second.inputs) {
+        cyclicEdges.erase(std::make_pair(input, key));
+        if (input == key) {
+            it->second.dependants.erase(key);
+            continue;
+        }
+        auto iter = cellGraph.find(input);
+        if (iter == cellGraph.end())
+            continue;
+        iter->second.dependants.erase(key);
+        if (iter->second.dependants.empty() && iter->second.inputs.empty())
+            cellGraph.erase(iter);
+    }
+    it->second.inputs.clear();
+    if (it->second.dependants.empty())
+        cellGraph.erase(it);
+
+    // Removing edges may break some dependency loops, so try to insert the
+    // cyclic edges into the order again
+    if (cyclicEdges.size()) {
+        std::set<std::pair<CellAddress, CellAddress> > edges;
+        edges.swap(cyclicEdges);
+        for (auto &edge : edges) {
+            cellGraph[edge.first].dependants.erase(edge.second);
+            cellGraph[edge.second].inputs.erase(edge.first);
+            addCellEdge(edge.first, edge.second);
+        }
+    }
+}
+
+bool PropertySheet::getRecomputeOrder(std::set<CellAddress> &cells,
+                                      std::vector<CellAddress> &order,
+                                      std::vector<int> *levels) const
+{
+    order.clear();
+    if (levels)
+        levels->clear();
+
+    std::vector<CellAddress> queue(cells.begin(), cells.end());
+    for (std::size_t i = 0; i < queue.size(); ++i) {
+        auto it = cellGraph.find(queue[i]);
+        if (it == cellGraph.end())
+            continue;
+        for (auto &dep : it->second.dependants) {
+            if (cells.insert(dep).second)
+                queue.push_back(dep);
+        }
+    }
+
+    // Any loop contains at least one cyclic edge, and both of its ends are
+    // involved if either one is.
+    for (auto &edge : cyclicEdges) {
+        if (cells.count(edge.first))
+            return false;
+    }
+
+    std::vector<std::pair<int, CellAddress> > sorted;
+    sorted.reserve(cells.size());
+    for (auto &addr : cells) {
+        auto it = cellGraph.find(addr);
+        sorted.emplace_back(it == cellGraph.end() ? -1 : it->second.order, addr);
+    }
+    std::sort(sorted.begin(), sorted.end());
+
+    order.reserve(sorted.size());
+    for (auto &v : sorted)
+        order.push_back(v.second);
+
+    if (levels) {
+        // The level of a cell is one more than the highest level of its inputs
+        std::unordered_map<CellAddress, int, CellHasher> cellLevels;
+        levels->reserve(order.size());
+        for (auto &addr : order) {
+            int level = 0;
+            auto it = cellGraph.find(addr);
+            if (it != cellGraph.end()) {
+                for (auto &input : it->second.inputs) {
+                    auto iter = cellLevels.find(input);
+                    if (iter != cellLevels.end() && iter->second >= level)
+                        level = iter->second + 1;
+                }
+            }
+            cellLevels[addr] = level;
+            levels->push_back(level);
+        }
+    }
+    return true;
+}
+
 /**
   * Recompute any cells that depend on \a prop.
   *
@@ -1165,7 +1458,7 @@ void PropertySheet::renamedDocumentObject(const App::DocumentObject * docObj)
     if (documentObjectName.find(docObj) == documentObjectName.end())
         return;
 
-    std::map<CellAddress, Cell* >::iterator i = data.begin();
+    CellStore::const_iterator i = data.begin();
 
     while (i != data.end()) {
         RelabelDocumentObjectExpressionVisitor<PropertySheet> v(*this, docObj);
@@ -23,7 +23,13 @@
 #ifndef PROPERTYSHEET_H
 #define PROPERTYSHEET_H
 
+#include <array>
+#include <iterator>
 #include <map>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include <App/DocumentObserver.h>
 #include <App/DocumentObject.h>
 #include <App/PropertyLinks.h>
@@ -37,6 +43,93 @@ class Sheet;
 class PropertySheet;
 class SheetObserver;
 
+/** Chunked storage of the cells of a PropertySheet
+ *
+ * The cells are stored row by row, with each row divided into chunks of
+ * ChunkSize consecutive columns that are only allocated when used. Look up
+ * is done by direct indexing, and iteration visits the cells in row major
+ * order, the same as a std::map keyed by CellAddress.
+ *
+ * The store does not own the cells.
+ */
+class SpreadsheetExport CellStore {
+public:
+    enum { ChunkSize = 16 };
+
+    typedef std::pair<App::CellAddress, Cell*> value_type;
+
+    class SpreadsheetExport const_iterator {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef CellStore::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const value_type *pointer;
+        typedef const value_type &reference;
+
+        const_iterator() : store(0), row(0), col(0) {}
+
+        reference operator*() const { return value; }
+        pointer operator->() const { return &value; }
+
+        const_iterator &operator++() {
+            ++col;
+            seek();
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator res(*this);
+            ++*this;
+            return res;
+        }
+
+        bool operator==(const const_iterator &other) const {
+            return row == other.row && col == other.col;
+        }
+
+        bool operator!=(const const_iterator &other) const {
+            return !(*this == other);
+        }
+
+    private:
+        const_iterator(const CellStore *store, int row, int col);
+        void seek();
+
+        friend class CellStore;
+
+        const CellStore *store;
+        int row;
+        int col;
+        value_type value;
+    };
+
+    typedef const_iterator iterator;
+
+    CellStore() {}
+
+    const_iterator begin() const { return const_iterator(this, 0, 0); }
+    const_iterator end() const { return const_iterator(this, static_cast<int>(rows.size()), 0); }
+    const_iterator find(App::CellAddress address) const;
+
+    /// Return the cell at \a address, or null if not exist
+    Cell *get(App::CellAddress address) const;
+
+    /// Return a reference to the cell slot at \a address, allocating it if necessary
+    Cell *&operator[](App::CellAddress address);
+
+    void erase(App::CellAddress address);
+    void erase(const_iterator it) { erase(it->first); }
+    void clear() { rows.clear(); }
+
+private:
+    CellStore(const CellStore &);
+    CellStore &operator=(const CellStore &);
+
+    typedef std::array<Cell*, ChunkSize> Chunk;
+    typedef std::vector<std::unique_ptr<Chunk> > Row;
+    std::vector<Row> rows;
+};
+
 class SpreadsheetExport PropertySheet : public App::PropertyExpressionContainer
                                       , private App::AtomicPropertyChangeInterface<PropertySheet> {
     TYPESYSTEM_HEADER();
@@ -159,6 +252,21 @@ public:
 
     void recomputeDependencies(App::CellAddress key);
 
+    /** Obtain the cells to be recomputed in evaluation order
+     *
+     * @param cells: the dirty cells. On return, it is expanded with all the
+     * cells that directly or indirectly depend on them.
+     * @param order: output the cells in @c cells sorted in dependency order.
+     * @param levels: optional output of the dependency level of each cell in
+     * @c order. Cells of the same level do not depend on each other.
+     *
+     * @return Return false if there is any cyclic dependency among the
+     * cells, in which case @c order is left empty.
+     */
+    bool getRecomputeOrder(std::set<App::CellAddress> &cells,
+                           std::vector<App::CellAddress> &order,
+                           std::vector<int> *levels = nullptr) const;
+
     PyObject *getPyObject(void);
     void setPyObject(PyObject *);
 
@@ -210,7 +318,7 @@ private:
     std::set<App::CellAddress> dirty;
 
     /*! Cell data in this property */
-    std::map<App::CellAddress, Cell*> data;
+    CellStore data;
 
     /*! Merged cells; cell -> anchor cell */
     std::map<App::CellAddress, App::CellAddress> mergedCells;
@@ -245,6 +353,47 @@ private:
     /*! DocumentObject this cell depends on */
     std::map<App::CellAddress, std::set< std::string > > cellToDocumentObjectMap;
 
+    /*
+     * Persistent dependency graph of cells within this sheet, with
+     * incrementally maintained topological order
+     */
+
+    struct CellHasher {
+        std::size_t operator()(const App::CellAddress &addr) const {
+            return (static_cast<std::size_t>(addr.row()) << 16) | addr.col();
+        }
+    };
+
+    typedef std::unordered_set<App::CellAddress, CellHasher> CellSet;
+
+    struct CellNode {
+        /*! Cells this cell depends on */
+        CellSet inputs;
+        /*! Cells depending on this cell */
+        CellSet dependants;
+        /*! Topological order, i.e. a cell has larger order than its inputs */
+        int order;
+    };
+
+    CellNode &getCellNode(App::CellAddress key);
+
+    void addCellEdge(App::CellAddress from, App::CellAddress to);
+
+    void removeCellEdges(App::CellAddress key);
+
+    bool isCyclicEdge(App::CellAddress from, App::CellAddress to) const {
+        return cyclicEdges.size() && cyclicEdges.count(std::make_pair(from,to));
+    }
+
+    /*! Cell dependency graph */
+    std::unordered_map<App::CellAddress, CellNode, CellHasher> cellGraph;
+
+    /*! Edges that close a dependency loop, excluded from the topological order */
+    std::set<std::pair<App::CellAddress, App::CellAddress> > cyclicEdges;
+
+    /*! Next order to assign to a new node in cellGraph */
+    int nextCellOrder = 0;
+
     /*! Mapping of cell position to alias property */
     std::map<App::CellAddress, std::string> aliasProp;
 
@@ -55,6 +55,9 @@
 #include <boost/regex.hpp>
 #include <boost/bind.hpp>
 #include <deque>
+#include <functional>
+#include <QRunnable>
+#include <QThreadPool>
 
 FC_LOG_LEVEL_INIT("Spreadsheet",true,true);
 
@@ -372,6 +375,36 @@ void Sheet::setCell(CellAddress address, const char * value)
     setContent(address, value);
 }
 
+/**
+  * Set a block of cells starting at \a from to \a values, given row by row.
+  * An empty value clears the corresponding cell.
+  *
+  * @param from    Address of the top left cell.
+  * @param values  Contents of the cells, one vector per row.
+  *
+  */
+
+void Sheet::setRange(CellAddress from, const std::vector<std::vector<std::string> > &values)
+{
+    if (from.row() + static_cast<int>(values.size()) > CellAddress::MAX_ROWS)
+        throw Base::ValueError("Too many rows");
+    for (auto &row : values) {
+        if (from.col() + static_cast<int>(row.size()) > CellAddress::MAX_COLUMNS)
+            throw Base::ValueError("Too many columns");
+    }
+
+    PropertySheet::AtomicPropertyChange signaller(cells);
+
+    int row = from.row();
+    for (auto &rowValues : values) {
+        int col = from.col();
+        for (auto &value : rowValues)
+            setCell(CellAddress(row, col++), value.c_str());
+        ++row;
+    }
+    signaller.tryInvoke();
+}
+
 /**
   * Get the Python object for the Sheet.
   *
@@ -668,17 +701,20 @@ struct CurrentAddressLock {
   *
   */
 
-void Sheet::updateProperty(CellAddress key)
+void Sheet::updateProperty(CellAddress key, ExpressionPtr &&value)
 {
     Cell * cell = getCell(key);
 
     if (cell != 0) {
-        std::unique_ptr<Expression> output;
+        std::unique_ptr<Expression> output = std::move(value);
         const Expression * input = cell->getExpression();
 
         if (input) {
-            CurrentAddressLock lock(currentRow,currentCol,key);
-            output = cells.eval(input);
+            // The value may have already been evaluated by recomputeCells()
+            if (!output) {
+                CurrentAddressLock lock(currentRow,currentCol,key);
+                output = cells.eval(input);
+            }
         }
         else {
             std::string s;
@@ -760,7 +796,7 @@ void Sheet::touchCells(Range range) {
  * @param p Address of cell.
  */
 
-void Sheet::recomputeCell(CellAddress p)
+void Sheet::recomputeCell(CellAddress p, ExpressionPtr &&value)
 {
     Cell * cell = cells.getValue(p);
 
@@ -771,7 +807,7 @@ void Sheet::recomputeCell(CellAddress p)
             cell->setContent(content.c_str());
         }
 
-        updateProperty(p);
+        updateProperty(p, std::move(value));
 
         if(!cell || !cell->hasException()) {
             cells.clearDirty(p);
@@ -801,6 +837,102 @@ void Sheet::recomputeCell(CellAddress p)
         cellSpanChanged(p);
 }
 
+namespace {
+class CellRunnable : public QRunnable
+{
+public:
+    CellRunnable(const std::function<void()> &func)
+        :func(func)
+    {}
+
+    virtual void run() {
+        func();
+    }
+
+private:
+    std::function<void()> func;
+};
+}
+
+/**
+  * Recompute the cells in \a order, with \a levels being the dependency level
+  * of each cell.
+  *
+  * If parallel recompute is enabled, the expressions of cells in the same
+  * level are evaluated concurrently, provided that they can be evaluated
+  * natively without Python (see App::Expression::NativeEvaluation). Only the
+  * numeric evaluation runs in the worker threads. Preparing the evaluation,
+  * creating the result expressions, assigning them to the cell properties and
+  * emitting the cell update signals are done in the main thread. Cells that
+  * cannot be evaluated natively are recomputed in the main thread as usual.
+  *
+  */
+
+void Sheet::recomputeCells(const std::vector<CellAddress> &order, const std::vector<int> &levels)
+{
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Mod/Spreadsheet");
+    const std::size_t minCells = static_cast<std::size_t>(
+            std::max(1L, hGrp->GetInt("ParallelRecomputeMinCells", 64)));
+
+    if (!hGrp->GetBool("ParallelRecompute", false)
+            || PythonMode.getValue()
+            || order.size() < minCells)
+    {
+        for (auto &addr : order) {
+            FC_LOG(addr.toString());
+            recomputeCell(addr);
+        }
+        return;
+    }
+
+    // Group the cells by level, keeping the recompute order within each level
+    std::vector<std::vector<CellAddress> > cellLevels;
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        if (levels[i] >= static_cast<int>(cellLevels.size()))
+            cellLevels.resize(levels[i] + 1);
+        cellLevels[levels[i]].push_back(order[i]);
+    }
+
+    QThreadPool pool;
+    int threads = hGrp->GetInt("RecomputeThreads", 0);
+    if (threads > 0)
+        pool.setMaxThreadCount(threads);
+
+    std::vector<Expression::NativeEvaluation> evals;
+    for (auto &addrs : cellLevels) {
+        evals.clear();
+
+        if (addrs.size() >= minCells) {
+            evals.reserve(addrs.size());
+            for (auto &addr : addrs) {
+                Cell * cell = getCell(addr);
+                // Cells with exception are reset before evaluation in recomputeCell()
+                if (cell && !cell->hasException())
+                    evals.emplace_back(cell->getExpression());
+                else
+                    evals.emplace_back();
+            }
+
+            std::size_t count = std::max<std::size_t>(1,
+                    addrs.size() / static_cast<std::size_t>(std::max(1, pool.maxThreadCount() * 4)));
+            for (std::size_t start = 0; start < addrs.size(); start += count) {
+                std::size_t end = std::min(start + count, addrs.size());
+                pool.start(new CellRunnable([&evals, start, end]() {
+                    for (std::size_t i = start; i < end; ++i)
+                        evals[i].run();
+                }));
+            }
+            pool.waitForDone();
+        }
+
+        for (std::size_t i = 0; i < addrs.size(); ++i) {
+            FC_LOG(addrs[i].toString());
+            recomputeCell(addrs[i], i < evals.size() ? evals[i].getResult() : ExpressionPtr());
+        }
+    }
+}
+
 /**
   * Update the document properties.
   *
@@ -820,54 +952,22 @@ DocumentObjectExecReturn *Sheet::execute(void)
          dirtyCells.insert(*i);
     }
 
-    DependencyList graph;
-    std::map<CellAddress, Vertex> VertexList;
-    std::map<Vertex, CellAddress> VertexIndexList;
-    std::deque<CellAddress> workQueue(dirtyCells.begin(),dirtyCells.end());
-    while(workQueue.size()) {
-        CellAddress currPos = workQueue.front();
-        workQueue.pop_front();
-
-        // Insert into map of CellPos -> Index, if it doesn't exist already
-        auto res = VertexList.emplace(currPos,Vertex());
-        if(res.second) {
-            res.first->second = add_vertex(graph);
-            VertexIndexList[res.first->second] = currPos;
-        }
-
-        // Process cells that depend on the current cell
-        for(auto &dep : providesTo(currPos)) {
-            auto resDep = VertexList.emplace(dep,Vertex());
-            if(resDep.second) {
-                resDep.first->second = add_vertex(graph);
-                VertexIndexList[resDep.first->second] = dep;
-                if(dirtyCells.insert(dep).second)
-                    workQueue.push_back(dep);
-            }
-            // Add edge to graph to signal dependency
-            add_edge(res.first->second, resDep.first->second, graph);
-        }
-    }
-    // Compute cells
-    std::list<Vertex> make_order;
-    // Sort graph topologically to find evaluation order
-    try {
-        boost::topological_sort(graph, std::front_inserter(make_order));
+    // Obtain the evaluation order from the cell dependency graph maintained
+    // by PropertySheet, which also expands dirtyCells with their dependants
+    std::vector<CellAddress> make_order;
+    std::vector<int> levels;
+    if (cells.getRecomputeOrder(dirtyCells, make_order, &levels)) {
         // Recompute cells
         FC_LOG("recomputing " << getFullName());
-        for(auto &pos : make_order) {
-            const auto &addr = VertexIndexList[pos];
-            FC_LOG(addr.toString());
-            recomputeCell(addr);
-        }
-    } catch (std::exception &) {
-        for(auto &v : VertexList) {
-            Cell * cell = cells.getValue(v.first);
+        recomputeCells(make_order, levels);
+    } else {
+        for(auto &addr : dirtyCells) {
+            Cell * cell = cells.getValue(addr);
             // Mark as erroneous
             if(cell)  {
-                cellErrors.insert(v.first);
+                cellErrors.insert(addr);
                 cell->setException("Pending computation due to cyclic dependency",true);
-                cellUpdated(v.first);
+                cellUpdated(addr);
             }
         }
 
@@ -103,6 +103,8 @@ public:
 
     void setCell(App::CellAddress address, const char *value);
 
+    void setRange(App::CellAddress from, const std::vector<std::vector<std::string> > &values);
+
     void clearAll();
 
     void clear(App::CellAddress address, bool all = true);
@@ -205,7 +207,9 @@ protected:
 
     void onDocumentRestored();
 
-    void recomputeCell(App::CellAddress p);
+    void recomputeCell(App::CellAddress p, App::ExpressionPtr &&value = App::ExpressionPtr());
+
+    void recomputeCells(const std::vector<App::CellAddress> &order, const std::vector<int> &levels);
 
     App::Property *getProperty(App::CellAddress key) const;
 
@@ -213,7 +217,7 @@ protected:
 
     void updateAlias(App::CellAddress key);
 
-    void updateProperty(App::CellAddress key);
+    void updateProperty(App::CellAddress key, App::ExpressionPtr &&value = App::ExpressionPtr());
 
     App::Property *setStringProperty(App::CellAddress key, const std::string & value) ;
 
@@ -132,6 +132,92 @@ PyObject* SheetPy::get(PyObject *args)
     return prop->getPyObject();
 }
 
+static bool isRangeRow(PyObject *obj)
+{
+    return PySequence_Check(obj) && !PyUnicode_Check(obj) && !PyBytes_Check(obj);
+}
+
+static void getRangeRow(const Py::Object &pyRow, std::vector<std::string> &row)
+{
+    Py::Sequence seq(pyRow);
+    row.reserve(seq.size());
+    for (Py::Sequence::size_type i = 0; i < seq.size(); ++i) {
+        Py::Object item(seq[i]);
+        if (item.isNone())
+            row.emplace_back();
+        else
+            row.push_back(item.as_string());
+    }
+}
+
+PyObject* SheetPy::setRange(PyObject *args)
+{
+    const char *address;
+    PyObject *pyValues;
+
+    if (!PyArg_ParseTuple(args, "sO:setRange", &address, &pyValues))
+        return 0;
+
+    if (!isRangeRow(pyValues)) {
+        PyErr_SetString(PyExc_TypeError, "Expect a sequence of values");
+        return 0;
+    }
+
+    PY_TRY {
+        Sheet * sheet = getSheetPtr();
+        std::string cellAddress = sheet->getAddressFromAlias(address);
+        CellAddress from(cellAddress.size() ? cellAddress.c_str() : address);
+
+        std::vector<std::vector<std::string> > values;
+        Py::Sequence seq(pyValues);
+        if (seq.size() && isRangeRow(Py::Object(seq[0]).ptr())) {
+            values.resize(seq.size());
+            for (Py::Sequence::size_type i = 0; i < seq.size(); ++i) {
+                Py::Object pyRow(seq[i]);
+                if (!isRangeRow(pyRow.ptr()))
+                    throw Py::TypeError("Expect a sequence of rows");
+                getRangeRow(pyRow, values[i]);
+            }
+        }
+        else {
+            values.resize(1);
+            getRangeRow(seq, values[0]);
+        }
+
+        sheet->setRange(from, values);
+        Py_Return;
+    } PY_CATCH
+}
+
+PyObject* SheetPy::getRange(PyObject *args)
+{
+    const char *strRange;
+
+    if (!PyArg_ParseTuple(args, "s:getRange", &strRange))
+        return 0;
+
+    PY_TRY {
+        Sheet * sheet = getSheetPtr();
+        Range range(strRange);
+        CellAddress from = range.from();
+        CellAddress to = range.to();
+
+        Py::Tuple rows(to.row() - from.row() + 1);
+        for (int row = from.row(); row <= to.row(); ++row) {
+            Py::Tuple values(to.col() - from.col() + 1);
+            for (int col = from.col(); col <= to.col(); ++col) {
+                App::Property *prop = sheet->getPropertyByName(CellAddress(row, col).toString().c_str());
+                if (prop)
+                    values.setItem(col - from.col(), Py::asObject(prop->getPyObject()));
+                else
+                    values.setItem(col - from.col(), Py::None());
+            }
+            rows.setItem(row - from.row(), values);
+        }
+        return Py::new_reference_to(rows);
+    } PY_CATCH
+}
+
 PyObject* SheetPy::getContents(PyObject *args)
 {
     char *strAddress;
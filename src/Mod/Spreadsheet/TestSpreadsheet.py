@@ -1006,6 +1006,115 @@ class SpreadsheetCases(unittest.TestCase):
         self.doc.recompute()
         self.assertEqual(sheet.get('C1'), Units.Quantity('3 mm'))
 
+    def testDependencyOrder(self):
+        """ Test recompute order and loop detection of the incrementally maintained cell dependency graph """
+        sheet = self.doc.addObject('Spreadsheet::Sheet','Spreadsheet')
+        # Add the cells in reverse order of dependency to force reordering
+        for i in range(10, 1, -1):
+            sheet.set('A%d' % i, '=A%d + 1' % (i-1))
+        sheet.set('A1', '1')
+        sheet.set('B1', '=A5 + A10')
+        self.doc.recompute()
+        self.assertEqual(sheet.A10, 10)
+        self.assertEqual(sheet.B1, 15)
+
+        # Close a dependency loop
+        sheet.set('A1', '=A10')
+        self.doc.recompute()
+        self.assertTrue('Invalid' in sheet.State)
+        self.assertTrue(sheet.getContents('A1').startswith('=A10'))
+
+        # Break the loop again
+        sheet.set('A1', '5')
+        self.doc.recompute()
+        self.assertFalse('Invalid' in sheet.State)
+        self.assertEqual(sheet.A10, 14)
+        self.assertEqual(sheet.B1, 23)
+
+        # Edit the head of a long chain of cells
+        count = 200
+        for i in range(2, count + 1):
+            sheet.set('C%d' % i, '=C%d + 1' % (i-1))
+        sheet.set('C1', '1')
+        self.doc.recompute()
+        sheet.set('C1', '2')
+        self.doc.recompute()
+        self.assertEqual(sheet.get('C%d' % count), count + 1)
+
+    def testRange(self):
+        """ Test bulk setting and getting of cell ranges """
+        sheet = self.doc.addObject('Spreadsheet::Sheet','Spreadsheet')
+        sheet.setRange('B2', [[1, 2.5, 'abc'], (4, None, '=B2 + C2')])
+        sheet.setRange('A10', [7, 8])
+        self.doc.recompute()
+        self.assertEqual(sheet.getContents('D2'), 'abc')
+        self.assertEqual(sheet.getRange('B2:D3'), ((1, 2.5, 'abc'), (4, None, 3.5)))
+        self.assertEqual(sheet.getRange('A10:B10'), ((7, 8),))
+
+        # None clears the cell
+        sheet.setRange('B2', [None])
+        self.doc.recompute()
+        self.assertEqual(sheet.getContents('B2'), '')
+        self.assertEqual(sheet.getRange('B2:C2'), ((None, 2.5),))
+
+        with self.assertRaises(TypeError):
+            sheet.setRange('A1', 'abc')
+
+    def testImportLarge(self):
+        """ Test importing a large file """
+        rows = 500
+        filename = self.TempPath + os.sep + 'large.csv'
+        with open(filename, 'w') as f:
+            for i in range(rows):
+                f.write('\t'.join(str(i * 10 + j) for j in range(10)) + '\n')
+        sheet = self.doc.addObject('Spreadsheet::Sheet','Spreadsheet')
+        sheet.importFile(filename)
+        self.doc.recompute()
+        os.remove(filename)
+        self.assertEqual(sheet.getContents('J%d' % rows), str(rows * 10 - 1))
+        self.assertEqual(sheet.getRange('A%d:B%d' % (rows, rows)), ((rows * 10 - 10, rows * 10 - 9),))
+
+    def testParallelRecompute(self):
+        """ Test that parallel cell evaluation gives the same result as serial evaluation """
+        param = FreeCAD.ParamGet('User parameter:BaseApp/Preferences/Mod/Spreadsheet')
+        parallel = param.GetBool('ParallelRecompute', False)
+        minCells = param.GetInt('ParallelRecomputeMinCells', 64)
+        sheet = self.doc.addObject('Spreadsheet::Sheet','Spreadsheet')
+        obj = self.doc.addObject('App::FeatureTest','Test')
+        rows = 100
+        for i in range(1, rows + 1):
+            sheet.set('A%d' % i, str(i))
+            sheet.set('B%d' % i, '=sqrt(A%d) * 2 + A%d ^ 2' % (i, i))
+            sheet.set('C%d' % i, '=B%d - A%d' % (i, i))
+            sheet.set('D%d' % i, '=A%d > %d' % (i, rows // 2))
+            sheet.set('E%d' % i, '=Test.Float * A%d + Test.Integer' % i)
+        # mixed in with an expression requiring Python evaluation
+        sheet.set('F1', '=Spreadsheet.Label')
+        # and with an error, which is reported by the serial evaluation
+        sheet.set('F2', '=A1 + 1 mm')
+        try:
+            results = []
+            for enable in (False, True):
+                param.SetBool('ParallelRecompute', enable)
+                param.SetInt('ParallelRecomputeMinCells', 16)
+                sheet.touchCells('A1', 'A%d' % rows)
+                self.doc.recompute()
+                results.append(sheet.getRange('A1:E%d' % rows))
+                self.assertEqual(sheet.F1, 'Spreadsheet')
+                self.assertTrue(sheet.F2.startswith('ERR:'))
+            self.assertEqual(results[0], results[1])
+            self.assertAlmostEqual(sheet.C4, 16)
+            self.assertEqual(sheet.D1, False)
+            self.assertEqual(sheet.getContents('D%d' % rows), '=A%d > %d' % (rows, rows // 2))
+            self.assertEqual(sheet.get('D%d' % rows), True)
+
+            # parallel evaluation picks up changes of other objects
+            obj.Float = 2
+            self.doc.recompute()
+            self.assertAlmostEqual(sheet.get('E%d' % rows), 2 * rows + obj.Integer)
+        finally:
+            param.SetBool('ParallelRecompute', parallel)
+            param.SetInt('ParallelRecomputeMinCells', minCells)
 
     def tearDown(self):
         #closing doc
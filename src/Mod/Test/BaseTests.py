@@ -157,6 +157,30 @@ class ParameterTestCase(unittest.TestCase):
         self.TestPar.RemString("44")
         self.failUnless(self.TestPar.GetString("44","hallo") == "hallo","Deletion error at String")
 
+    def testIndex(self):
+        grp = self.TestPar.GetGroup("Index")
+        grp.Clear()
+        for i in range(200):
+            grp.SetInt("Int%d" % i, i)
+        grp.SetBool("Int199", True)
+        self.assertEqual(grp.GetInt("Int199"), 199)
+        self.assertEqual(grp.GetBool("Int199"), True)
+        grp.SetInt("Int199", 4711)
+        self.assertEqual(grp.GetInt("Int199"), 4711)
+        self.assertEqual(len(grp.GetInts()), 200)
+        grp.RemInt("Int199")
+        self.assertEqual(grp.GetInt("Int199", -1), -1)
+        self.assertEqual(grp.GetBool("Int199"), True)
+        grp.SetString("Text", "")
+        self.assertEqual(grp.GetString("Text", "preset"), "")
+
+        # groups looked up by path are the same as the ones looked up one by one
+        sub = FreeCAD.ParamGet("System parameter:Test//Index/Sub/")
+        sub.SetInt("Value", 1)
+        self.assertEqual(self.TestPar.GetGroup("Index").GetGroup("Sub").GetInt("Value"), 1)
+        del sub
+        grp.Clear()
+
     def testMatrix(self):
         m=FreeCAD.Matrix(4,2,1,0,1,1,1,0,0,0,1,0,0,0,0,1)
         u=m.multiply(m.inverse())
@@ -0,0 +1,258 @@
+#***************************************************************************
+#*   This program is free software; you can redistribute it and/or modify  *
+#*   it under the terms of the GNU Lesser General Public License (LGPL)    *
+#*   as published by the Free Software Foundation; either version 2 of     *
+#*   the License, or (at your option) any later version.                   *
+#*   for detail see the LICENCE text file.                                 *
+#*                                                                         *
+#*   FreeCAD is distributed in the hope that it will be useful,            *
+#*   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+#*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+#*   GNU Library General Public License for more details.                  *
+#*                                                                         *
+#*   You should have received a copy of the GNU Library General Public     *
+#*   License along with FreeCAD; if not, write to the Free Software        *
+#*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+#*   USA                                                                   *
+#***************************************************************************/
+
+# Performance benchmarks. These are not part of the unit tests and must be
+# run explicitly, e.g.
+#
+#   import Benchmarks
+#   Benchmarks.run()             # run all benchmarks
+#   Benchmarks.run("StringHasher")
+
+import FreeCAD
+
+def report(name, msg):
+  FreeCAD.Console.PrintMessage("%s: %s\n" % (name, msg))
+
+def benchStringHasher(objects=8, strings=100000):
+  '''Throughput of StringHasher.getID() by objects recomputed serially and in parallel'''
+  import time
+  param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+  parallel = param.GetBool('ParallelRecompute', False)
+  timing = {}
+  try:
+    for enable in (False, True):
+      param.SetBool('ParallelRecompute', enable)
+      doc = FreeCAD.newDocument("StringHasherBenchmark")
+      try:
+        for i in range(objects):
+          doc.addObject('App::FeatureTest', 'Hash').HashCount = strings
+        start = time.time()
+        doc.recompute()
+        timing[enable] = time.time() - start
+      finally:
+        FreeCAD.closeDocument(doc.Name)
+  finally:
+    param.SetBool('ParallelRecompute', parallel)
+  count = objects * strings
+  report("StringHasher", "getID() by %d objects, serial: %.0f/s, parallel: %.0f/s" \
+      % (objects, count/timing[False], count/timing[True]))
+
+def benchBinaryPropertyStream(count=500):
+  '''Loading of property data stored as XML files and as a binary stream'''
+  import os, tempfile, time
+  doc = FreeCAD.newDocument("BinaryStreamBenchmark")
+  for i in range(count):
+    obj = doc.addObject("App::FeatureTest","Bench")
+    obj.Placement = FreeCAD.Placement(FreeCAD.Vector(i,1,2),FreeCAD.Rotation(10,20,i))
+    obj.VectorList = [FreeCAD.Vector(i,j,0) for j in range(20)]
+    obj.FloatList = [i*0.1+j for j in range(20)]
+    obj.ColourList = [(i*0.001,j*0.05,0.5) for j in range(20)]
+  fd, path = tempfile.mkstemp(suffix=".FCStd")
+  os.close(fd)
+  param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+  binary = param.GetBool("BinaryPropertyStream", False)
+  timing = {}
+  try:
+    for enable in (False, True):
+      param.SetBool("BinaryPropertyStream", enable)
+      doc.saveAs(path)
+      FreeCAD.closeDocument(doc.Name)
+      start = time.time()
+      doc = FreeCAD.open(path)
+      timing[enable] = time.time() - start
+  finally:
+    param.SetBool("BinaryPropertyStream", binary)
+    FreeCAD.closeDocument(doc.Name)
+    os.remove(path)
+  report("BinaryPropertyStream", "loading %d objects, XML: %.3fs, binary stream: %.3fs" \
+      % (count, timing[False], timing[True]))
+
+def benchNativeEvaluation(count=200, repeat=10):
+  '''Recompute of a chain of numeric expressions with and without native evaluation'''
+  import time
+  doc = FreeCAD.newDocument("ExpressionBenchmark")
+  param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Expression")
+  native = param.GetBool("NativeEvaluation", True)
+  timing = {}
+  try:
+    first = doc.addObject("App::FeatureTest","Chain")
+    prev = first
+    for _ in range(count):
+      obj = doc.addObject("App::FeatureTest","Chain")
+      obj.setExpression('Float', '%s.Float * 1.0001 + sin(%s.Angle) / 10' % (prev.Name, prev.Name))
+      obj.setExpression('Distance', '%s.Distance + 1 mm * (%s.Integer > 0 ? 1 : 2)' % (prev.Name, prev.Name))
+      prev = obj
+    for mode in (False, True):
+      param.SetBool("NativeEvaluation", mode)
+      start = time.time()
+      for i in range(repeat):
+        first.Float = 47.11 + i
+        doc.recompute()
+      timing[mode] = time.time() - start
+  finally:
+    param.SetBool("NativeEvaluation", native)
+    FreeCAD.closeDocument(doc.Name)
+  report("NativeEvaluation", "expression recompute, python: %.3fs, native: %.3fs" \
+      % (timing[False], timing[True]))
+
+def benchSpreadsheetChain(count=2000):
+  '''Recompute after editing the head of a long chain of spreadsheet cells'''
+  import time
+  doc = FreeCAD.newDocument("SpreadsheetBenchmark")
+  try:
+    sheet = doc.addObject('Spreadsheet::Sheet','Spreadsheet')
+    for i in range(2, count + 1):
+      sheet.set('A%d' % i, '=A%d + 1' % (i-1))
+    sheet.set('A1', '1')
+    doc.recompute()
+    start = time.time()
+    sheet.set('A1', '2')
+    doc.recompute()
+    duration = time.time() - start
+  finally:
+    FreeCAD.closeDocument(doc.Name)
+  report("SpreadsheetChain", "recompute of %d chained cells: %.3fs" % (count, duration))
+
+def benchSpreadsheetImport(rows=5000):
+  '''Import and recompute of a large tab separated file into a spreadsheet'''
+  import os, tempfile, time
+  fd, filename = tempfile.mkstemp(suffix=".csv")
+  with os.fdopen(fd, 'w') as f:
+    for i in range(rows):
+      f.write('\t'.join(str(i * 10 + j) for j in range(10)) + '\n')
+  doc = FreeCAD.newDocument("SpreadsheetBenchmark")
+  try:
+    sheet = doc.addObject('Spreadsheet::Sheet','Spreadsheet')
+    start = time.time()
+    sheet.importFile(filename)
+    doc.recompute()
+    duration = time.time() - start
+  finally:
+    FreeCAD.closeDocument(doc.Name)
+    os.remove(filename)
+  report("SpreadsheetImport", "import of %d cells: %.3fs" % (rows * 10, duration))
+
+def benchSpreadsheetParallel(rows=5000):
+  '''Serial and parallel recompute of independent spreadsheet cells'''
+  import time
+  param = FreeCAD.ParamGet('User parameter:BaseApp/Preferences/Mod/Spreadsheet')
+  parallel = param.GetBool('ParallelRecompute', False)
+  doc = FreeCAD.newDocument("SpreadsheetBenchmark")
+  timing = {}
+  try:
+    sheet = doc.addObject('Spreadsheet::Sheet','Spreadsheet')
+    for i in range(1, rows + 1):
+      sheet.set('A%d' % i, str(i))
+      sheet.set('B%d' % i, '=sqrt(A%d) * 2 + A%d ^ 2' % (i, i))
+      sheet.set('C%d' % i, '=B%d - A%d' % (i, i))
+    for enable in (False, True):
+      param.SetBool('ParallelRecompute', enable)
+      sheet.touchCells('A1', 'A%d' % rows)
+      start = time.time()
+      doc.recompute()
+      timing[enable] = time.time() - start
+  finally:
+    param.SetBool('ParallelRecompute', parallel)
+    FreeCAD.closeDocument(doc.Name)
+  report("SpreadsheetParallel", "recompute of %d cells, serial: %.3fs, parallel: %.3fs" \
+      % (rows * 3, timing[False], timing[True]))
+
+def benchBulkChange(count=1000):
+  '''Setting properties of many objects one by one and in bulk'''
+  import time
+  doc = FreeCAD.newDocument("BulkChangeBenchmark")
+  try:
+    objs = [doc.addObject('App::FeatureTest','Bulk') for i in range(count)]
+    start = time.time()
+    for i, o in enumerate(objs):
+      o.Placement = FreeCAD.Placement(FreeCAD.Vector(i, 0, 0), FreeCAD.Rotation())
+    duration = time.time() - start
+    start = time.time()
+    doc.setPropertiesBulk({o: {'Placement': FreeCAD.Placement(FreeCAD.Vector(0, i, 0), FreeCAD.Rotation())} \
+        for i, o in enumerate(objs)})
+    bulkDuration = time.time() - start
+  finally:
+    FreeCAD.closeDocument(doc.Name)
+  report("BulkChange", "setting %d placements, single: %.3fs, bulk: %.3fs" \
+      % (count, duration, bulkDuration))
+
+def benchParameter(entries=200, count=100000):
+  '''Lookup of a parameter in a group and of a group by its path'''
+  import time
+  root = FreeCAD.ParamGet("System parameter:Benchmark")
+  grp = root.GetGroup("Parameter")
+  try:
+    for i in range(entries):
+      grp.SetInt("Int%d" % i, i)
+    grp.GetGroup("Sub")
+    name = "Int%d" % (entries-1)
+    start = time.time()
+    for i in range(count):
+      grp.GetInt(name)
+    lookup = time.time() - start
+    start = time.time()
+    for i in range(count):
+      FreeCAD.ParamGet("System parameter:Benchmark/Parameter/Sub")
+    path = time.time() - start
+  finally:
+    root.RemGroup("Parameter")
+  report("Parameter", "GetInt() in group of %d: %.0f/s, ParamGet(): %.0f/s" \
+      % (entries, count/lookup, count/path))
+
+def benchBooleanOptions(count=10):
+  '''Boolean operations with the default options and with prefiltering, oriented
+  bound boxes and gluing'''
+  import time
+  import Part
+  V = FreeCAD.Vector
+  plate = Part.makeBox(count*10+10, count*10+10, 5)
+  holes = []
+  for i in range(count):
+    for j in range(count):
+      holes.append(Part.makeCylinder(3, 7, V(10+i*10, 10+j*10, -1)))
+      holes.append(Part.makeCylinder(3, 7, V(10+i*10, 10+j*10, 100)))
+  boxes = [Part.makeBox(1, 1, 1, V(i, 0, 0)) for i in range(count*3)]
+  boxes += [Part.makeBox(1, 1, 1, V(i*2, 5, 0)) for i in range(count)]
+  bar = Part.makeBox(100, 1, 1)
+  bar.rotate(V(), V(0,0,1), 45)
+  bars = []
+  for i in range(count*2):
+    tool = Part.makeBox(100, 1, 1, V(0, 2+i*2, 0))
+    tool.rotate(V(), V(0,0,1), 45)
+    bars.append(tool)
+  cases = (("cut holes", lambda **kw: plate.cut(holes, **kw), {'prefilter':True, 'useOBB':True}),
+           ("fuse touching", lambda **kw: boxes[0].fuse(boxes[1:], **kw), {'glue':1, 'prefilter':True}),
+           ("common rotated", lambda **kw: bar.common(bars, **kw), {'useOBB':True, 'prefilter':True}))
+  for name, func, options in cases:
+    timing = []
+    for kwargs in ({}, options):
+      start = time.time()
+      func(**kwargs)
+      timing.append(time.time() - start)
+    report("BooleanOptions", "%s, default: %.3fs, with %s: %.3fs" \
+        % (name, timing[0], options, timing[1]))
+
+def run(*names):
+  '''Run the benchmarks with the given names, or all of them if none given'''
+  for name, func in sorted(globals().items()):
+    if name.startswith("bench") and callable(func) \
+        and (not names or name[5:] in names):
+      func()
+
+if __name__ == "__main__":
+  run()
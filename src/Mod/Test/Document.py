@@ -211,6 +211,26 @@ class DocumentBasicCases(unittest.TestCase):
     cpy = self.Doc.copyObject(obj)
     self.assertListEqual(obj.PlmList, cpy.PlmList)
 
+  def testStringHasherConcurrency(self):
+    param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+    parallel = param.GetBool("ParallelRecompute",False)
+    param.SetBool("ParallelRecompute",True)
+    try:
+      hasher = self.Doc.Hasher
+      size = hasher.Size
+      objs = [self.Doc.addObject("App::FeatureTest","Hash") for i in range(8)]
+      for obj in objs:
+        obj.HashCount = 1000
+      self.Doc.recompute()
+      for obj in objs:
+        self.failUnless(obj.ExecCount == 1)
+      # strings mapped concurrently by all objects must only be added once
+      self.assertEqual(hasher.Size, size+1000)
+      sid = hasher.getID("FeatureTestHash10")
+      self.assertEqual(hasher.getID(sid.Value).Value, sid.Value)
+    finally:
+      param.SetBool("ParallelRecompute",parallel)
+
   def testAddRemove(self):
     L1 = self.Doc.addObject("App::FeatureTest","Label_1")
     # must delete object
@@ -517,6 +537,78 @@ class DocumentSaveRestoreCases(unittest.TestCase):
     self.assertEqual(self.Doc.Label_1.Vector, Doc.Label_1.Vector)
     FreeCAD.closeDocument("DumpTest")
 
+  def testParallelSave(self):
+    import zipfile
+    SaveName = self.TempPath + os.sep + "ParallelSaveTests.FCStd"
+    self.Doc.Label_1.Link = self.Doc.Label_2
+    self.Doc.Label_1.String = 'test'
+    param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+    parallel = param.GetBool("ParallelSave", False)
+    compression = param.GetInt("CompressionLevel", 3)
+    try:
+      param.SetBool("ParallelSave", True)
+      for level in (0, 3):
+        param.SetInt("CompressionLevel", level)
+        self.Doc.saveAs(SaveName)
+        with zipfile.ZipFile(SaveName) as z:
+          self.assertIsNone(z.testzip())
+          self.assertEqual(z.namelist()[0], "Document.xml")
+          if level == 0:
+            for info in z.infolist():
+              self.assertEqual(info.compress_type, zipfile.ZIP_STORED)
+        FreeCAD.closeDocument("SaveRestoreTests")
+        self.Doc = FreeCAD.open(SaveName)
+        self.assertEqual(self.Doc.Label_1.Link, self.Doc.Label_2)
+        self.assertEqual(self.Doc.Label_1.String, 'test')
+    finally:
+      param.SetBool("ParallelSave", parallel)
+      param.SetInt("CompressionLevel", compression)
+
+  def testBackgroundSave(self):
+    SaveName = self.TempPath + os.sep + "BackgroundSaveTests.FCStd"
+    self.Doc.saveAs(SaveName)
+    self.Doc.Label_1.String = 'saved'
+    self.Doc.save(True)
+    # modification after save must not affect the saved snapshot
+    self.Doc.Label_1.String = 'modified'
+    # closing the document waits for the saving to finish
+    FreeCAD.closeDocument("SaveRestoreTests")
+    self.Doc = FreeCAD.open(SaveName)
+    self.assertEqual(self.Doc.Label_1.String, 'saved')
+
+  def testBinaryPropertyStream(self):
+    import zipfile
+    count = 50
+    SaveName = self.TempPath + os.sep + "BinaryStreamTests.FCStd"
+    for i in range(count):
+      obj = self.Doc.addObject("App::FeatureTest","Item")
+      obj.Placement = FreeCAD.Placement(FreeCAD.Vector(i,1,2),FreeCAD.Rotation(10,20,i))
+      obj.VectorList = [FreeCAD.Vector(i,j,0) for j in range(20)]
+      obj.FloatList = [i*0.1+j for j in range(20)]
+      obj.ColourList = [(0.1,0.2,0.3,0.0)]*20
+    self.Doc.Label_1.Placement = FreeCAD.Placement(FreeCAD.Vector(1,2,3),FreeCAD.Rotation(1,2,3))
+    placement = self.Doc.Label_1.Placement
+    param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+    binary = param.GetBool("BinaryPropertyStream", False)
+    try:
+      for enable in (False, True):
+        param.SetBool("BinaryPropertyStream", enable)
+        self.Doc.saveAs(SaveName)
+        with zipfile.ZipFile(SaveName) as z:
+          self.assertEqual("Document.bin" in z.namelist(), enable)
+        FreeCAD.closeDocument("SaveRestoreTests")
+        self.Doc = FreeCAD.open(SaveName)
+        self.assertEqual(self.Doc.Label_1.Placement.Base, placement.Base)
+        for q1, q2 in zip(self.Doc.Label_1.Placement.Rotation.Q, placement.Rotation.Q):
+          self.assertAlmostEqual(q1, q2)
+        obj = self.Doc.getObject("Item%03d" % (count-1))
+        self.assertEqual(obj.Placement.Base, FreeCAD.Vector(count-1,1,2))
+        self.assertEqual(obj.VectorList[-1], FreeCAD.Vector(count-1,19,0))
+        self.assertAlmostEqual(obj.FloatList[-1], (count-1)*0.1+19)
+        self.assertEqual(len(obj.ColourList), 20)
+    finally:
+      param.SetBool("BinaryPropertyStream", binary)
+
   def tearDown(self):
     #closing doc
     FreeCAD.closeDocument("SaveRestoreTests")
@@ -608,6 +700,124 @@ class DocumentRecomputeCases(unittest.TestCase):
     self.Doc.removeObject(L7.Name)
     self.Doc.removeObject(L8.Name)
 
+  def testRecomputeTouched(self):
+    # diamond shaped dependency, plus an unrelated object
+    #      A
+    #     / \
+    #    B   C
+    #     \ /
+    #      D      E
+    A = self.Doc.addObject("App::FeatureTest","A")
+    B = self.Doc.addObject("App::FeatureTest","B")
+    C = self.Doc.addObject("App::FeatureTest","C")
+    D = self.Doc.addObject("App::FeatureTest","D")
+    E = self.Doc.addObject("App::FeatureTest","E")
+    A.LinkList = [B,C]
+    B.Link = D
+    C.Link = D
+    self.Doc.recompute()
+    self.failUnless((1,1,1,1,1)==(A.ExecCount,B.ExecCount,C.ExecCount,D.ExecCount,E.ExecCount))
+
+    # only the touched object and its dependents are recomputed, in dependency order
+    D.touch()
+    profiling = FreeCAD.setRecomputeProfiler(True)
+    try:
+      self.failUnless(self.Doc.recompute()==4)
+      execs = [p['Object'] for p in self.Doc.recomputeProfile() \
+                if p['Name'] == 'execute' and p['Category'] == 'DocumentObject']
+    finally:
+      FreeCAD.setRecomputeProfiler(profiling)
+    self.failUnless((2,2,2,2,1)==(A.ExecCount,B.ExecCount,C.ExecCount,D.ExecCount,E.ExecCount))
+    self.failUnless(len(execs) == 4)
+    self.failUnless(execs[0] == D.FullName)
+    self.failUnless(execs[3] == A.FullName)
+
+    C.touch()
+    self.failUnless(self.Doc.recompute()==2)
+    self.failUnless((3,2,3,2,1)==(A.ExecCount,B.ExecCount,C.ExecCount,D.ExecCount,E.ExecCount))
+
+  def testRecomputeCycle(self):
+    L1 = self.Doc.addObject("App::FeatureTest","Cycle_1")
+    L2 = self.Doc.addObject("App::FeatureTest","Cycle_2")
+    L3 = self.Doc.addObject("App::FeatureTest","Cycle_3")
+    L1.Link = L2
+    L2.Link = L3
+    L3.Link = L1
+    L1.touch()
+    # the touched sub graph is not sortable, and the full graph reports the cycle
+    self.assertRaises(RuntimeError, self.Doc.recompute, None, False, True)
+    L3.Link = None
+
+  def testRecomputeCycleUntouched(self):
+    L1 = self.Doc.addObject("App::FeatureTest","Cycle_1")
+    L2 = self.Doc.addObject("App::FeatureTest","Cycle_2")
+    L3 = self.Doc.addObject("App::FeatureTest","Other")
+    L1.Link = L2
+    L2.Link = L1
+    L1.purgeTouched()
+    L2.purgeTouched()
+    L3.touch()
+    # the cycle is not part of the touched objects, but must still be reported
+    self.assertRaises(RuntimeError, self.Doc.recompute, None, False, True)
+    L2.Link = None
+
+  def testRecomputeProfile(self):
+    L1 = self.Doc.addObject("App::FeatureTest","Label_1")
+    L2 = self.Doc.addObject("App::FeatureTest","Label_2")
+    L1.Link = L2
+    # nothing is collected unless the profiler is enabled
+    self.Doc.recompute()
+    self.failUnless(len(self.Doc.recomputeProfile()) == 0)
+    L2.touch()
+    profiling = FreeCAD.setRecomputeProfiler(True)
+    try:
+      self.Doc.recompute()
+      profile = self.Doc.recomputeProfile()
+    finally:
+      FreeCAD.setRecomputeProfiler(profiling)
+    self.failUnless(len(profile) > 0)
+    self.failUnless(profile[0]['Category'] == 'Document')
+    self.failUnless(profile[0]['Depth'] == 0)
+    execs = [p['Object'] for p in profile if p['Name'] == 'execute' and p['Category'] == 'DocumentObject']
+    self.failUnless(execs.index(L2.FullName) < execs.index(L1.FullName))
+    for p in profile:
+      self.failUnless(p['Duration'] >= 0.0)
+      self.failUnless(p['Duration'] <= profile[0]['Duration'])
+
+  def testParallelRecompute(self):
+    param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+    parallel = param.GetBool("ParallelRecompute",False)
+    param.SetBool("ParallelRecompute",True)
+    try:
+      # twenty independent branches of two objects each
+      roots = []
+      leaves = []
+      for i in range(20):
+        root = self.Doc.addObject("App::FeatureTest","Root")
+        leaf = self.Doc.addObject("App::FeatureTest","Leaf")
+        root.Link = leaf
+        roots.append(root)
+        leaves.append(leaf)
+      self.Doc.recompute()
+      for obj in roots+leaves:
+        self.failUnless(obj.ExecCount == 1)
+        self.failUnless(obj.ExecResult == "Exec")
+        self.failUnless('Touched' not in obj.State)
+
+      # error in one branch must not affect the others
+      leaves[3].ExceptionType = 2
+      for obj in leaves:
+        obj.touch()
+      self.Doc.recompute()
+      self.failUnless('Invalid' in leaves[3].State)
+      self.failUnless(roots[3].ExecCount == 1)
+      for i in range(20):
+        if i != 3:
+          self.failUnless(leaves[i].ExecCount == 2)
+          self.failUnless(roots[i].ExecCount == 2)
+    finally:
+      param.SetBool("ParallelRecompute",parallel)
+
   def tearDown(self):
     #closing doc
     FreeCAD.closeDocument("RecomputeTests")
@@ -648,6 +858,29 @@ class UndoRedoCases(unittest.TestCase):
     # switch on the Undo OFF
     self.Doc.UndoMode = 0
 
+  def testUndoMemLimit(self):
+    self.Doc.UndoMode = 1
+    obj = self.Doc.getObject("Base")
+    for i in range(10):
+      self.Doc.openTransaction("Transaction%d" % i)
+      obj.FloatList = [float(i)]*10000
+      self.Doc.commitTransaction()
+    self.assertEqual(self.Doc.UndoCount,10)
+    size = self.Doc.UndoRedoMemSize
+    # each transaction keeps the previous list value
+    self.assertTrue(size >= 9*10000*8)
+    # the oldest transactions are discarded on the next commit
+    self.Doc.UndoMemLimit = size//2
+    self.Doc.openTransaction("Transaction10")
+    obj.FloatList = [10.0]*10000
+    self.Doc.commitTransaction()
+    self.assertTrue(self.Doc.UndoRedoMemSize <= size//2)
+    self.assertTrue(0 < self.Doc.UndoCount < 10)
+    self.assertEqual(self.Doc.UndoNames[0],"Transaction10")
+    self.Doc.undo()
+    self.assertEqual(obj.FloatList,[9.0]*10000)
+    self.Doc.UndoMemLimit = 0
+
   def testUndoClear(self):
     # switch on the Undo
     self.Doc.UndoMode = 1
@@ -1109,6 +1342,58 @@ class DocumentGroupCases(unittest.TestCase):
     self.prt.removeObject(self.fus1)
     self.failUnless(len(self.prt.Group)==0)
 
+  def testSubObjectCache(self):
+    prt = self.Doc.addObject("App::Part","Part")
+    feat = self.Doc.addObject("App::FeatureTest","Feature")
+    prt.addObject(feat)
+    link = self.Doc.addObject("App::Link","Link")
+    link.LinkedObject = prt
+    self.Doc.recompute()
+
+    res = link.resolve('Feature.Edge1')
+    self.assertEqual(res[0], feat)
+    self.assertEqual(res[3], 'Edge1')
+    # resolve again to hit the cache
+    self.assertEqual(link.resolve('Feature.Edge1')[0], feat)
+
+    # relinking must invalidate the cache
+    prt2 = self.Doc.addObject("App::Part","Part2")
+    feat2 = self.Doc.addObject("App::FeatureTest","Feature2")
+    prt2.addObject(feat2)
+    link.LinkedObject = prt2
+    self.assertEqual(link.resolve('Feature.Edge1')[0], link)
+    self.assertEqual(link.resolve('Feature2.Edge1')[0], feat2)
+
+    # so does removing an object
+    prt2.removeObject(feat2)
+    self.assertEqual(link.resolve('Feature2.Edge1')[0], link)
+
+    # and relabeling for subname referencing label
+    feat2.Label = 'Label1'
+    prt2.addObject(feat2)
+    self.assertEqual(link.resolve('$Label1.Edge1')[0], feat2)
+    feat2.Label = 'Label2'
+    self.assertEqual(link.resolve('$Label1.Edge1')[0], link)
+    self.assertEqual(link.resolve('$Label2.Edge1')[0], feat2)
+
+    # placement change must invalidate the cached transformation
+    link.LinkedObject = prt
+    self.assertEqual(link.getSubObject('Feature.', retType=3), FreeCAD.Placement())
+    feat.Placement = FreeCAD.Placement(FreeCAD.Vector(1,2,3), FreeCAD.Rotation())
+    self.assertEqual(link.getSubObject('Feature.', retType=3).Base, FreeCAD.Vector(1,2,3))
+    link.Placement = FreeCAD.Placement(FreeCAD.Vector(1,0,0), FreeCAD.Rotation())
+    self.assertEqual(link.getSubObject('Feature.', retType=3).Base, FreeCAD.Vector(2,2,3))
+
+    # so does the change of other link properties used in resolving
+    link.ShowElement = False
+    link.ElementCount = 2
+    self.assertEqual(link.getSubObject('1.Feature.', retType=1), feat)
+    self.assertEqual(link.getSubObject('1.Feature.', retType=3).Base, FreeCAD.Vector(3,2,3))
+    link.PlacementList = [FreeCAD.Placement(), FreeCAD.Placement(FreeCAD.Vector(0,0,5), FreeCAD.Rotation())]
+    self.assertEqual(link.getSubObject('1.Feature.', retType=3).Base, FreeCAD.Vector(2,2,8))
+    link.ElementCount = 1
+    self.assertEqual(link.getSubObject('1.Feature.', retType=1), None)
+
   def tearDown(self):
     # closing doc
     FreeCAD.closeDocument("GroupTests")
@@ -1358,6 +1643,61 @@ class DocumentPropertyCases(unittest.TestCase):
     self.Doc.recompute()
     self.assertTrue(not p2 in p1.InList)
 
+  def testPlacementListArray(self):
+    self.Obj.addProperty("App::PropertyPlacementList", "Placements")
+    rot = FreeCAD.Rotation(FreeCAD.Vector(0,0,1), 90)
+    self.Obj.Placements = [FreeCAD.Placement(FreeCAD.Vector(i,2*i,0), rot) for i in range(5)]
+    view = self.Obj.getPropertyArray("Placements")
+    self.assertEqual(view.shape, (5,7))
+    self.assertEqual(view[3,1], 6.0)
+    self.assertAlmostEqual(view[3,5], rot.Q[2])
+
+    # set from a buffer with shifted positions
+    import array
+    values = array.array('d', view.tobytes())
+    for i in range(5):
+      values[i*7] += 10
+    self.Obj.Placements = values
+    self.assertEqual(len(self.Obj.Placements), 5)
+    self.assertEqual(self.Obj.Placements[2].Base, FreeCAD.Vector(12,4,0))
+    self.assertTrue(self.Obj.Placements[2].Rotation.isSame(rot, 1e-12))
+
+    with self.assertRaises(ValueError):
+      self.Obj.Placements = array.array('d', [0.0]*6)
+    with self.assertRaises(TypeError):
+      self.Obj.getPropertyArray("Label")
+
+  def testArrayBuffer(self):
+    import array
+    self.Obj.addProperty("App::PropertyVectorList", "Vectors")
+    self.Obj.Vectors = array.array('d', range(12))
+    self.assertEqual(len(self.Obj.Vectors), 4)
+    self.assertEqual(self.Obj.Vectors[2], FreeCAD.Vector(6,7,8))
+    view = self.Obj.getPropertyArray("Vectors")
+    self.assertEqual(view.shape, (4,3))
+    self.assertEqual(view[3,2], 11.0)
+    with self.assertRaises(ValueError):
+      self.Obj.Vectors = array.array('d', [0.0]*4)
+    self.Obj.Vectors = array.array('f', [0.5, 1.5, 2.5])
+    self.assertEqual(self.Obj.Vectors, [FreeCAD.Vector(0.5, 1.5, 2.5)])
+
+    self.Obj.addProperty("App::PropertyFloatList", "Floats")
+    self.Obj.Floats = array.array('d', [0.5, 1.5, 2.5])
+    self.assertEqual(self.Obj.Floats, [0.5, 1.5, 2.5])
+    # buffers of other types are treated as sequences
+    self.Obj.Floats = array.array('i', [1, 2, 3])
+    self.assertEqual(self.Obj.Floats, [1.0, 2.0, 3.0])
+    self.Obj.Floats = b'\x04\x05'
+    self.assertEqual(self.Obj.Floats, [4.0, 5.0])
+    self.assertEqual(self.Obj.getPropertyArray("Floats").tolist(), [0.5, 1.5, 2.5])
+
+    # the matrix buffer shares memory with the matrix
+    mat = FreeCAD.Matrix()
+    view = memoryview(mat)
+    self.assertEqual(view.shape, (4,4))
+    view[0,3] = 5.0
+    self.assertEqual(mat.A14, 5.0)
+
   def tearDown(self):
     #closing doc
     FreeCAD.closeDocument("PropertyTests")
@@ -1393,6 +1733,64 @@ class DocumentExpressionCases(unittest.TestCase):
     # must not raise a topological error
     self.assertEqual(self.Doc.recompute(), 2)
 
+  def testNativeEvaluation(self):
+    param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Expression")
+    native = param.GetBool("NativeEvaluation", True)
+    exprs = ['1+2', '-7%3', '7.5%-2', '2^10', '2^-1', '1/4', '3.5*2', '10 mm + 2 cm',
+             '(2mm)^2', '10 mm / 2', '12 mm % 5', 'True and 2', 'not 0', '1 < 2 ? 3 : 4',
+             '2 mm == 2 mm', '1 mm < 2 cm', 'sin(30 deg)', 'sqrt(4 mm^2)', 'mod(7, 3)',
+             'pow(2, 3)', 'Integer * 2', 'Float + Integer', 'Distance * 2', 'Angle + 1 deg',
+             'Bool + 1', '-Bool', 'abs(-Distance)', 'Integer > Float ? Distance : 1 mm',
+             'Vector.x * 2 + 1']
+    try:
+      for expr in exprs:
+        param.SetBool("NativeEvaluation", False)
+        expected = self.Obj1.evalExpression(expr)
+        param.SetBool("NativeEvaluation", True)
+        value = self.Obj1.evalExpression(expr)
+        self.assertEqual(type(value), type(expected), expr)
+        self.assertEqual(value, expected, expr)
+
+      # errors are reported the same way as Python evaluation
+      with self.assertRaises(Exception):
+        self.Obj1.evalExpression('1 mm + 1')
+
+      # recomputing a chain of expressions gives the same result
+      objs = [self.Doc.addObject("App::FeatureTest","Chain") for _ in range(20)]
+      prev = self.Obj1
+      for obj in objs:
+        obj.setExpression('Float', '%s.Float * 1.0001 + sin(%s.Angle) / 10' % (prev.Name, prev.Name))
+        obj.setExpression('Distance', '%s.Distance + 1 mm * (%s.Integer > 0 ? 1 : 2)' % (prev.Name, prev.Name))
+        prev = obj
+      values = {}
+      for mode in (False, True):
+        param.SetBool("NativeEvaluation", mode)
+        self.Obj1.Float = 47.11
+        self.Doc.recompute()
+        values[mode] = (objs[-1].Float, objs[-1].Distance.Value)
+      self.assertEqual(values[True], values[False])
+    finally:
+      param.SetBool("NativeEvaluation", native)
+
+  def testResolveCache(self):
+    self.Obj1.addProperty("App::PropertyFloat", "Extra")
+    self.Obj1.Extra = 2.0
+    self.Obj2.setExpression('Float', '%s.Extra * 2' % self.Obj1.Name)
+    self.Doc.recompute()
+    self.assertAlmostEqual(self.Obj2.Float, 4.0)
+
+    # removing the referenced property must invalidate the cached resolution
+    self.Obj1.removeProperty('Extra')
+    self.Obj2.touch()
+    self.Doc.recompute()
+    self.assertTrue('Invalid' in self.Obj2.State)
+
+    self.Obj1.addProperty("App::PropertyFloat", "Extra")
+    self.Obj1.Extra = 3.0
+    self.Obj2.touch()
+    self.Doc.recompute()
+    self.assertAlmostEqual(self.Obj2.Float, 6.0)
+
   def tearDown(self):
     #closing doc
     FreeCAD.closeDocument(self.Doc.Name)
@@ -1800,6 +2198,79 @@ class DocumentObserverCases(unittest.TestCase):
     self.Obs.parameter = []
     self.Obs.parameter2 = []
     
+  def testBulkChange(self):
+    self.Doc1 = FreeCAD.newDocument("Observer1")
+    self.Doc1.UndoMode = 1
+    obj1 = self.Doc1.addObject('App::FeatureTest','Test1')
+    obj2 = self.Doc1.addObject('App::FeatureTest','Test2')
+    self.Obs.signal = []
+    self.Obs.parameter = []
+    self.Obs.parameter2 = []
+
+    obj1.setProperties({'Integer': 1, 'Float': 2.0})
+    self.assertEqual(obj1.Integer, 1)
+    self.assertEqual(obj1.Float, 2.0)
+    self.assertEqual(self.Obs.parameter2.count('Integer'), 1)
+    self.assertEqual(self.Obs.parameter2.count('Float'), 1)
+    self.Obs.signal = []
+    self.Obs.parameter = []
+    self.Obs.parameter2 = []
+
+    # multiple changes of the same property are signaled once with the final value
+    self.Doc1.openTransaction('bulk')
+    self.Doc1.setPropertiesBulk([(obj1, {'Integer': 2}), ('Test2', {'Integer': 3}), (obj1, {'Integer': 4})])
+    self.Doc1.commitTransaction()
+    self.assertEqual(obj1.Integer, 4)
+    self.assertEqual(obj2.Integer, 3)
+    self.assertEqual(self.Obs.parameter2.count('Integer'), 2)
+
+    # undo restores the values before the bulk change
+    self.Doc1.undo()
+    self.assertEqual(obj1.Integer, 1)
+    self.assertEqual(obj2.Integer, 4711)
+
+    with self.assertRaises(AttributeError):
+      obj1.setProperties({'Integer': 5, 'NonExisting': 1})
+    self.assertEqual(obj1.Integer, 5)
+
+    # Python features are set through their own attribute access, and
+    # notified after all properties are set
+    class Feature():
+      def __init__(self, obj):
+        obj.addProperty('App::PropertyInteger', 'A')
+        obj.addProperty('App::PropertyInteger', 'B')
+        self.changes = []
+        obj.Proxy = self
+      def onChanged(self, obj, prop):
+        if prop in ('A', 'B'):
+          self.changes.append((prop, obj.A, obj.B))
+    fp = self.Doc1.addObject('App::FeaturePython','Feature')
+    proxy = Feature(fp)
+    fp.setProperties({'A': 1, 'B': 2})
+    self.assertEqual(proxy.changes, [('A', 1, 2), ('B', 1, 2)])
+
+    # objects deleted while setting the properties are skipped
+    class Remover():
+      def __init__(self, obj, other):
+        obj.addProperty('App::PropertyInteger', 'A')
+        self.other = other
+        obj.Proxy = self
+      def onBeforeChange(self, obj, prop):
+        if prop == 'A' and self.other:
+          obj.Document.removeObject(self.other)
+          self.other = None
+    remover = self.Doc1.addObject('App::FeaturePython','Remover')
+    victim = self.Doc1.addObject('App::FeatureTest','Victim')
+    Remover(remover, victim.Name)
+    self.Doc1.setPropertiesBulk([(remover, {'A': 1}), (victim, {'Integer': 1})])
+    self.assertEqual(remover.A, 1)
+    self.assertEqual(self.Doc1.getObject('Victim'), None)
+
+    FreeCAD.closeDocument(self.Doc1.Name)
+    self.Obs.signal = []
+    self.Obs.parameter = []
+    self.Obs.parameter2 = []
+
   def testGuiObserver(self):
   
     if not FreeCAD.GuiUp:
@@ -221,7 +221,7 @@ class GenerateModel:
 
 class PythonExport:
     subclass = None
-    def __init__(self, FatherNamespace='', DisableNotify=0, RichCompare=0, Name='', Reference=0, FatherInclude='', Namespace='', Initialization=0, Father='', PythonName='', Twin='', Constructor=0, TwinPointer='', Include='', NumberProtocol=0, Delete=0, Documentation=None, Methode=None, Attribute=None, Sequence=None, CustomAttributes='', ClassDeclarations=''):
+    def __init__(self, FatherNamespace='', DisableNotify=0, RichCompare=0, Name='', Reference=0, FatherInclude='', Namespace='', Initialization=0, Father='', PythonName='', Twin='', Constructor=0, TwinPointer='', Include='', NumberProtocol=0, BufferProtocol=0, Delete=0, Documentation=None, Methode=None, Attribute=None, Sequence=None, CustomAttributes='', ClassDeclarations=''):
         self.FatherNamespace = FatherNamespace
         self.DisableNotify = DisableNotify
         self.RichCompare = RichCompare
@@ -237,6 +237,7 @@ class PythonExport:
         self.TwinPointer = TwinPointer
         self.Include = Include
         self.NumberProtocol = NumberProtocol
+        self.BufferProtocol = BufferProtocol
         self.Delete = Delete
         self.Documentation = Documentation
         if Methode is None:
@@ -302,6 +303,8 @@ class PythonExport:
     def setInclude(self, Include): self.Include = Include
     def getNumberprotocol(self): return self.NumberProtocol
     def setNumberprotocol(self, NumberProtocol): self.NumberProtocol = NumberProtocol
+    def getBufferprotocol(self): return self.BufferProtocol
+    def setBufferprotocol(self, BufferProtocol): self.BufferProtocol = BufferProtocol
     def getDelete(self): return self.Delete
     def setDelete(self, Delete): self.Delete = Delete
     def export(self, outfile, level, name_='PythonExport'):
@@ -335,6 +338,8 @@ class PythonExport:
         outfile.write(' Include="%s"' % (self.getInclude(), ))
         if self.getNumberprotocol() is not None:
             outfile.write(' NumberProtocol="%s"' % (self.getNumberprotocol(), ))
+        if self.getBufferprotocol() is not None:
+            outfile.write(' BufferProtocol="%s"' % (self.getBufferprotocol(), ))
         if self.getDelete() is not None:
             outfile.write(' Delete="%s"' % (self.getDelete(), ))
     def exportChildren(self, outfile, level, name_='PythonExport'):
@@ -386,6 +391,8 @@ class PythonExport:
         showIndent(outfile, level)
         outfile.write('NumberProtocol = "%s",\n' % (self.getNumberprotocol(),))
         showIndent(outfile, level)
+        outfile.write('BufferProtocol = "%s",\n' % (self.getBufferprotocol(),))
+        showIndent(outfile, level)
         outfile.write('Delete = "%s",\n' % (self.getDelete(),))
     def exportLiteralChildren(self, outfile, level, name_):
         if self.Documentation:
@@ -495,6 +502,13 @@ class PythonExport:
                 self.NumberProtocol = 0
             else:
                 raise ValueError('Bad boolean attribute (NumberProtocol)')
+        if attrs.get('BufferProtocol'):
+            if attrs.get('BufferProtocol').value in ('true', '1'):
+                self.BufferProtocol = 1
+            elif attrs.get('BufferProtocol').value in ('false', '0'):
+                self.BufferProtocol = 0
+            else:
+                raise ValueError('Bad boolean attribute (BufferProtocol)')
         if attrs.get('Delete'):
             if attrs.get('Delete').value in ('true', '1'):
                 self.Delete = 1
@@ -1902,6 +1916,14 @@ class SaxGeneratemodelHandler(handler.ContentHandler):
                     obj.setNumberprotocol(0)
                 else:
                     self.reportError('"NumberProtocol" attribute must be boolean ("true", "1", "false", "0")')
+            val = attrs.get('BufferProtocol', None)
+            if val is not None:
+                if val in ('true', '1'):
+                    obj.setBufferprotocol(1)
+                elif val in ('false', '0'):
+                    obj.setBufferprotocol(0)
+                else:
+                    self.reportError('"BufferProtocol" attribute must be boolean ("true", "1", "false", "0")')
             val = attrs.get('Delete', None)
             if val is not None:
                 if val in ('true', '1'):
@@ -69,8 +69,22 @@ public:
     static PySequenceMethods Sequence[];
     static PyMappingMethods Mapping[];
 -
++ if (self.export.BufferProtocol):
+#if PY_MAJOR_VERSION >= 3
+    static PyBufferProcs BufferProcs;
+#endif
+-
 + if (self.export.RichCompare):
     static PyObject * richCompare(PyObject *v, PyObject *w, int op);
+-
++ if (self.export.BufferProtocol):
+#if PY_MAJOR_VERSION >= 3
+    /** @name callbacks for the python buffer protocol */
+    //@{
+    static int getBuffer(PyObject *self, Py_buffer *view, int flags);
+    static void releaseBuffer(PyObject *self, Py_buffer *view);
+    //@}
+#endif
 -
     static PyGetSetDef    GetterSetter[];
     virtual PyTypeObject *GetType(void) {return &Type;}
@@ -296,7 +310,15 @@ PyTypeObject @self.export.Name@::Type = {
     __getattro,                                       /*tp_getattro*/
     __setattro,                                       /*tp_setattro*/
     /* --- Functions to access object as input/output buffer ---------*/
++ if (self.export.BufferProtocol):
+#if PY_MAJOR_VERSION >= 3
+    &@self.export.Namespace@::@self.export.Name@::BufferProcs,      /* tp_as_buffer */
+#else
     0,                                                /* tp_as_buffer */
+#endif
+= else:
+    0,                                                /* tp_as_buffer */
+-
     /* --- Flags to define presence of optional/expanded features */
 #if PY_MAJOR_VERSION >= 3
     Py_TPFLAGS_BASETYPE|Py_TPFLAGS_DEFAULT,        /*tp_flags */
@@ -493,6 +515,15 @@ PyMappingMethods @self.export.Name@::Mapping[] = { {
 } };
 -
 
++ if (self.export.BufferProtocol):
+#if PY_MAJOR_VERSION >= 3
+PyBufferProcs @self.export.Name@::BufferProcs = {
+    getBuffer,
+    releaseBuffer
+};
+#endif
+-
+
 /// Attribute structure of @self.export.Name@
 PyGetSetDef @self.export.Name@::GetterSetter[] = {
 + for i in self.export.Attribute:
@@ -984,6 +1015,21 @@ PyObject* @self.export.Name@::richCompare(PyObject *v, PyObject *w, int op)
     return 0;
 }
 -
+
++ if (self.export.BufferProtocol):
+#if PY_MAJOR_VERSION >= 3
+int @self.export.Name@::getBuffer(PyObject *self, Py_buffer *view, int flags)
+{
+    PyErr_SetString(PyExc_BufferError, "Not yet implemented");
+    view->obj = 0;
+    return -1;
+}
+
+void @self.export.Name@::releaseBuffer(PyObject *self, Py_buffer *view)
+{
+}
+#endif
+-
 + for i in self.export.Attribute:
 
 Py::@i.Parameter.Type@ @self.export.Name@::get@i.Name@(void) const
@@ -1303,6 +1349,21 @@ PyObject* @self.export.Name@::richCompare(PyObject *v, PyObject *w, int op)
 }
 -
 
++ if (self.export.BufferProtocol):
+#if PY_MAJOR_VERSION >= 3
+int @self.export.Name@::getBuffer(PyObject *self, Py_buffer *view, int flags)
+{
+    PyErr_SetString(PyExc_BufferError, "Not yet implemented");
+    view->obj = 0;
+    return -1;
+}
+
+void @self.export.Name@::releaseBuffer(PyObject *self, Py_buffer *view)
+{
+}
+#endif
+-
+
 + for i in self.export.Attribute:
 
 Py::@i.Parameter.Type@ @self.export.Name@::get@i.Name@(void) const